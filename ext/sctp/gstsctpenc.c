@@ -77,6 +77,12 @@ static GParamSpec *properties[NUM_PROPERTIES];
 
 #define BUFFER_FULL_SLEEP_TIME 100000
 
+/* Amount of SCTP packets waiting to be pushed downstream above which the
+ * sink pads stop handing new data to usrsctp. The queue itself never blocks:
+ * it is fed from usrsctp's packet out callback, which runs with the
+ * association lock held and on usrsctp's own timer and receive threads */
+#define MAX_OUTBOUND_QUEUE_BYTES (1024 * 1024)
+
 GType gst_sctp_enc_pad_get_type (void);
 
 #define GST_TYPE_SCTP_ENC_PAD (gst_sctp_enc_pad_get_type())
@@ -242,7 +248,6 @@ static gboolean
 data_queue_check_full_cb (GstDataQueue * queue, guint visible, guint bytes,
     guint64 time, gpointer user_data)
 {
-  /* TODO: When are we considered full? */
   return FALSE;
 }
 
@@ -523,11 +528,32 @@ gst_sctp_enc_srcpad_loop (GstPad * pad)
 
   if (gst_data_queue_pop (self->outbound_sctp_packet_queue, &item)) {
     GstBuffer *buffer = GST_BUFFER (item->object);
+    GstBufferList *list = NULL;
 
-    GST_DEBUG_OBJECT (self, "Forwarding buffer %" GST_PTR_FORMAT, buffer);
-
-    flow_ret = gst_pad_push (self->src_pad, buffer);
     item->object = NULL;
+    item->destroy (item);
+
+    /* Forward all packets usrsctp produced in the meantime in one go. We are
+     * the only consumer, so popping a non-empty queue does not block */
+    while (!gst_data_queue_is_empty (self->outbound_sctp_packet_queue)
+        && gst_data_queue_pop (self->outbound_sctp_packet_queue, &item)) {
+      if (!list) {
+        list = gst_buffer_list_new ();
+        gst_buffer_list_add (list, buffer);
+      }
+      gst_buffer_list_add (list, GST_BUFFER (item->object));
+      item->object = NULL;
+      item->destroy (item);
+    }
+
+    if (list) {
+      GST_DEBUG_OBJECT (self, "Forwarding %u buffers",
+          gst_buffer_list_length (list));
+      flow_ret = gst_pad_push_list (self->src_pad, list);
+    } else {
+      GST_DEBUG_OBJECT (self, "Forwarding buffer %" GST_PTR_FORMAT, buffer);
+      flow_ret = gst_pad_push (self->src_pad, buffer);
+    }
 
     GST_OBJECT_LOCK (self);
     self->src_ret = flow_ret;
@@ -548,8 +574,6 @@ gst_sctp_enc_srcpad_loop (GstPad * pad)
       gst_data_queue_flush (self->outbound_sctp_packet_queue);
       gst_pad_pause_task (pad);
     }
-
-    item->destroy (item);
   } else {
     GST_OBJECT_LOCK (self);
     self->src_ret = GST_FLOW_FLUSHING;
@@ -560,6 +584,16 @@ gst_sctp_enc_srcpad_loop (GstPad * pad)
   }
 }
 
+static gboolean
+gst_sctp_enc_outbound_queue_is_full (GstSctpEnc * self)
+{
+  GstDataQueueSize level;
+
+  gst_data_queue_get_level (self->outbound_sctp_packet_queue, &level);
+
+  return level.bytes >= MAX_OUTBOUND_QUEUE_BYTES;
+}
+
 static GstFlowReturn
 gst_sctp_enc_sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
 {
@@ -648,6 +682,15 @@ gst_sctp_enc_sink_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
     g_cond_wait (&sctpenc_pad->cond, &sctpenc_pad->lock);
   }
 
+  /* Backpressure: wait for the source pad task to catch up before giving
+   * usrsctp more data to packetize */
+  while (!sctpenc_pad->flushing && gst_sctp_enc_outbound_queue_is_full (self)) {
+    gint64 end_time = g_get_monotonic_time () + BUFFER_FULL_SLEEP_TIME;
+
+    GST_TRACE_OBJECT (pad, "Outbound packet queue full, waiting");
+    g_cond_wait_until (&sctpenc_pad->cond, &sctpenc_pad->lock, end_time);
+  }
+
   while (!sctpenc_pad->flushing) {
     guint32 bytes_sent;
 
@@ -211,6 +211,10 @@ static GstFlowReturn gst_srtp_dec_chain_rtp (GstPad * pad,
     GstObject * parent, GstBuffer * buf);
 static GstFlowReturn gst_srtp_dec_chain_rtcp (GstPad * pad,
     GstObject * parent, GstBuffer * buf);
+static GstFlowReturn gst_srtp_dec_chain_list_rtp (GstPad * pad,
+    GstObject * parent, GstBufferList * buf_list);
+static GstFlowReturn gst_srtp_dec_chain_list_rtcp (GstPad * pad,
+    GstObject * parent, GstBufferList * buf_list);
 
 static GstStateChangeReturn gst_srtp_dec_change_state (GstElement * element,
     GstStateChange transition);
@@ -385,6 +389,8 @@ gst_srtp_dec_init (GstSrtpDec * filter)
       GST_DEBUG_FUNCPTR (gst_srtp_dec_iterate_internal_links_rtp));
   gst_pad_set_chain_function (filter->rtp_sinkpad,
       GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_rtp));
+  gst_pad_set_chain_list_function (filter->rtp_sinkpad,
+      GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_list_rtp));
 
   filter->rtp_srcpad =
       gst_pad_new_from_static_template (&rtp_src_template, "rtp_src");
@@ -408,6 +414,8 @@ gst_srtp_dec_init (GstSrtpDec * filter)
       GST_DEBUG_FUNCPTR (gst_srtp_dec_iterate_internal_links_rtcp));
   gst_pad_set_chain_function (filter->rtcp_sinkpad,
       GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_rtcp));
+  gst_pad_set_chain_list_function (filter->rtcp_sinkpad,
+      GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_list_rtcp));
 
   filter->rtcp_srcpad =
       gst_pad_new_from_static_template (&rtcp_src_template, "rtcp_src");
@@ -1327,22 +1335,26 @@ gst_srtp_dec_push_early_events (GstSrtpDec * filter, GstPad * pad,
 
 /*
  * This function should be called while holding the filter lock
+ *
+ * The packet is unprotected in place, @buf_ptr is replaced by a copy only if
+ * the buffer was not writable.
  */
 static gboolean
-gst_srtp_dec_decode_buffer (GstSrtpDec * filter, GstPad * pad, GstBuffer * buf,
-    gboolean is_rtcp, guint32 ssrc)
+gst_srtp_dec_decode_buffer (GstSrtpDec * filter, GstPad * pad,
+    GstBuffer ** buf_ptr, gboolean is_rtcp, guint32 ssrc)
 {
+  GstBuffer *buf;
   GstMapInfo map;
   srtp_err_status_t err;
   gint size;
   GstSrtpDecSsrcStream *stream;
 
   GST_LOG_OBJECT (pad, "Received %s buffer of size %" G_GSIZE_FORMAT
-      " with SSRC = %u", is_rtcp ? "RTCP" : "RTP", gst_buffer_get_size (buf),
-      ssrc);
+      " with SSRC = %u", is_rtcp ? "RTCP" : "RTP",
+      gst_buffer_get_size (*buf_ptr), ssrc);
   filter->recv_count++;
   /* Change buffer to remove protection */
-  buf = gst_buffer_make_writable (buf);
+  buf = *buf_ptr = gst_buffer_make_writable (*buf_ptr);
 
   gst_buffer_map (buf, &map, GST_MAP_READWRITE);
   size = map.size;
@@ -1460,21 +1472,20 @@ err:
   return FALSE;
 }
 
-static GstFlowReturn
-gst_srtp_dec_chain (GstPad * pad, GstObject * parent, GstBuffer * buf,
-    gboolean is_rtcp)
+/* Validates and unprotects @buf_ptr. Returns FALSE and unrefs the buffer if
+ * it has to be dropped. @is_rtcp is updated for RTCP muxed on the RTP pad. */
+static gboolean
+gst_srtp_dec_process_buffer (GstSrtpDec * filter, GstPad * pad,
+    GstBuffer ** buf_ptr, gboolean * is_rtcp)
 {
-  GstSrtpDec *filter = GST_SRTP_DEC (parent);
-  GstPad *otherpad;
   GstSrtpDecSsrcStream *stream = NULL;
-  GstFlowReturn ret = GST_FLOW_OK;
   guint32 ssrc = 0;
 
   GST_OBJECT_LOCK (filter);
 
   /* Check if this stream exists, if not create a new stream */
 
-  if (!(stream = validate_buffer (filter, buf, &ssrc, &is_rtcp))) {
+  if (!(stream = validate_buffer (filter, *buf_ptr, &ssrc, is_rtcp))) {
     GST_OBJECT_UNLOCK (filter);
     GST_WARNING_OBJECT (filter, "Invalid buffer, dropping");
     goto drop_buffer;
@@ -1482,10 +1493,10 @@ gst_srtp_dec_chain (GstPad * pad, GstObject * parent, GstBuffer * buf,
 
   if (!STREAM_HAS_CRYPTO (stream)) {
     GST_OBJECT_UNLOCK (filter);
-    goto push_out;
+    return TRUE;
   }
 
-  if (!gst_srtp_dec_decode_buffer (filter, pad, buf, is_rtcp, ssrc)) {
+  if (!gst_srtp_dec_decode_buffer (filter, pad, buf_ptr, *is_rtcp, ssrc)) {
     GST_OBJECT_UNLOCK (filter);
     goto drop_buffer;
   }
@@ -1496,27 +1507,115 @@ gst_srtp_dec_chain (GstPad * pad, GstObject * parent, GstBuffer * buf,
   if (gst_srtp_get_soft_limit_reached ())
     request_key_with_signal (filter, ssrc, SIGNAL_SOFT_LIMIT);
 
-push_out:
-  /* Push buffer to source pad */
+  return TRUE;
+
+drop_buffer:
+  gst_buffer_unref (*buf_ptr);
+  *buf_ptr = NULL;
+
+  return FALSE;
+}
+
+static GstPad *
+gst_srtp_dec_get_src_pad (GstSrtpDec * filter, gboolean is_rtcp)
+{
   if (is_rtcp) {
-    otherpad = filter->rtcp_srcpad;
     if (!filter->rtcp_has_segment)
       gst_srtp_dec_push_early_events (filter, filter->rtcp_srcpad,
           filter->rtp_srcpad, TRUE);
+    return filter->rtcp_srcpad;
   } else {
-    otherpad = filter->rtp_srcpad;
     if (!filter->rtp_has_segment)
       gst_srtp_dec_push_early_events (filter, filter->rtp_srcpad,
           filter->rtcp_srcpad, FALSE);
+    return filter->rtp_srcpad;
   }
-  ret = gst_pad_push (otherpad, buf);
+}
 
-  return ret;
+static GstFlowReturn
+gst_srtp_dec_chain (GstPad * pad, GstObject * parent, GstBuffer * buf,
+    gboolean is_rtcp)
+{
+  GstSrtpDec *filter = GST_SRTP_DEC (parent);
+  GstPad *otherpad;
 
-drop_buffer:
-  /* Drop buffer, except if gst_pad_push returned OK or an error */
+  /* Dropped buffers are not an error */
+  if (!gst_srtp_dec_process_buffer (filter, pad, &buf, &is_rtcp))
+    return GST_FLOW_OK;
+
+  /* Push buffer to source pad */
+  otherpad = gst_srtp_dec_get_src_pad (filter, is_rtcp);
+
+  return gst_pad_push (otherpad, buf);
+}
+
+typedef struct
+{
+  GstSrtpDec *filter;
+  GstPad *pad;
+  gboolean is_rtcp;
+  GstBufferList *rtp_list;
+  GstBufferList *rtcp_list;
+} DecodeBufferItData;
 
-  gst_buffer_unref (buf);
+static gboolean
+decode_buffer_it (GstBuffer ** buffer, guint index, gpointer user_data)
+{
+  DecodeBufferItData *data = user_data;
+  gboolean is_rtcp = data->is_rtcp;
+  GstBuffer *buf = *buffer;
+
+  /* Take the buffer out of the (writable) list so that it can be unprotected
+   * in place */
+  *buffer = NULL;
+
+  if (!gst_srtp_dec_process_buffer (data->filter, data->pad, &buf, &is_rtcp))
+    return TRUE;
+
+  if (is_rtcp) {
+    if (!data->rtcp_list)
+      data->rtcp_list = gst_buffer_list_new ();
+    gst_buffer_list_add (data->rtcp_list, buf);
+  } else {
+    if (!data->rtp_list)
+      data->rtp_list = gst_buffer_list_new ();
+    gst_buffer_list_add (data->rtp_list, buf);
+  }
+
+  return TRUE;
+}
+
+static GstFlowReturn
+gst_srtp_dec_chain_list (GstPad * pad, GstObject * parent,
+    GstBufferList * buf_list, gboolean is_rtcp)
+{
+  GstSrtpDec *filter = GST_SRTP_DEC (parent);
+  DecodeBufferItData data = { filter, pad, is_rtcp, NULL, NULL };
+  GstFlowReturn ret = GST_FLOW_OK, flow_ret;
+  GstPad *otherpad;
+
+  GST_LOG_OBJECT (pad, "Buffer chain with list of %d",
+      gst_buffer_list_length (buf_list));
+
+  buf_list = gst_buffer_list_make_writable (buf_list);
+  gst_buffer_list_foreach (buf_list, decode_buffer_it, &data);
+  gst_buffer_list_unref (buf_list);
+
+  /* RTCP muxed on the RTP pad ends up in its own list, only the flow return
+   * of the list matching the sink pad is reported upstream */
+  if (data.rtcp_list) {
+    otherpad = gst_srtp_dec_get_src_pad (filter, TRUE);
+    flow_ret = gst_pad_push_list (otherpad, data.rtcp_list);
+    if (is_rtcp)
+      ret = flow_ret;
+  }
+
+  if (data.rtp_list) {
+    otherpad = gst_srtp_dec_get_src_pad (filter, FALSE);
+    flow_ret = gst_pad_push_list (otherpad, data.rtp_list);
+    if (!is_rtcp)
+      ret = flow_ret;
+  }
 
   return ret;
 }
@@ -1533,6 +1632,20 @@ gst_srtp_dec_chain_rtcp (GstPad * pad, GstObject * parent, GstBuffer * buf)
   return gst_srtp_dec_chain (pad, parent, buf, TRUE);
 }
 
+static GstFlowReturn
+gst_srtp_dec_chain_list_rtp (GstPad * pad, GstObject * parent,
+    GstBufferList * buf_list)
+{
+  return gst_srtp_dec_chain_list (pad, parent, buf_list, FALSE);
+}
+
+static GstFlowReturn
+gst_srtp_dec_chain_list_rtcp (GstPad * pad, GstObject * parent,
+    GstBufferList * buf_list)
+{
+  return gst_srtp_dec_chain_list (pad, parent, buf_list, TRUE);
+}
+
 static GstStateChangeReturn
 gst_srtp_dec_change_state (GstElement * element, GstStateChange transition)
 {
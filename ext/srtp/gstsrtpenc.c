@@ -1111,37 +1111,77 @@ gst_srtp_enc_check_set_caps (GstSrtpEnc * filter, GstPad * pad,
   return GST_FLOW_OK;
 }
 
-static void
-gst_srtp_enc_ensure_ssrc (GstSrtpEnc * filter, GstBuffer * buf)
+static gboolean
+gst_srtp_enc_get_ssrc (GstBuffer * buf, guint32 * ssrc)
 {
   GstRTPBuffer rtpbuf = GST_RTP_BUFFER_INIT;
-  if (gst_rtp_buffer_map (buf,
-          GST_MAP_READ | GST_RTP_BUFFER_MAP_FLAG_SKIP_PADDING, &rtpbuf)) {
-    guint32 ssrc = gst_rtp_buffer_get_ssrc (&rtpbuf);
-    gst_srtp_enc_add_ssrc (filter, ssrc);
-    gst_rtp_buffer_unmap (&rtpbuf);
+
+  if (!gst_rtp_buffer_map (buf,
+          GST_MAP_READ | GST_RTP_BUFFER_MAP_FLAG_SKIP_PADDING, &rtpbuf))
+    return FALSE;
+
+  *ssrc = gst_rtp_buffer_get_ssrc (&rtpbuf);
+  gst_rtp_buffer_unmap (&rtpbuf);
+
+  return TRUE;
+}
+
+/* Returns a buffer with the contents of @buf followed by @trailer_size
+ * bytes of room for the SRTP trailer. If @buf is writable and its memory
+ * has enough spare room the packet is protected in place, otherwise it is
+ * copied into a new buffer. Takes ownership of @buf. */
+static GstBuffer *
+gst_srtp_enc_prepare_buffer (GstBuffer * buf, gsize trailer_size)
+{
+  gsize size = gst_buffer_get_size (buf);
+  GstBuffer *bufout;
+  GstMapInfo mapout;
+
+  if (gst_buffer_is_writable (buf) && gst_buffer_n_memory (buf) == 1) {
+    GstMemory *mem = gst_buffer_peek_memory (buf, 0);
+    gsize offset, maxsize;
+
+    gst_memory_get_sizes (mem, &offset, &maxsize);
+    if (gst_memory_is_writable (mem) && maxsize - offset >= size + trailer_size) {
+      gst_buffer_set_size (buf, size + trailer_size);
+      return buf;
+    }
   }
+
+  bufout = gst_buffer_new_allocate (NULL, size + trailer_size, NULL);
+  gst_buffer_copy_into (bufout, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+
+  gst_buffer_map (bufout, &mapout, GST_MAP_WRITE);
+  gst_buffer_extract (buf, 0, mapout.data, size);
+  gst_buffer_unmap (bufout, &mapout);
+
+  gst_buffer_unref (buf);
+
+  return bufout;
 }
 
+/* Takes ownership of @buf */
 static GstFlowReturn
 gst_srtp_enc_process_buffer (GstSrtpEnc * filter, GstPad * pad,
     GstBuffer * buf, gboolean is_rtcp, GstBuffer ** outbuf_ptr)
 {
   GstFlowReturn ret = GST_FLOW_OK;
-  gint size_max, size;
+  gint size;
   GstBuffer *bufout = NULL;
   GstMapInfo mapout;
   srtp_err_status_t err;
+  gboolean have_ssrc;
+  guint32 ssrc = 0;
+
+  /* Read the SSRC before the packet is extended for the trailer */
+  have_ssrc = gst_srtp_enc_get_ssrc (buf, &ssrc);
 
-  /* Create a bigger buffer to add protection */
+  /* Make room to add protection */
   size = gst_buffer_get_size (buf);
-  size_max = size + SRTP_MAX_TRAILER_LEN + 10;
-  bufout = gst_buffer_new_allocate (NULL, size_max, NULL);
+  bufout = gst_srtp_enc_prepare_buffer (buf, SRTP_MAX_TRAILER_LEN + 10);
 
   gst_buffer_map (bufout, &mapout, GST_MAP_READWRITE);
 
-  gst_buffer_extract (buf, 0, mapout.data, size);
-
   GST_OBJECT_LOCK (filter);
 
   gst_srtp_init_event_reporter ();
@@ -1149,11 +1189,13 @@ gst_srtp_enc_process_buffer (GstSrtpEnc * filter, GstPad * pad,
   if (filter->session == NULL) {
     /* The rtcp session disappeared (element shutting down) */
     GST_OBJECT_UNLOCK (filter);
+    gst_buffer_unmap (bufout, &mapout);
     ret = GST_FLOW_FLUSHING;
     goto fail;
   }
 
-  gst_srtp_enc_ensure_ssrc (filter, buf);
+  if (have_ssrc)
+    gst_srtp_enc_add_ssrc (filter, ssrc);
 
 #ifdef HAVE_SRTP2
   if (is_rtcp)
@@ -1176,7 +1218,6 @@ gst_srtp_enc_process_buffer (GstSrtpEnc * filter, GstPad * pad,
   if (err == srtp_err_status_ok) {
     /* Buffer protected */
     gst_buffer_set_size (bufout, size);
-    gst_buffer_copy_into (bufout, buf, GST_BUFFER_COPY_METADATA, 0, -1);
 
     GST_LOG_OBJECT (pad, "Encoding %s buffer of size %d",
         is_rtcp ? "RTCP" : "RTP", size);
@@ -1229,6 +1270,7 @@ gst_srtp_enc_chain (GstPad * pad, GstObject * parent, GstBuffer * buf,
   GST_OBJECT_UNLOCK (filter);
 
   ret = gst_srtp_enc_process_buffer (filter, pad, buf, is_rtcp, &bufout);
+  buf = NULL;
   if (ret != GST_FLOW_OK)
     goto out;
 
@@ -1253,7 +1295,8 @@ gst_srtp_enc_chain (GstPad * pad, GstObject * parent, GstBuffer * buf,
   GST_OBJECT_UNLOCK (filter);
 
 out:
-  gst_buffer_unref (buf);
+  if (buf)
+    gst_buffer_unref (buf);
   return ret;
 }
 
@@ -1264,8 +1307,11 @@ process_buffer_it (GstBuffer ** buffer, guint index, gpointer user_data)
   GstBuffer *bufout;
   GstFlowReturn ret;
 
+  /* Take the buffer out of the (writable) list so that it can be protected
+   * in place */
   ret = gst_srtp_enc_process_buffer (data->filter, data->pad, *buffer,
       data->is_rtcp, &bufout);
+  *buffer = NULL;
   if (ret != GST_FLOW_OK) {
     data->flowret = ret;
     return FALSE;
@@ -1305,7 +1351,8 @@ gst_srtp_enc_chain_list (GstPad * pad, GstObject * parent,
 
   GST_OBJECT_UNLOCK (filter);
 
-  out_list = gst_buffer_list_new ();
+  buf_list = gst_buffer_list_make_writable (buf_list);
+  out_list = gst_buffer_list_new_sized (gst_buffer_list_length (buf_list));
 
   process_data.filter = filter;
   process_data.pad = pad;
@@ -1319,7 +1366,6 @@ gst_srtp_enc_chain_list (GstPad * pad, GstObject * parent,
   }
 
   if (!gst_buffer_list_length (out_list)) {
-    gst_buffer_list_unref (out_list);
     ret = GST_FLOW_OK;
     goto out;
   }
@@ -1327,8 +1373,9 @@ gst_srtp_enc_chain_list (GstPad * pad, GstObject * parent,
   /* Push buffer to source pad */
   otherpad = get_rtp_other_pad (pad);
   GST_LOG_OBJECT (pad, "Pushing buffer chain of %d",
-      gst_buffer_list_length (buf_list));
+      gst_buffer_list_length (out_list));
   ret = gst_pad_push_list (otherpad, out_list);
+  out_list = NULL;
 
   if (ret != GST_FLOW_OK) {
     goto out;
@@ -1348,6 +1395,8 @@ gst_srtp_enc_chain_list (GstPad * pad, GstObject * parent,
 
 out:
 
+  if (out_list)
+    gst_buffer_list_unref (out_list);
   gst_buffer_list_unref (buf_list);
 
   return ret;
@@ -309,6 +309,9 @@ _get_pending_sink_transceiver (GstWebRTCBin * webrtc, GstWebRTCBinPad * pad)
   return ret;
 }
 
+static gboolean gst_webrtc_bin_sink_pad_get_rewrite (GstPad * pad);
+static GstCaps *_remove_rewritten_fields (GstCaps * caps);
+
 static gboolean
 gst_webrtcbin_sink_event (GstPad * pad, GstObject * parent, GstEvent * event)
 {
@@ -381,18 +384,34 @@ gst_webrtcbin_sink_query (GstPad * pad, GstObject * parent, GstQuery * query)
 
   switch (GST_QUERY_TYPE (query)) {
     case GST_QUERY_ACCEPT_CAPS:
+    {
+      GstCaps *codec_preferences = NULL;
+
       GST_OBJECT_LOCK (wpad->trans);
-      if (wpad->trans->codec_preferences) {
+      if (wpad->trans->codec_preferences)
+        codec_preferences = gst_caps_ref (wpad->trans->codec_preferences);
+      GST_OBJECT_UNLOCK (wpad->trans);
+
+      if (codec_preferences) {
         GstCaps *caps;
 
         gst_query_parse_accept_caps (query, &caps);
 
+        if (gst_webrtc_bin_sink_pad_get_rewrite (pad)) {
+          caps = _remove_rewritten_fields (gst_caps_ref (caps));
+          codec_preferences = _remove_rewritten_fields (codec_preferences);
+        } else {
+          gst_caps_ref (caps);
+        }
+
         gst_query_set_accept_caps_result (query,
-            gst_caps_can_intersect (caps, wpad->trans->codec_preferences));
+            gst_caps_can_intersect (caps, codec_preferences));
+        gst_caps_unref (caps);
+        gst_caps_unref (codec_preferences);
         ret = TRUE;
       }
-      GST_OBJECT_UNLOCK (wpad->trans);
       break;
+    }
 
     case GST_QUERY_CAPS:
     {
@@ -403,6 +422,9 @@ gst_webrtcbin_sink_query (GstPad * pad, GstObject * parent, GstQuery * query)
         codec_preferences = gst_caps_ref (wpad->trans->codec_preferences);
       GST_OBJECT_UNLOCK (wpad->trans);
 
+      if (codec_preferences && gst_webrtc_bin_sink_pad_get_rewrite (pad))
+        codec_preferences = _remove_rewritten_fields (codec_preferences);
+
       if (codec_preferences) {
         GstCaps *filter = NULL;
         GstCaps *filter_prefs = NULL;
@@ -485,6 +507,7 @@ gst_webrtc_bin_pad_new (const gchar * name, GstPadDirection direction,
 enum
 {
   PROP_SINK_PAD_MSID = 1,
+  PROP_SINK_PAD_REWRITE_RTP_HEADER,
 };
 
 /**
@@ -495,11 +518,219 @@ enum
 struct _GstWebRTCBinSinkPad
 {
   GstWebRTCBinPad pad;
+
+  /* protected by the object lock */
+  gboolean rewrite_rtp_header;
+  /* payload type and ssrc the transceiver sends with, -1 when not known */
+  gint rewrite_pt;
+  gint64 rewrite_ssrc;
 };
 
 G_DEFINE_TYPE (GstWebRTCBinSinkPad, gst_webrtc_bin_sink_pad,
     GST_TYPE_WEBRTC_BIN_PAD);
 
+static gboolean
+gst_webrtc_bin_sink_pad_get_rewrite (GstPad * pad)
+{
+  GstWebRTCBinSinkPad *spad = GST_WEBRTC_BIN_SINK_PAD (pad);
+  gboolean ret;
+
+  GST_OBJECT_LOCK (spad);
+  ret = spad->rewrite_rtp_header;
+  GST_OBJECT_UNLOCK (spad);
+
+  return ret;
+}
+
+/* When rewriting, the payload type and SSRC of the input don't have to
+ * match the codec preferences. Takes ownership of @caps. */
+static GstCaps *
+_remove_rewritten_fields (GstCaps * caps)
+{
+  guint i;
+
+  caps = gst_caps_make_writable (caps);
+  for (i = 0; i < gst_caps_get_size (caps); i++) {
+    gst_structure_remove_fields (gst_caps_get_structure (caps, i), "payload",
+        "ssrc", NULL);
+  }
+
+  return caps;
+}
+
+/* Looks up the payload type and SSRC the transceiver of @pad sends the codec
+ * of @caps with in its codec preferences */
+static void
+gst_webrtc_bin_sink_pad_update_rewrite (GstWebRTCBinSinkPad * pad,
+    GstCaps * caps)
+{
+  GstWebRTCRTPTransceiver *trans = GST_WEBRTC_BIN_PAD (pad)->trans;
+  const gchar *encoding_name;
+  gint pt = -1;
+  gint64 ssrc = -1;
+  guint i;
+
+  encoding_name = gst_structure_get_string (gst_caps_get_structure (caps, 0),
+      "encoding-name");
+
+  if (trans) {
+    GST_OBJECT_LOCK (trans);
+    for (i = 0; trans->codec_preferences
+        && i < gst_caps_get_size (trans->codec_preferences); i++) {
+      const GstStructure *s =
+          gst_caps_get_structure (trans->codec_preferences, i);
+      const gchar *name = gst_structure_get_string (s, "encoding-name");
+      guint tmp;
+
+      if (encoding_name && name
+          && g_ascii_strcasecmp (encoding_name, name) != 0)
+        continue;
+
+      if (!gst_structure_get_int (s, "payload", &pt) || pt < 0 || pt > 127)
+        pt = -1;
+      if (gst_structure_get_uint (s, "ssrc", &tmp))
+        ssrc = tmp;
+      break;
+    }
+    GST_OBJECT_UNLOCK (trans);
+  }
+
+  GST_DEBUG_OBJECT (pad, "rewriting to payload type %d, ssrc %" G_GINT64_FORMAT,
+      pt, ssrc);
+
+  GST_OBJECT_LOCK (pad);
+  pad->rewrite_pt = pt;
+  pad->rewrite_ssrc = ssrc;
+  GST_OBJECT_UNLOCK (pad);
+}
+
+/* Only the fixed RTP header is rewritten, the remaining memory (CSRCs,
+ * header extensions and payload) is shared with the input buffer. Buffers
+ * forwarded to several webrtcbin instances through a tee therefore never
+ * have their payload copied. Takes ownership of @buffer. */
+static GstBuffer *
+_rewrite_rtp_header (GstBuffer * buffer, gint pt, gint64 ssrc)
+{
+  guint8 header[12];
+  gboolean changed = FALSE;
+  GstBuffer *ret;
+  gpointer data;
+
+  if (gst_buffer_extract (buffer, 0, header, sizeof (header)) < sizeof (header)
+      || (header[0] >> 6) != 2)
+    return buffer;
+
+  if (pt != -1 && (header[1] & 0x7f) != pt) {
+    header[1] = (header[1] & 0x80) | pt;
+    changed = TRUE;
+  }
+  if (ssrc != -1 && GST_READ_UINT32_BE (&header[8]) != (guint32) ssrc) {
+    GST_WRITE_UINT32_BE (&header[8], (guint32) ssrc);
+    changed = TRUE;
+  }
+
+  if (!changed)
+    return buffer;
+
+  data = g_memdup2 (header, sizeof (header));
+  ret = gst_buffer_new ();
+  gst_buffer_copy_into (ret, buffer, GST_BUFFER_COPY_METADATA, 0, -1);
+  gst_buffer_append_memory (ret,
+      gst_memory_new_wrapped (0, data, sizeof (header), 0, sizeof (header),
+          data, g_free));
+  gst_buffer_copy_into (ret, buffer, GST_BUFFER_COPY_MEMORY, sizeof (header),
+      -1);
+  gst_buffer_unref (buffer);
+
+  return ret;
+}
+
+struct rewrite_data
+{
+  gint pt;
+  gint64 ssrc;
+};
+
+static gboolean
+_rewrite_rtp_header_list_func (GstBuffer ** buffer, guint idx,
+    gpointer user_data)
+{
+  struct rewrite_data *data = user_data;
+
+  *buffer = _rewrite_rtp_header (*buffer, data->pt, data->ssrc);
+
+  return TRUE;
+}
+
+static GstPadProbeReturn
+sink_pad_rewrite_rtp_header (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  GstWebRTCBinSinkPad *spad = GST_WEBRTC_BIN_SINK_PAD (pad);
+  struct rewrite_data data;
+
+  if (!gst_webrtc_bin_sink_pad_get_rewrite (pad))
+    return GST_PAD_PROBE_OK;
+
+  /* The caps are updated as well, so negotiation and the RTP session see
+   * the rewritten payload type and SSRC */
+  if (info->type & GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM) {
+    GstEvent *event = GST_PAD_PROBE_INFO_EVENT (info);
+    GstEvent *new_event;
+    GstCaps *caps;
+
+    if (GST_EVENT_TYPE (event) != GST_EVENT_CAPS)
+      return GST_PAD_PROBE_OK;
+
+    gst_event_parse_caps (event, &caps);
+    gst_webrtc_bin_sink_pad_update_rewrite (spad, caps);
+
+    GST_OBJECT_LOCK (spad);
+    data.pt = spad->rewrite_pt;
+    data.ssrc = spad->rewrite_ssrc;
+    GST_OBJECT_UNLOCK (spad);
+
+    if (data.pt == -1 && data.ssrc == -1)
+      return GST_PAD_PROBE_OK;
+
+    caps = gst_caps_make_writable (gst_caps_ref (caps));
+    if (data.pt != -1)
+      gst_caps_set_simple (caps, "payload", G_TYPE_INT, data.pt, NULL);
+    if (data.ssrc != -1)
+      gst_caps_set_simple (caps, "ssrc", G_TYPE_UINT, (guint) data.ssrc, NULL);
+
+    new_event = gst_event_new_caps (caps);
+    gst_event_set_seqnum (new_event, gst_event_get_seqnum (event));
+    gst_caps_unref (caps);
+    gst_event_unref (event);
+    GST_PAD_PROBE_INFO_DATA (info) = new_event;
+
+    return GST_PAD_PROBE_OK;
+  }
+
+  GST_OBJECT_LOCK (spad);
+  data.pt = spad->rewrite_pt;
+  data.ssrc = spad->rewrite_ssrc;
+  GST_OBJECT_UNLOCK (spad);
+
+  if (data.pt == -1 && data.ssrc == -1)
+    return GST_PAD_PROBE_OK;
+
+  if (info->type & GST_PAD_PROBE_TYPE_BUFFER) {
+    GST_PAD_PROBE_INFO_DATA (info) =
+        _rewrite_rtp_header (GST_PAD_PROBE_INFO_BUFFER (info), data.pt,
+        data.ssrc);
+  } else if (info->type & GST_PAD_PROBE_TYPE_BUFFER_LIST) {
+    GstBufferList *list = GST_PAD_PROBE_INFO_BUFFER_LIST (info);
+
+    list = gst_buffer_list_make_writable (list);
+    gst_buffer_list_foreach (list, _rewrite_rtp_header_list_func, &data);
+    GST_PAD_PROBE_INFO_DATA (info) = list;
+  }
+
+  return GST_PAD_PROBE_OK;
+}
+
 static void
 gst_webrtc_bin_sink_pad_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec)
@@ -510,6 +741,12 @@ gst_webrtc_bin_sink_pad_get_property (GObject * object, guint prop_id,
     case PROP_SINK_PAD_MSID:
       g_value_set_string (value, pad->msid);
       break;
+    case PROP_SINK_PAD_REWRITE_RTP_HEADER:
+      GST_OBJECT_LOCK (pad);
+      g_value_set_boolean (value,
+          GST_WEBRTC_BIN_SINK_PAD (pad)->rewrite_rtp_header);
+      GST_OBJECT_UNLOCK (pad);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -527,6 +764,12 @@ gst_webrtc_bin_sink_pad_set_property (GObject * object, guint prop_id,
       g_free (pad->msid);
       pad->msid = g_value_dup_string (value);
       break;
+    case PROP_SINK_PAD_REWRITE_RTP_HEADER:
+      GST_OBJECT_LOCK (pad);
+      GST_WEBRTC_BIN_SINK_PAD (pad)->rewrite_rtp_header =
+          g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (pad);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -554,13 +797,42 @@ gst_webrtc_bin_sink_pad_class_init (GstWebRTCBinSinkPadClass * klass)
       g_param_spec_string ("msid", "MSID",
           "Local MediaStream ID to use for this pad (NULL = unset)", NULL,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstWebRTCBinSinkPad:rewrite-rtp-header:
+   *
+   * Rewrite the payload type and SSRC of incoming RTP packets and caps to
+   * the "payload" and "ssrc" values of the transceiver codec preferences
+   * with the same encoding name. This allows forwarding already payloaded
+   * RTP, e.g. from the src pad of another webrtcbin, without depayloading
+   * and payloading it again. Only the fixed RTP header is copied, the
+   * payload memory is shared with the input buffer.
+   *
+   * The values are looked up when caps are received, so this should be set
+   * together with the codec preferences before the input caps.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class,
+      PROP_SINK_PAD_REWRITE_RTP_HEADER,
+      g_param_spec_boolean ("rewrite-rtp-header", "Rewrite RTP header",
+          "Rewrite payload type and SSRC of incoming RTP packets to the "
+          "values from the transceiver codec preferences", FALSE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
 gst_webrtc_bin_sink_pad_init (GstWebRTCBinSinkPad * pad)
 {
+  pad->rewrite_pt = -1;
+  pad->rewrite_ssrc = -1;
+
   gst_pad_set_event_function (GST_PAD (pad), gst_webrtcbin_sink_event);
   gst_pad_set_query_function (GST_PAD (pad), gst_webrtcbin_sink_query);
+  gst_pad_add_probe (GST_PAD (pad),
+      GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST |
+      GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM, sink_pad_rewrite_rtp_header, NULL,
+      NULL);
 }
 
 enum
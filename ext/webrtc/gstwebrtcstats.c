@@ -914,19 +914,88 @@ webrtc_stats_get_from_transport (SsrcMapItem * entry,
   return FALSE;
 }
 
+/* Data shared by all pads using the same (possibly bundled) transport
+ * stream. It is only collected once per stats request, as retrieving the
+ * rtpsession source stats and the transport stats is expensive and would
+ * otherwise be repeated for every pad. */
+struct transport_stream_cache
+{
+  GValueArray *source_stats;
+  char *transport_id;
+};
+
+static void
+transport_stream_cache_free (struct transport_stream_cache *cache)
+{
+  if (cache->source_stats)
+    g_value_array_free (cache->source_stats);
+  g_free (cache->transport_id);
+  g_free (cache);
+}
+
+struct stats_request
+{
+  GstStructure *s;
+  /* TransportStream -> struct transport_stream_cache */
+  GHashTable *streams;
+};
+
+static struct transport_stream_cache *
+_get_transport_stream_cache (GstWebRTCBin * webrtc,
+    struct stats_request *request, TransportStream * stream)
+{
+  struct transport_stream_cache *cache;
+  GObject *rtp_session;
+  GObject *gst_rtp_session;
+  GstStructure *rtp_stats, *twcc_stats;
+
+  cache = g_hash_table_lookup (request->streams, stream);
+  if (cache)
+    return cache;
+
+  cache = g_new0 (struct transport_stream_cache, 1);
+
+  g_signal_emit_by_name (webrtc->rtpbin, "get-internal-session",
+      stream->session_id, &rtp_session);
+  g_object_get (rtp_session, "stats", &rtp_stats, NULL);
+  g_signal_emit_by_name (webrtc->rtpbin, "get-session",
+      stream->session_id, &gst_rtp_session);
+  g_object_get (gst_rtp_session, "twcc-stats", &twcc_stats, NULL);
+
+  gst_structure_get (rtp_stats, "source-stats", G_TYPE_VALUE_ARRAY,
+      &cache->source_stats, NULL);
+
+  cache->transport_id =
+      _get_stats_from_dtls_transport (webrtc, stream->transport,
+      GST_WEBRTC_ICE_STREAM (stream->stream), twcc_stats, request->s);
+
+  GST_DEBUG_OBJECT (webrtc, "retrieved rtp stream stats from transport %"
+      GST_PTR_FORMAT " rtp session %" GST_PTR_FORMAT " with %u rtp sources, "
+      "transport %" GST_PTR_FORMAT, stream, rtp_session,
+      cache->source_stats->n_values, stream->transport);
+
+  g_clear_object (&rtp_session);
+  g_clear_object (&gst_rtp_session);
+  gst_clear_structure (&rtp_stats);
+  gst_clear_structure (&twcc_stats);
+
+  g_hash_table_insert (request->streams, stream, cache);
+
+  return cache;
+}
+
 static gboolean
-_get_stats_from_pad (GstWebRTCBin * webrtc, GstPad * pad, GstStructure * s)
+_get_stats_from_pad (GstWebRTCBin * webrtc, GstPad * pad,
+    struct stats_request *request)
 {
   GstWebRTCBinPad *wpad = GST_WEBRTC_BIN_PAD (pad);
   struct transport_stream_stats ts_stats = { NULL, };
+  struct transport_stream_cache *cache;
   guint ssrc, clock_rate;
-  GObject *rtp_session;
-  GObject *gst_rtp_session;
-  GstStructure *rtp_stats, *twcc_stats;
   GstWebRTCKind kind;
 
-  _get_codec_stats_from_pad (webrtc, pad, s, &ts_stats.codec_id, &ssrc,
-      &clock_rate);
+  _get_codec_stats_from_pad (webrtc, pad, request->s, &ts_stats.codec_id,
+      &ssrc, &clock_rate);
 
   if (!wpad->trans)
     goto out;
@@ -954,38 +1023,17 @@ _get_stats_from_pad (GstWebRTCBin * webrtc, GstPad * pad, GstStructure * s)
   if (!ts_stats.stream->transport)
     goto out;
 
-  g_signal_emit_by_name (webrtc->rtpbin, "get-internal-session",
-      ts_stats.stream->session_id, &rtp_session);
-  g_object_get (rtp_session, "stats", &rtp_stats, NULL);
-  g_signal_emit_by_name (webrtc->rtpbin, "get-session",
-      ts_stats.stream->session_id, &gst_rtp_session);
-  g_object_get (gst_rtp_session, "twcc-stats", &twcc_stats, NULL);
-
-  gst_structure_get (rtp_stats, "source-stats", G_TYPE_VALUE_ARRAY,
-      &ts_stats.source_stats, NULL);
-
-  ts_stats.transport_id =
-      _get_stats_from_dtls_transport (webrtc, ts_stats.stream->transport,
-      GST_WEBRTC_ICE_STREAM (ts_stats.stream->stream), twcc_stats, s);
-
-  GST_DEBUG_OBJECT (webrtc, "retrieving rtp stream stats from transport %"
-      GST_PTR_FORMAT " rtp session %" GST_PTR_FORMAT " with %u rtp sources, "
-      "transport %" GST_PTR_FORMAT, ts_stats.stream, rtp_session,
-      ts_stats.source_stats->n_values, ts_stats.stream->transport);
+  cache = _get_transport_stream_cache (webrtc, request, ts_stats.stream);
 
-  ts_stats.s = s;
+  ts_stats.webrtc = webrtc;
+  ts_stats.clock_rate = clock_rate;
+  ts_stats.source_stats = cache->source_stats;
+  ts_stats.transport_id = cache->transport_id;
+  ts_stats.s = request->s;
 
   transport_stream_find_ssrc_map_item (ts_stats.stream, &ts_stats,
       (FindSsrcMapFunc) webrtc_stats_get_from_transport);
 
-  g_clear_object (&rtp_session);
-  g_clear_object (&gst_rtp_session);
-  gst_clear_structure (&rtp_stats);
-  gst_clear_structure (&twcc_stats);
-  g_value_array_free (ts_stats.source_stats);
-  ts_stats.source_stats = NULL;
-  g_clear_pointer (&ts_stats.transport_id, g_free);
-
 out:
   g_clear_pointer (&ts_stats.codec_id, g_free);
   return TRUE;
@@ -997,6 +1045,7 @@ gst_webrtc_bin_create_stats (GstWebRTCBin * webrtc, GstPad * pad)
   GstStructure *s = gst_structure_new_empty ("application/x-webrtc-stats");
   double ts = monotonic_time_as_double_milliseconds ();
   GstStructure *pc_stats;
+  struct stats_request request;
 
   _init_debug ();
 
@@ -1015,11 +1064,17 @@ gst_webrtc_bin_create_stats (GstWebRTCBin * webrtc, GstPad * pad)
     gst_structure_free (pc_stats);
   }
 
+  request.s = s;
+  request.streams = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+      NULL, (GDestroyNotify) transport_stream_cache_free);
+
   if (pad)
-    _get_stats_from_pad (webrtc, pad, s);
+    _get_stats_from_pad (webrtc, pad, &request);
   else
     gst_element_foreach_pad (GST_ELEMENT (webrtc),
-        (GstElementForeachPadFunc) _get_stats_from_pad, s);
+        (GstElementForeachPadFunc) _get_stats_from_pad, &request);
+
+  g_hash_table_unref (request.streams);
 
   gst_structure_remove_field (s, "timestamp");
 
@@ -547,6 +547,7 @@ gst_av1_parse_reset_state (GstAV1Parser * parser, gboolean free_sps)
       g_slice_free (GstAV1SequenceHeaderOBU, parser->seq_header);
       parser->seq_header = NULL;
     }
+    g_clear_pointer (&parser->seq_header_data, g_bytes_unref);
   }
 }
 
@@ -891,6 +892,76 @@ error:
   return ret;
 }
 
+/**
+ * gst_av1_parser_identify_obus:
+ * @parser: the #GstAV1Parser
+ * @data: the data to parse
+ * @size: the size of @data
+ * @index: (element-type GstAV1OBUIndexEntry): a #GArray of
+ *   #GstAV1OBUIndexEntry to store the identified OBUs
+ * @consumed: (out): the consumed data size
+ *
+ * Identify all the OBUs of @data, typically a whole temporal unit, in one
+ * pass and store them in bitstream order in @index, replacing its previous
+ * content. This is equivalent to calling gst_av1_parser_identify_one_obu()
+ * until @data is exhausted, but lets the caller walk or split @data at OBU
+ * boundaries without identifying the OBUs again.
+ *
+ * OBUs which are not part of the selected operating point are stored with
+ * their @dropped flag set. Since a sequence header selects the operating
+ * point used for the following OBUs, identification stops right after a
+ * sequence header OBU, and should be resumed on the remaining data once that
+ * sequence header has been parsed.
+ *
+ * Returns: The #GstAV1ParserResult. On error, @index and @consumed still
+ * describe the OBUs identified before the failing one.
+ *
+ * Since: 1.24
+ */
+GstAV1ParserResult
+gst_av1_parser_identify_obus (GstAV1Parser * parser, const guint8 * data,
+    guint32 size, GArray * index, guint32 * consumed)
+{
+  GstAV1ParserResult ret = GST_AV1_PARSER_OK;
+  GstAV1OBUIndexEntry entry;
+  guint32 obu_consumed;
+
+  g_return_val_if_fail (parser != NULL, GST_AV1_PARSER_INVALID_OPERATION);
+  g_return_val_if_fail (data != NULL, GST_AV1_PARSER_INVALID_OPERATION);
+  g_return_val_if_fail (index != NULL, GST_AV1_PARSER_INVALID_OPERATION);
+  g_return_val_if_fail (g_array_get_element_size (index) ==
+      sizeof (GstAV1OBUIndexEntry), GST_AV1_PARSER_INVALID_OPERATION);
+  g_return_val_if_fail (consumed != NULL, GST_AV1_PARSER_INVALID_OPERATION);
+
+  *consumed = 0;
+  g_array_set_size (index, 0);
+
+  if (!size)
+    return GST_AV1_PARSER_NO_MORE_DATA;
+
+  while (*consumed < size) {
+    ret = gst_av1_parser_identify_one_obu (parser, data + *consumed,
+        size - *consumed, &entry.obu, &obu_consumed);
+    if (ret != GST_AV1_PARSER_OK && ret != GST_AV1_PARSER_DROP)
+      break;
+
+    entry.offset = *consumed;
+    entry.size = obu_consumed;
+    entry.dropped = (ret == GST_AV1_PARSER_DROP);
+    g_array_append_val (index, entry);
+
+    *consumed += obu_consumed;
+
+    if (ret == GST_AV1_PARSER_OK &&
+        entry.obu.obu_type == GST_AV1_OBU_SEQUENCE_HEADER)
+      break;
+
+    ret = GST_AV1_PARSER_OK;
+  }
+
+  return ret;
+}
+
 /* 5.5.2 */
 static GstAV1ParserResult
 gst_av1_parse_color_config (GstAV1Parser * parser, GstBitReader * br,
@@ -1145,6 +1216,18 @@ gst_av1_parser_parse_sequence_header_obu (GstAV1Parser * parser,
       GST_AV1_PARSER_INVALID_OPERATION);
   g_return_val_if_fail (seq_header != NULL, GST_AV1_PARSER_INVALID_OPERATION);
 
+  /* sequence headers are usually repeated verbatim, don't parse them again */
+  if (parser->seq_header && parser->seq_header_data) {
+    gsize size;
+    gconstpointer data = g_bytes_get_data (parser->seq_header_data, &size);
+
+    if (size == obu->obu_size && memcmp (data, obu->data, size) == 0) {
+      *seq_header = *parser->seq_header;
+      parser->seq_header_changed = FALSE;
+      return GST_AV1_PARSER_OK;
+    }
+  }
+
   av1_parser_init_sequence_header (seq_header);
   gst_bit_reader_init (br, obu->data, obu->obu_size);
 
@@ -1437,8 +1520,10 @@ gst_av1_parser_parse_sequence_header_obu (GstAV1Parser * parser,
 
   if (parser->seq_header) {
     if (!memcmp (parser->seq_header, seq_header,
-            sizeof (GstAV1SequenceHeaderOBU)))
+            sizeof (GstAV1SequenceHeaderOBU))) {
+      parser->seq_header_changed = FALSE;
       goto success;
+    }
 
     g_slice_free (GstAV1SequenceHeaderOBU, parser->seq_header);
   }
@@ -1457,8 +1542,13 @@ gst_av1_parser_parse_sequence_header_obu (GstAV1Parser * parser,
   }
 
   parser->state.sequence_changed = TRUE;
+  parser->seq_header_changed = TRUE;
 
 success:
+  if (parser->seq_header_data)
+    g_bytes_unref (parser->seq_header_data);
+  parser->seq_header_data = g_bytes_new (obu->data, obu->obu_size);
+
   return GST_AV1_PARSER_OK;
 
 error:
@@ -4369,7 +4459,9 @@ gst_av1_parse_tile_group (GstAV1Parser * parser, GstBitReader * br,
   guint32 tile_col /* tileCol */ ;
   guint32 tile_size /* tileSize */ ;
 
-  memset (tile_group, 0, sizeof (*tile_group));
+  /* Only the entries of this tile group get filled, clearing the whole
+   * entry array for every tile group is costly with many small groups. */
+  tile_group->tg_start = tile_group->tg_end = 0;
   tile_group->num_tiles = parser->state.tile_cols * parser->state.tile_rows;
   start_bitpos = gst_bit_reader_get_pos (br);
   tile_group->tile_start_and_end_present_flag = 0;
@@ -4652,6 +4744,27 @@ gst_av1_parser_set_operating_point (GstAV1Parser * parser,
   return GST_AV1_PARSER_OK;
 }
 
+/**
+ * gst_av1_parser_last_sequence_header_changed:
+ * @parser: the #GstAV1Parser
+ *
+ * Sequence header OBUs identical to the current one are not parsed again,
+ * the current sequence header is returned instead. This can be used to skip
+ * work that only needs to be done when the sequence header actually changed.
+ *
+ * Returns: %TRUE if the sequence header last parsed by @parser differs from
+ * the previous one
+ *
+ * Since: 1.24
+ */
+gboolean
+gst_av1_parser_last_sequence_header_changed (GstAV1Parser * parser)
+{
+  g_return_val_if_fail (parser != NULL, FALSE);
+
+  return parser->seq_header_changed;
+}
+
 /**
  * gst_av1_parser_new:
  *
@@ -4684,5 +4797,7 @@ gst_av1_parser_free (GstAV1Parser * parser)
 
   if (parser->seq_header)
     g_slice_free (GstAV1SequenceHeaderOBU, parser->seq_header);
+  if (parser->seq_header_data)
+    g_bytes_unref (parser->seq_header_data);
   g_slice_free (GstAV1Parser, parser);
 }
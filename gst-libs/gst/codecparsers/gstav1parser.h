@@ -89,6 +89,7 @@ typedef struct _GstAV1Parser GstAV1Parser;
 
 typedef struct _GstAV1OBUHeader GstAV1OBUHeader;
 typedef struct _GstAV1OBU GstAV1OBU;
+typedef struct _GstAV1OBUIndexEntry GstAV1OBUIndexEntry;
 
 typedef struct _GstAV1SequenceHeaderOBU GstAV1SequenceHeaderOBU;
 typedef struct _GstAV1MetadataOBU GstAV1MetadataOBU;
@@ -583,6 +584,26 @@ struct _GstAV1OBU {
   guint32 obu_size;
 };
 
+/**
+ * GstAV1OBUIndexEntry:
+ * @obu: the identified #GstAV1OBU, its @data points into the indexed data
+ * @offset: offset of the OBU in the indexed data, including the annex B
+ *   length fields preceding it, if any
+ * @size: number of bytes of the indexed data taken by the OBU
+ * @dropped: the OBU is not part of the selected operating point and should
+ *   be skipped
+ *
+ * One entry of the OBU index built by gst_av1_parser_identify_obus().
+ *
+ * Since: 1.24
+ */
+struct _GstAV1OBUIndexEntry {
+  GstAV1OBU obu;
+  guint32 offset;
+  guint32 size;
+  gboolean dropped;
+};
+
 /**
  * GstAV1OperatingPoint:
  * @seq_level_idx: specifies the level that the coded video sequence conforms to.
@@ -1691,6 +1712,8 @@ struct _GstAV1TileListOBU {
  * @mi_col_start: start position in mi cols
  * @mi_col_end: end position in mi cols
  * @num_tiles: specifies the total number of tiles in the frame.
+ *
+ * Only the entries from @tg_start to @tg_end are filled by the parser.
  */
 struct _GstAV1TileGroupOBU {
   gboolean tile_start_and_end_present_flag;
@@ -1770,6 +1793,9 @@ struct _GstAV1Parser
   guint32 frame_unit_consumed;
 
   GstAV1SequenceHeaderOBU *seq_header;
+  /* raw OBU payload @seq_header was parsed from */
+  GBytes *seq_header_data;
+  gboolean seq_header_changed;
 };
 
 GST_CODEC_PARSERS_API
@@ -1785,6 +1811,11 @@ GstAV1ParserResult
 gst_av1_parser_identify_one_obu (GstAV1Parser * parser, const guint8 * data,
     guint32 size, GstAV1OBU * obu, guint32 * consumed);
 
+GST_CODEC_PARSERS_API
+GstAV1ParserResult
+gst_av1_parser_identify_obus (GstAV1Parser * parser, const guint8 * data,
+    guint32 size, GArray * index, guint32 * consumed);
+
 GST_CODEC_PARSERS_API
 GstAV1ParserResult
 gst_av1_parser_parse_sequence_header_obu (GstAV1Parser * parser,
@@ -1830,6 +1861,10 @@ GstAV1ParserResult
 gst_av1_parser_set_operating_point (GstAV1Parser * parser,
     gint32 operating_point);
 
+GST_CODEC_PARSERS_API
+gboolean
+gst_av1_parser_last_sequence_header_changed (GstAV1Parser * parser);
+
 GST_CODEC_PARSERS_API
 GstAV1Parser * gst_av1_parser_new (void);
 
@@ -1452,6 +1452,8 @@ gst_h264_nal_parser_free (GstH264NalParser * nalparser)
     gst_h264_sps_clear (&nalparser->sps[i]);
   for (i = 0; i < GST_H264_MAX_PPS_COUNT; i++)
     gst_h264_pps_clear (&nalparser->pps[i]);
+  nal_param_set_cache_clear (nalparser->sps_data, GST_H264_MAX_SPS_COUNT);
+  nal_param_set_cache_clear (nalparser->pps_data, GST_H264_MAX_PPS_COUNT);
   g_slice_free (GstH264NalParser, nalparser);
 
   nalparser = NULL;
@@ -1693,7 +1695,25 @@ GstH264ParserResult
 gst_h264_parser_parse_sps (GstH264NalParser * nalparser, GstH264NalUnit * nalu,
     GstH264SPS * sps)
 {
-  GstH264ParserResult res = gst_h264_parse_sps (nalu, sps);
+  const guint8 *data = nalu->data + nalu->offset;
+  guint32 hash = nal_param_set_hash (data, nalu->size);
+  GstH264ParserResult res;
+  gint id;
+
+  id = nal_param_set_cache_lookup (nalparser->sps_data, nalparser->sps_hash,
+      GST_H264_MAX_SPS_COUNT, data, nalu->size, hash);
+  if (id >= 0 && nalparser->sps[id].valid) {
+    GST_LOG ("sequence parameter set with id: %d unchanged", id);
+
+    memset (sps, 0, sizeof (*sps));
+    if (!gst_h264_sps_copy (sps, &nalparser->sps[id]))
+      return GST_H264_PARSER_ERROR;
+    nalparser->last_sps = &nalparser->sps[id];
+    nalparser->param_set_changed = FALSE;
+    return GST_H264_PARSER_OK;
+  }
+
+  res = gst_h264_parse_sps (nalu, sps);
 
   if (res == GST_H264_PARSER_OK) {
     GST_DEBUG ("adding sequence parameter set with id: %d to array", sps->id);
@@ -1701,6 +1721,12 @@ gst_h264_parser_parse_sps (GstH264NalParser * nalparser, GstH264NalUnit * nalu,
     if (!gst_h264_sps_copy (&nalparser->sps[sps->id], sps))
       return GST_H264_PARSER_ERROR;
     nalparser->last_sps = &nalparser->sps[sps->id];
+
+    /* PPS parsing depends on the SPS they refer to */
+    nal_param_set_cache_clear (nalparser->pps_data, GST_H264_MAX_PPS_COUNT);
+    nal_param_set_cache_store (nalparser->sps_data, nalparser->sps_hash,
+        sps->id, data, nalu->size, hash);
+    nalparser->param_set_changed = TRUE;
   }
   return res;
 }
@@ -2020,6 +2046,10 @@ gst_h264_parser_parse_subset_sps (GstH264NalParser * nalparser,
       return GST_H264_PARSER_ERROR;
     }
     nalparser->last_sps = &nalparser->sps[sps->id];
+
+    g_clear_pointer (&nalparser->sps_data[sps->id], g_bytes_unref);
+    nal_param_set_cache_clear (nalparser->pps_data, GST_H264_MAX_PPS_COUNT);
+    nalparser->param_set_changed = TRUE;
   }
   return res;
 }
@@ -2225,7 +2255,25 @@ GstH264ParserResult
 gst_h264_parser_parse_pps (GstH264NalParser * nalparser,
     GstH264NalUnit * nalu, GstH264PPS * pps)
 {
-  GstH264ParserResult res = gst_h264_parse_pps (nalparser, nalu, pps);
+  const guint8 *data = nalu->data + nalu->offset;
+  guint32 hash = nal_param_set_hash (data, nalu->size);
+  GstH264ParserResult res;
+  gint id;
+
+  id = nal_param_set_cache_lookup (nalparser->pps_data, nalparser->pps_hash,
+      GST_H264_MAX_PPS_COUNT, data, nalu->size, hash);
+  if (id >= 0 && nalparser->pps[id].valid) {
+    GST_LOG ("picture parameter set with id: %d unchanged", id);
+
+    memset (pps, 0, sizeof (*pps));
+    if (!gst_h264_pps_copy (pps, &nalparser->pps[id]))
+      return GST_H264_PARSER_ERROR;
+    nalparser->last_pps = &nalparser->pps[id];
+    nalparser->param_set_changed = FALSE;
+    return GST_H264_PARSER_OK;
+  }
+
+  res = gst_h264_parse_pps (nalparser, nalu, pps);
 
   if (res == GST_H264_PARSER_OK) {
     GST_DEBUG ("adding picture parameter set with id: %d to array", pps->id);
@@ -2233,6 +2281,10 @@ gst_h264_parser_parse_pps (GstH264NalParser * nalparser,
     if (!gst_h264_pps_copy (&nalparser->pps[pps->id], pps))
       return GST_H264_PARSER_ERROR;
     nalparser->last_pps = &nalparser->pps[pps->id];
+
+    nal_param_set_cache_store (nalparser->pps_data, nalparser->pps_hash,
+        pps->id, data, nalu->size, hash);
+    nalparser->param_set_changed = TRUE;
   }
 
   return res;
@@ -2255,45 +2307,21 @@ gst_h264_pps_clear (GstH264PPS * pps)
   pps->slice_group_id = NULL;
 }
 
-/**
- * gst_h264_parser_parse_slice_hdr:
- * @nalparser: a #GstH264NalParser
- * @nalu: The #GST_H264_NAL_SLICE to #GST_H264_NAL_SLICE_IDR #GstH264NalUnit to parse
- * @slice: The #GstH264SliceHdr to fill.
- * @parse_pred_weight_table: Whether to parse the pred_weight_table or not
- * @parse_dec_ref_pic_marking: Whether to parse the dec_ref_pic_marking or not
- *
- * Parses @nalu containing a coded slice, and fills @slice.
- *
- * Returns: a #GstH264ParserResult
- */
-GstH264ParserResult
-gst_h264_parser_parse_slice_hdr (GstH264NalParser * nalparser,
-    GstH264NalUnit * nalu, GstH264SliceHdr * slice,
-    gboolean parse_pred_weight_table, gboolean parse_dec_ref_pic_marking)
+/* Parses the slice header up to and including bottom_field_flag */
+static GstH264ParserResult
+gst_h264_parser_parse_slice_hdr_start (GstH264NalParser * nalparser,
+    NalReader * nr, GstH264SliceHdr * slice)
 {
-  NalReader nr;
   gint pps_id;
   GstH264PPS *pps;
   GstH264SPS *sps;
-  guint start_pos, start_epb;
 
-  memset (slice, 0, sizeof (*slice));
-
-  if (!nalu->size) {
-    GST_DEBUG ("Invalid Nal Unit");
-    return GST_H264_PARSER_ERROR;
-  }
-
-  nal_reader_init (&nr, nalu->data + nalu->offset + nalu->header_bytes,
-      nalu->size - nalu->header_bytes);
-
-  READ_UE (&nr, slice->first_mb_in_slice);
-  READ_UE (&nr, slice->type);
+  READ_UE (nr, slice->first_mb_in_slice);
+  READ_UE (nr, slice->type);
 
   GST_DEBUG ("parsing \"Slice header\", slice type %u", slice->type);
 
-  READ_UE_MAX (&nr, pps_id, GST_H264_MAX_PPS_COUNT - 1);
+  READ_UE_MAX (nr, pps_id, GST_H264_MAX_PPS_COUNT - 1);
   pps = gst_h264_parser_get_pps (nalparser, pps_id);
 
   if (!pps) {
@@ -2332,14 +2360,14 @@ gst_h264_parser_parse_slice_hdr (GstH264NalParser * nalparser,
   }
 
   if (sps->separate_colour_plane_flag)
-    READ_UINT8 (&nr, slice->colour_plane_id, 2);
+    READ_UINT8 (nr, slice->colour_plane_id, 2);
 
-  READ_UINT16 (&nr, slice->frame_num, sps->log2_max_frame_num_minus4 + 4);
+  READ_UINT16 (nr, slice->frame_num, sps->log2_max_frame_num_minus4 + 4);
 
   if (!sps->frame_mbs_only_flag) {
-    READ_UINT8 (&nr, slice->field_pic_flag, 1);
+    READ_UINT8 (nr, slice->field_pic_flag, 1);
     if (slice->field_pic_flag)
-      READ_UINT8 (&nr, slice->bottom_field_flag, 1);
+      READ_UINT8 (nr, slice->bottom_field_flag, 1);
   }
 
   /* calculate MaxPicNum */
@@ -2348,6 +2376,100 @@ gst_h264_parser_parse_slice_hdr (GstH264NalParser * nalparser,
   else
     slice->max_pic_num = sps->max_frame_num;
 
+  return GST_H264_PARSER_OK;
+
+error:
+  GST_WARNING ("error parsing \"Slice header\"");
+  return GST_H264_PARSER_ERROR;
+}
+
+/**
+ * gst_h264_parser_parse_slice_hdr_partial:
+ * @nalparser: a #GstH264NalParser
+ * @nalu: The #GST_H264_NAL_SLICE to #GST_H264_NAL_SLICE_IDR #GstH264NalUnit to parse
+ * @slice: The #GstH264SliceHdr to fill.
+ *
+ * Parses only the beginning of the slice header of @nalu, up to and
+ * including bottom_field_flag. This fills @first_mb_in_slice, @type, @pps,
+ * @colour_plane_id, @frame_num, @field_pic_flag, @bottom_field_flag and
+ * @max_pic_num, @num_ref_idx_l0_active_minus1 and
+ * @num_ref_idx_l1_active_minus1 with their defaults from the PPS, and
+ * @header_size and @n_emulation_prevention_bytes for the parsed part. The
+ * other fields of @slice are left to zero. This is much cheaper than
+ * gst_h264_parser_parse_slice_hdr() and is enough to find picture boundaries
+ * and picture types, but the rest of the header is not validated.
+ *
+ * Returns: a #GstH264ParserResult
+ *
+ * Since: 1.24
+ */
+GstH264ParserResult
+gst_h264_parser_parse_slice_hdr_partial (GstH264NalParser * nalparser,
+    GstH264NalUnit * nalu, GstH264SliceHdr * slice)
+{
+  NalReader nr;
+  GstH264ParserResult res;
+
+  memset (slice, 0, sizeof (*slice));
+
+  if (!nalu->size) {
+    GST_DEBUG ("Invalid Nal Unit");
+    return GST_H264_PARSER_ERROR;
+  }
+
+  nal_reader_init (&nr, nalu->data + nalu->offset + nalu->header_bytes,
+      nalu->size - nalu->header_bytes);
+
+  res = gst_h264_parser_parse_slice_hdr_start (nalparser, &nr, slice);
+  if (res != GST_H264_PARSER_OK)
+    return res;
+
+  slice->header_size = nal_reader_get_pos (&nr);
+  slice->n_emulation_prevention_bytes = nal_reader_get_epb_count (&nr);
+
+  return GST_H264_PARSER_OK;
+}
+
+/**
+ * gst_h264_parser_parse_slice_hdr:
+ * @nalparser: a #GstH264NalParser
+ * @nalu: The #GST_H264_NAL_SLICE to #GST_H264_NAL_SLICE_IDR #GstH264NalUnit to parse
+ * @slice: The #GstH264SliceHdr to fill.
+ * @parse_pred_weight_table: Whether to parse the pred_weight_table or not
+ * @parse_dec_ref_pic_marking: Whether to parse the dec_ref_pic_marking or not
+ *
+ * Parses @nalu containing a coded slice, and fills @slice.
+ *
+ * Returns: a #GstH264ParserResult
+ */
+GstH264ParserResult
+gst_h264_parser_parse_slice_hdr (GstH264NalParser * nalparser,
+    GstH264NalUnit * nalu, GstH264SliceHdr * slice,
+    gboolean parse_pred_weight_table, gboolean parse_dec_ref_pic_marking)
+{
+  NalReader nr;
+  GstH264PPS *pps;
+  GstH264SPS *sps;
+  GstH264ParserResult res;
+  guint start_pos, start_epb;
+
+  memset (slice, 0, sizeof (*slice));
+
+  if (!nalu->size) {
+    GST_DEBUG ("Invalid Nal Unit");
+    return GST_H264_PARSER_ERROR;
+  }
+
+  nal_reader_init (&nr, nalu->data + nalu->offset + nalu->header_bytes,
+      nalu->size - nalu->header_bytes);
+
+  res = gst_h264_parser_parse_slice_hdr_start (nalparser, &nr, slice);
+  if (res != GST_H264_PARSER_OK)
+    return res;
+
+  pps = slice->pps;
+  sps = pps->sequence;
+
   if (nalu->idr_pic_flag)
     READ_UE_MAX (&nr, slice->idr_pic_id, G_MAXUINT16);
 
@@ -2603,6 +2725,10 @@ gst_h264_parser_update_sps (GstH264NalParser * nalparser, GstH264SPS * sps)
 
   nalparser->last_sps = &nalparser->sps[sps->id];
 
+  /* the raw data the entry was parsed from is not known anymore */
+  g_clear_pointer (&nalparser->sps_data[sps->id], g_bytes_unref);
+  nal_param_set_cache_clear (nalparser->pps_data, GST_H264_MAX_PPS_COUNT);
+
   return GST_H264_PARSER_OK;
 }
 
@@ -2651,9 +2777,32 @@ gst_h264_parser_update_pps (GstH264NalParser * nalparser, GstH264PPS * pps)
 
   nalparser->last_pps = &nalparser->pps[pps->id];
 
+  g_clear_pointer (&nalparser->pps_data[pps->id], g_bytes_unref);
+
   return GST_H264_PARSER_OK;
 }
 
+/**
+ * gst_h264_parser_last_parameter_set_changed:
+ * @nalparser: a #GstH264NalParser
+ *
+ * Identical parameter sets repeated in a stream are not parsed again, the
+ * previously parsed result is returned instead. This can be used to skip
+ * work that only needs to be done when a parameter set actually changed.
+ *
+ * Returns: %TRUE if the SPS or PPS last parsed by @nalparser differs from
+ * the one previously stored with the same id
+ *
+ * Since: 1.24
+ */
+gboolean
+gst_h264_parser_last_parameter_set_changed (GstH264NalParser * nalparser)
+{
+  g_return_val_if_fail (nalparser != NULL, FALSE);
+
+  return nalparser->param_set_changed;
+}
+
 /**
  * gst_h264_quant_matrix_8x8_get_zigzag_from_raster:
  * @out_quant: (out): The resulting quantization matrix
@@ -1361,6 +1361,13 @@ struct _GstH264NalParser
   GstH264PPS pps[GST_H264_MAX_PPS_COUNT];
   GstH264SPS *last_sps;
   GstH264PPS *last_pps;
+
+  /* raw NAL units the parameter sets above were parsed from */
+  GBytes *sps_data[GST_H264_MAX_SPS_COUNT];
+  GBytes *pps_data[GST_H264_MAX_PPS_COUNT];
+  guint32 sps_hash[GST_H264_MAX_SPS_COUNT];
+  guint32 pps_hash[GST_H264_MAX_PPS_COUNT];
+  gboolean param_set_changed;
 };
 
 GST_CODEC_PARSERS_API
@@ -1390,6 +1397,11 @@ GstH264ParserResult gst_h264_parser_parse_slice_hdr   (GstH264NalParser *nalpars
                                                        GstH264SliceHdr *slice, gboolean parse_pred_weight_table,
                                                        gboolean parse_dec_ref_pic_marking);
 
+GST_CODEC_PARSERS_API
+GstH264ParserResult gst_h264_parser_parse_slice_hdr_partial (GstH264NalParser *nalparser,
+                                                             GstH264NalUnit *nalu,
+                                                             GstH264SliceHdr *slice);
+
 GST_CODEC_PARSERS_API
 GstH264ParserResult gst_h264_parser_parse_subset_sps  (GstH264NalParser *nalparser, GstH264NalUnit *nalu,
                                                        GstH264SPS *sps);
@@ -1414,6 +1426,9 @@ GST_CODEC_PARSERS_API
 GstH264ParserResult gst_h264_parser_update_pps        (GstH264NalParser *nalparser,
                                                        GstH264PPS *pps);
 
+GST_CODEC_PARSERS_API
+gboolean gst_h264_parser_last_parameter_set_changed   (GstH264NalParser *nalparser);
+
 GST_CODEC_PARSERS_API
 void gst_h264_nal_parser_free                         (GstH264NalParser *nalparser);
 
@@ -1371,6 +1371,9 @@ gst_h265_parser_new (void)
 void
 gst_h265_parser_free (GstH265Parser * parser)
 {
+  nal_param_set_cache_clear (parser->vps_data, GST_H265_MAX_VPS_COUNT);
+  nal_param_set_cache_clear (parser->sps_data, GST_H265_MAX_SPS_COUNT);
+  nal_param_set_cache_clear (parser->pps_data, GST_H265_MAX_PPS_COUNT);
   g_slice_free (GstH265Parser, parser);
   parser = NULL;
 }
@@ -1802,13 +1805,36 @@ GstH265ParserResult
 gst_h265_parser_parse_vps (GstH265Parser * parser, GstH265NalUnit * nalu,
     GstH265VPS * vps)
 {
-  GstH265ParserResult res = gst_h265_parse_vps (nalu, vps);
+  const guint8 *data = nalu->data + nalu->offset;
+  guint32 hash = nal_param_set_hash (data, nalu->size);
+  GstH265ParserResult res;
+  gint id;
+
+  id = nal_param_set_cache_lookup (parser->vps_data, parser->vps_hash,
+      GST_H265_MAX_VPS_COUNT, data, nalu->size, hash);
+  if (id >= 0 && parser->vps[id].valid) {
+    GST_LOG ("video parameter set with id: %d unchanged", id);
+
+    *vps = parser->vps[id];
+    parser->last_vps = &parser->vps[id];
+    parser->param_set_changed = FALSE;
+    return GST_H265_PARSER_OK;
+  }
+
+  res = gst_h265_parse_vps (nalu, vps);
 
   if (res == GST_H265_PARSER_OK) {
     GST_DEBUG ("adding video parameter set with id: %d to array", vps->id);
 
     parser->vps[vps->id] = *vps;
     parser->last_vps = &parser->vps[vps->id];
+
+    /* SPS and PPS parsing depends on the VPS they refer to */
+    nal_param_set_cache_clear (parser->sps_data, GST_H265_MAX_SPS_COUNT);
+    nal_param_set_cache_clear (parser->pps_data, GST_H265_MAX_PPS_COUNT);
+    nal_param_set_cache_store (parser->vps_data, parser->vps_hash, vps->id,
+        data, nalu->size, hash);
+    parser->param_set_changed = TRUE;
   }
 
   return res;
@@ -1971,14 +1997,37 @@ GstH265ParserResult
 gst_h265_parser_parse_sps (GstH265Parser * parser, GstH265NalUnit * nalu,
     GstH265SPS * sps, gboolean parse_vui_params)
 {
-  GstH265ParserResult res =
-      gst_h265_parse_sps (parser, nalu, sps, parse_vui_params);
+  const guint8 *data = nalu->data + nalu->offset;
+  guint32 hash = nal_param_set_hash (data, nalu->size);
+  GstH265ParserResult res;
+  gint id;
+
+  id = nal_param_set_cache_lookup (parser->sps_data, parser->sps_hash,
+      GST_H265_MAX_SPS_COUNT, data, nalu->size, hash);
+  if (id >= 0 && parser->sps[id].valid
+      && (parser->sps_vui_parsed[id] || !parse_vui_params)) {
+    GST_LOG ("sequence parameter set with id: %d unchanged", id);
+
+    *sps = parser->sps[id];
+    parser->last_sps = &parser->sps[id];
+    parser->param_set_changed = FALSE;
+    return GST_H265_PARSER_OK;
+  }
+
+  res = gst_h265_parse_sps (parser, nalu, sps, parse_vui_params);
 
   if (res == GST_H265_PARSER_OK) {
     GST_DEBUG ("adding sequence parameter set with id: %d to array", sps->id);
 
     parser->sps[sps->id] = *sps;
     parser->last_sps = &parser->sps[sps->id];
+
+    /* PPS parsing depends on the SPS they refer to */
+    nal_param_set_cache_clear (parser->pps_data, GST_H265_MAX_PPS_COUNT);
+    nal_param_set_cache_store (parser->sps_data, parser->sps_hash, sps->id,
+        data, nalu->size, hash);
+    parser->sps_vui_parsed[sps->id] = parse_vui_params;
+    parser->param_set_changed = TRUE;
   }
 
   return res;
@@ -2579,12 +2628,32 @@ GstH265ParserResult
 gst_h265_parser_parse_pps (GstH265Parser * parser,
     GstH265NalUnit * nalu, GstH265PPS * pps)
 {
-  GstH265ParserResult res = gst_h265_parse_pps (parser, nalu, pps);
+  const guint8 *data = nalu->data + nalu->offset;
+  guint32 hash = nal_param_set_hash (data, nalu->size);
+  GstH265ParserResult res;
+  gint id;
+
+  id = nal_param_set_cache_lookup (parser->pps_data, parser->pps_hash,
+      GST_H265_MAX_PPS_COUNT, data, nalu->size, hash);
+  if (id >= 0 && parser->pps[id].valid) {
+    GST_LOG ("picture parameter set with id: %d unchanged", id);
+
+    *pps = parser->pps[id];
+    parser->last_pps = &parser->pps[id];
+    parser->param_set_changed = FALSE;
+    return GST_H265_PARSER_OK;
+  }
+
+  res = gst_h265_parse_pps (parser, nalu, pps);
   if (res == GST_H265_PARSER_OK) {
     GST_DEBUG ("adding picture parameter set with id: %d to array", pps->id);
 
     parser->pps[pps->id] = *pps;
     parser->last_pps = &parser->pps[pps->id];
+
+    nal_param_set_cache_store (parser->pps_data, parser->pps_hash, pps->id,
+        data, nalu->size, hash);
+    parser->param_set_changed = TRUE;
   }
 
   return res;
@@ -2674,51 +2743,26 @@ gst_h265_parser_fill_pps (GstH265Parser * parser, GstH265PPS * pps)
   return ret;
 }
 
-/**
- * gst_h265_parser_parse_slice_hdr:
- * @parser: a #GstH265Parser
- * @nalu: The `GST_H265_NAL_SLICE` #GstH265NalUnit to parse
- * @slice: The #GstH265SliceHdr to fill.
- *
- * Parses @data, and fills the @slice structure.
- * The resulting @slice_hdr structure shall be deallocated with
- * gst_h265_slice_hdr_free() when it is no longer needed
- *
- * Returns: a #GstH265ParserResult
- */
-GstH265ParserResult
-gst_h265_parser_parse_slice_hdr (GstH265Parser * parser,
-    GstH265NalUnit * nalu, GstH265SliceHdr * slice)
+/* Parses the slice header up to and including slice_type */
+static GstH265ParserResult
+gst_h265_parser_parse_slice_hdr_start (GstH265Parser * parser,
+    NalReader * nr, GstH265NalUnit * nalu, GstH265SliceHdr * slice)
 {
-  NalReader nr;
   gint pps_id;
   GstH265PPS *pps;
   GstH265SPS *sps;
   guint i;
-  GstH265ShortTermRefPicSet *stRPS = NULL;
-  guint32 UsedByCurrPicLt[16];
   guint32 PicSizeInCtbsY;
-  gint NumPocTotalCurr = 0;
   GstH265ParserResult err;
 
-  memset (slice, 0, sizeof (*slice));
-
-  if (!nalu->size) {
-    GST_DEBUG ("Invalid Nal Unit");
-    return GST_H265_PARSER_ERROR;
-  }
-
-  nal_reader_init (&nr, nalu->data + nalu->offset + nalu->header_bytes,
-      nalu->size - nalu->header_bytes);
-
   GST_DEBUG ("parsing \"Slice header\", slice type");
 
-  READ_UINT8 (&nr, slice->first_slice_segment_in_pic_flag, 1);
+  READ_UINT8 (nr, slice->first_slice_segment_in_pic_flag, 1);
 
   if (GST_H265_IS_NAL_TYPE_IRAP (nalu->type))
-    READ_UINT8 (&nr, slice->no_output_of_prior_pics_flag, 1);
+    READ_UINT8 (nr, slice->no_output_of_prior_pics_flag, 1);
 
-  READ_UE_MAX (&nr, pps_id, GST_H265_MAX_PPS_COUNT - 1);
+  READ_UE_MAX (nr, pps_id, GST_H265_MAX_PPS_COUNT - 1);
   pps = gst_h265_parser_get_pps (parser, pps_id);
   if (!pps) {
     GST_WARNING
@@ -2756,16 +2800,115 @@ gst_h265_parser_parse_slice_hdr (GstH265Parser * parser,
     const guint n = ceil_log2 (PicSizeInCtbsY);
 
     if (pps->dependent_slice_segments_enabled_flag)
-      READ_UINT8 (&nr, slice->dependent_slice_segment_flag, 1);
+      READ_UINT8 (nr, slice->dependent_slice_segment_flag, 1);
     /* sice_segment_address parsing */
-    READ_UINT32 (&nr, slice->segment_address, n);
+    READ_UINT32 (nr, slice->segment_address, n);
   }
 
   if (!slice->dependent_slice_segment_flag) {
     for (i = 0; i < pps->num_extra_slice_header_bits; i++)
-      nal_reader_skip (&nr, 1);
-    READ_UE_MAX (&nr, slice->type, 63);
+      nal_reader_skip (nr, 1);
+    READ_UE_MAX (nr, slice->type, 63);
+  }
+
+  return GST_H265_PARSER_OK;
+
+error:
+  GST_WARNING ("error parsing \"Slice header\"");
+  return GST_H265_PARSER_ERROR;
+}
+
+/**
+ * gst_h265_parser_parse_slice_hdr_partial:
+ * @parser: a #GstH265Parser
+ * @nalu: The `GST_H265_NAL_SLICE` #GstH265NalUnit to parse
+ * @slice: The #GstH265SliceHdr to fill.
+ *
+ * Parses only the beginning of the slice segment header of @nalu, up to and
+ * including slice_type: @first_slice_segment_in_pic_flag,
+ * @no_output_of_prior_pics_flag, @pps, @dependent_slice_segment_flag,
+ * @segment_address and @type are filled, the other fields keep their default
+ * values. This is much cheaper than gst_h265_parser_parse_slice_hdr() and is
+ * enough to find picture boundaries and picture types, but the rest of the
+ * header is not validated.
+ *
+ * Unlike with gst_h265_parser_parse_slice_hdr(), @slice doesn't need to be
+ * freed with gst_h265_slice_hdr_free() afterwards.
+ *
+ * Returns: a #GstH265ParserResult
+ *
+ * Since: 1.24
+ */
+GstH265ParserResult
+gst_h265_parser_parse_slice_hdr_partial (GstH265Parser * parser,
+    GstH265NalUnit * nalu, GstH265SliceHdr * slice)
+{
+  NalReader nr;
+  GstH265ParserResult res;
+
+  memset (slice, 0, sizeof (*slice));
+
+  if (!nalu->size) {
+    GST_DEBUG ("Invalid Nal Unit");
+    return GST_H265_PARSER_ERROR;
+  }
+
+  nal_reader_init (&nr, nalu->data + nalu->offset + nalu->header_bytes,
+      nalu->size - nalu->header_bytes);
+
+  res = gst_h265_parser_parse_slice_hdr_start (parser, &nr, nalu, slice);
+  if (res != GST_H265_PARSER_OK)
+    return res;
+
+  slice->header_size = nal_reader_get_pos (&nr);
+  slice->n_emulation_prevention_bytes = nal_reader_get_epb_count (&nr);
+
+  return GST_H265_PARSER_OK;
+}
+
+/**
+ * gst_h265_parser_parse_slice_hdr:
+ * @parser: a #GstH265Parser
+ * @nalu: The `GST_H265_NAL_SLICE` #GstH265NalUnit to parse
+ * @slice: The #GstH265SliceHdr to fill.
+ *
+ * Parses @data, and fills the @slice structure.
+ * The resulting @slice_hdr structure shall be deallocated with
+ * gst_h265_slice_hdr_free() when it is no longer needed
+ *
+ * Returns: a #GstH265ParserResult
+ */
+GstH265ParserResult
+gst_h265_parser_parse_slice_hdr (GstH265Parser * parser,
+    GstH265NalUnit * nalu, GstH265SliceHdr * slice)
+{
+  NalReader nr;
+  GstH265PPS *pps;
+  GstH265SPS *sps;
+  guint i;
+  GstH265ShortTermRefPicSet *stRPS = NULL;
+  guint32 UsedByCurrPicLt[16];
+  gint NumPocTotalCurr = 0;
+  GstH265ParserResult err;
+
+  memset (slice, 0, sizeof (*slice));
 
+  if (!nalu->size) {
+    GST_DEBUG ("Invalid Nal Unit");
+    return GST_H265_PARSER_ERROR;
+  }
+
+  nal_reader_init (&nr, nalu->data + nalu->offset + nalu->header_bytes,
+      nalu->size - nalu->header_bytes);
+
+  err = gst_h265_parser_parse_slice_hdr_start (parser, &nr, nalu, slice);
+  if (err != GST_H265_PARSER_OK)
+    return err;
+
+  pps = slice->pps;
+  sps = pps->sps;
+
+  if (!slice->dependent_slice_segment_flag) {
     if (pps->output_flag_present_flag)
       READ_UINT8 (&nr, slice->pic_output_flag, 1);
     if (sps->separate_colour_plane_flag == 1)
@@ -3321,6 +3464,11 @@ gst_h265_parser_update_vps (GstH265Parser * parser, GstH265VPS * vps)
   parser->vps[vps->id] = *vps;
   parser->last_vps = &parser->vps[vps->id];
 
+  /* the raw data the entry was parsed from is not known anymore */
+  g_clear_pointer (&parser->vps_data[vps->id], g_bytes_unref);
+  nal_param_set_cache_clear (parser->sps_data, GST_H265_MAX_SPS_COUNT);
+  nal_param_set_cache_clear (parser->pps_data, GST_H265_MAX_PPS_COUNT);
+
   return GST_H265_PARSER_OK;
 }
 
@@ -3362,6 +3510,9 @@ gst_h265_parser_update_sps (GstH265Parser * parser, GstH265SPS * sps)
   parser->sps[sps->id] = *sps;
   parser->last_sps = &parser->sps[sps->id];
 
+  g_clear_pointer (&parser->sps_data[sps->id], g_bytes_unref);
+  nal_param_set_cache_clear (parser->pps_data, GST_H265_MAX_PPS_COUNT);
+
   return GST_H265_PARSER_OK;
 }
 
@@ -3408,9 +3559,32 @@ gst_h265_parser_update_pps (GstH265Parser * parser, GstH265PPS * pps)
   parser->pps[pps->id] = *pps;
   parser->last_pps = &parser->pps[pps->id];
 
+  g_clear_pointer (&parser->pps_data[pps->id], g_bytes_unref);
+
   return GST_H265_PARSER_OK;
 }
 
+/**
+ * gst_h265_parser_last_parameter_set_changed:
+ * @parser: a #GstH265Parser
+ *
+ * Identical parameter sets repeated in a stream are not parsed again, the
+ * previously parsed result is returned instead. This can be used to skip
+ * work that only needs to be done when a parameter set actually changed.
+ *
+ * Returns: %TRUE if the VPS, SPS or PPS last parsed by @parser differs from
+ * the one previously stored with the same id
+ *
+ * Since: 1.24
+ */
+gboolean
+gst_h265_parser_last_parameter_set_changed (GstH265Parser * parser)
+{
+  g_return_val_if_fail (parser != NULL, FALSE);
+
+  return parser->param_set_changed;
+}
+
 /**
  * gst_h265_quant_matrix_4x4_get_zigzag_from_raster:
  * @out_quant: (out): The resulting quantization matrix
@@ -1670,6 +1670,16 @@ struct _GstH265Parser
   GstH265VPS *last_vps;
   GstH265SPS *last_sps;
   GstH265PPS *last_pps;
+
+  /* raw NAL units the parameter sets above were parsed from */
+  GBytes *vps_data[GST_H265_MAX_VPS_COUNT];
+  GBytes *sps_data[GST_H265_MAX_SPS_COUNT];
+  GBytes *pps_data[GST_H265_MAX_PPS_COUNT];
+  guint32 vps_hash[GST_H265_MAX_VPS_COUNT];
+  guint32 sps_hash[GST_H265_MAX_SPS_COUNT];
+  guint32 pps_hash[GST_H265_MAX_PPS_COUNT];
+  gboolean sps_vui_parsed[GST_H265_MAX_SPS_COUNT];
+  gboolean param_set_changed;
 };
 
 GST_CODEC_PARSERS_API
@@ -1715,6 +1725,11 @@ GstH265ParserResult gst_h265_parser_parse_slice_hdr (GstH265Parser   * parser,
                                                      GstH265NalUnit  * nalu,
                                                      GstH265SliceHdr * slice);
 
+GST_CODEC_PARSERS_API
+GstH265ParserResult gst_h265_parser_parse_slice_hdr_partial (GstH265Parser   * parser,
+                                                             GstH265NalUnit  * nalu,
+                                                             GstH265SliceHdr * slice);
+
 GST_CODEC_PARSERS_API
 GstH265ParserResult gst_h265_parser_parse_vps       (GstH265Parser   * parser,
                                                      GstH265NalUnit  * nalu,
@@ -1748,6 +1763,9 @@ GST_CODEC_PARSERS_API
 GstH265ParserResult gst_h265_parser_update_pps      (GstH265Parser   * parser,
                                                      GstH265PPS      * pps);
 
+GST_CODEC_PARSERS_API
+gboolean gst_h265_parser_last_parameter_set_changed (GstH265Parser * parser);
+
 GST_CODEC_PARSERS_API
 void                gst_h265_parser_free            (GstH265Parser  * parser);
 
@@ -255,17 +255,18 @@ jpeg_parse_to_next_marker (GstByteReader * br, GstJpegMarker * marker)
 static gint
 gst_jpeg_scan_for_marker_code (const guint8 * data, gsize size, guint offset)
 {
-  guint i;
-
-  i = offset + 1;
-  while (i < size) {
-    const guint8 v = data[i];
-    if (v < 0xc0)
-      i += 2;
-    else if (v < 0xff && data[i - 1] == 0xff)
-      return i - 1;
-    else
-      i++;
+  const guint8 *p = data + offset;
+  const guint8 *end = data + size;
+
+  /* Markers are rare, so let memchr() find the 0xff prefixes. Fill bytes
+   * are skipped by looking at the byte after each prefix */
+  while (p < end && end - p >= 2) {
+    p = memchr (p, 0xff, end - p - 1);
+    if (!p)
+      return -1;
+    if (p[1] >= 0xc0 && p[1] < 0xff)
+      return p - data;
+    p++;
   }
   return -1;
 }
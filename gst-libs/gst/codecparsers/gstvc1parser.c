@@ -684,12 +684,8 @@ failed:
 static inline gint
 scan_for_start_codes (const guint8 * data, guint size)
 {
-  GstByteReader br;
-  gst_byte_reader_init (&br, data, size);
-
-  /* NALU not empty, so we can at least expect 1 (even 2) bytes following sc */
-  return gst_byte_reader_masked_scan_uint32 (&br, 0xffffff00, 0x00000100,
-      0, size);
+  /* BDU not empty, so we can at least expect 1 (even 2) bytes following sc */
+  return find_start_code (data, size);
 }
 
 static inline gint
@@ -2108,6 +2104,9 @@ gst_vc1_parse_field_header (const guint8 * data, gsize size,
  *
  * Parses @data, and fills @slicehdr fields.
  *
+ * @seqhdr is only read, so the slices of a picture can be parsed
+ * concurrently.
+ *
  * Returns: a #GstVC1ParserResult
  *
  * Since: 1.2
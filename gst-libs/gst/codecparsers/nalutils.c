@@ -74,39 +74,53 @@ nal_reader_init (NalReader * nr, const guint8 * data, guint size)
   nr->byte = 0;
   nr->bits_in_cache = 0;
   /* fill with something other than 0 to detect emulation prevention bytes */
-  nr->first_byte = 0xff;
   nr->epb_cache = 0xff;
-  nr->cache = 0xff;
+  nr->cache = 0;
 }
 
-gboolean
-nal_reader_read (NalReader * nr, guint nbits)
+/* The cache is refilled with as many bytes as fit in it (at least 49 bits),
+ * so most reads don't need to touch the data at all. Emulation prevention
+ * bytes are only skipped once the bits before them are not enough for
+ * the current read, which keeps nal_reader_get_pos() and
+ * nal_reader_get_epb_count() exact for the bits actually consumed. */
+static inline void
+nal_reader_fill (NalReader * nr, guint nbits)
 {
-  if (G_UNLIKELY (nr->byte * 8 + (nbits - nr->bits_in_cache) > nr->size * 8)) {
-    GST_DEBUG ("Can not read %u bits, bits in cache %u, Byte * 8 %u, size in "
-        "bits %u", nbits, nr->bits_in_cache, nr->byte * 8, nr->size * 8);
-    return FALSE;
-  }
-
-  while (nr->bits_in_cache < nbits) {
-    guint8 byte;
-
-  next_byte:
-    if (G_UNLIKELY (nr->byte >= nr->size))
-      return FALSE;
-
-    byte = nr->data[nr->byte++];
-    nr->epb_cache = (nr->epb_cache << 8) | byte;
+  while (nr->bits_in_cache <= 48 && nr->byte < nr->size) {
+    guint8 byte = nr->data[nr->byte];
 
     /* check if the byte is a emulation_prevention_three_byte */
-    if ((nr->epb_cache & 0xffffff) == 0x3) {
+    if (G_UNLIKELY ((nr->epb_cache & 0xffff) == 0 && byte == 0x3)) {
+      if (nr->bits_in_cache >= nbits)
+        break;
+
+      nr->epb_cache = (nr->epb_cache << 8) | byte;
+      nr->byte++;
       nr->n_epb++;
-      goto next_byte;
+      continue;
     }
-    nr->cache = (nr->cache << 8) | nr->first_byte;
-    nr->first_byte = byte;
+
+    nr->epb_cache = (nr->epb_cache << 8) | byte;
+    nr->cache = (nr->cache << 8) | byte;
+    nr->byte++;
     nr->bits_in_cache += 8;
   }
+}
+
+/* Makes sure @nbits (at most 32) are available in the cache */
+gboolean
+nal_reader_read (NalReader * nr, guint nbits)
+{
+  if (G_LIKELY (nr->bits_in_cache >= nbits))
+    return TRUE;
+
+  nal_reader_fill (nr, nbits);
+
+  if (G_UNLIKELY (nr->bits_in_cache < nbits)) {
+    GST_DEBUG ("Can not read %u bits, bits in cache %u, Byte * 8 %u, size in "
+        "bits %u", nbits, nr->bits_in_cache, nr->byte * 8, nr->size * 8);
+    return FALSE;
+  }
 
   return TRUE;
 }
@@ -118,6 +132,12 @@ nal_reader_skip (NalReader * nr, guint nbits)
 {
   g_assert (nbits <= 8 * sizeof (nr->cache));
 
+  if (G_UNLIKELY (nbits > 32)) {
+    if (G_UNLIKELY (!nal_reader_skip (nr, 32)))
+      return FALSE;
+    nbits -= 32;
+  }
+
   if (G_UNLIKELY (!nal_reader_read (nr, nbits)))
     return FALSE;
 
@@ -166,21 +186,12 @@ nal_reader_get_epb_count (const NalReader * nr)
 gboolean \
 nal_reader_get_bits_uint##bits (NalReader *nr, guint##bits *val, guint nbits) \
 { \
-  guint shift; \
-  \
   if (!nal_reader_read (nr, nbits)) \
     return FALSE; \
   \
-  /* bring the required bits down and truncate */ \
-  shift = nr->bits_in_cache - nbits; \
-  *val = nr->first_byte >> shift; \
-  \
-  *val |= nr->cache << (8 - shift); \
-  /* mask out required bits */ \
-  if (nbits < bits) \
-    *val &= ((guint##bits)1 << nbits) - 1; \
-  \
-  nr->bits_in_cache = shift; \
+  /* bring the required bits down and mask them out */ \
+  nr->bits_in_cache -= nbits; \
+  *val = (nr->cache >> nr->bits_in_cache) & (((guint64) 1 << nbits) - 1); \
   \
   return TRUE; \
 } \
@@ -201,6 +212,15 @@ nal_reader_peek_bits_uint##bits (const NalReader *nr, guint##bits *val, guint nb
 
 NAL_READER_PEEK_BITS (8);
 
+/* Number of leading zero bits of @v, which must not be 0 */
+static inline guint
+nal_reader_clz64 (guint64 v)
+{
+  if (v >> 32)
+    return 31 - g_bit_nth_msf ((gulong) (v >> 32), -1);
+  return 63 - g_bit_nth_msf ((gulong) (v & G_MAXUINT32), -1);
+}
+
 gboolean
 nal_reader_get_ue (NalReader * nr, guint32 * val)
 {
@@ -208,6 +228,26 @@ nal_reader_get_ue (NalReader * nr, guint32 * val)
   guint8 bit;
   guint32 value;
 
+  /* Fast path: if the whole code is in the cache, count its leading zeros
+   * and read it at once. The code is the value + 1 written on 2 * lz + 1
+   * bits. */
+  nal_reader_fill (nr, 0);
+  if (G_LIKELY (nr->bits_in_cache > 0)) {
+    guint64 bits = nr->cache << (64 - nr->bits_in_cache);
+
+    if (G_LIKELY (bits != 0)) {
+      guint len = 2 * nal_reader_clz64 (bits) + 1;
+
+      if (G_LIKELY (len <= nr->bits_in_cache)) {
+        nr->bits_in_cache -= len;
+        *val = (guint32) (bits >> (64 - len)) - 1;
+        return TRUE;
+      }
+    }
+  }
+
+  /* Slow path for codes crossing an emulation prevention byte or the end of
+   * the data, and for overly long ones */
   if (G_UNLIKELY (!nal_reader_get_bits_uint8 (nr, &bit, 1)))
     return FALSE;
 
@@ -247,7 +287,7 @@ nal_reader_get_se (NalReader * nr, gint32 * val)
 gboolean
 nal_reader_is_byte_aligned (NalReader * nr)
 {
-  if (nr->bits_in_cache != 0)
+  if (nr->bits_in_cache % 8 != 0)
     return FALSE;
   return TRUE;
 }
@@ -306,6 +346,71 @@ scan_for_start_codes (const guint8 * data, guint size)
       0, size);
 }
 
+/***********  parameter set cache ***************/
+
+/* Parameter sets are usually repeated verbatim in a stream, the parsers
+ * keep the raw bytes of the last parameter set parsed for each id so
+ * identical ones can be recognized without parsing them again. */
+
+/* FNV-1a */
+guint32
+nal_param_set_hash (const guint8 * data, gsize size)
+{
+  guint32 hash = 2166136261u;
+  gsize i;
+
+  for (i = 0; i < size; i++) {
+    hash ^= data[i];
+    hash *= 16777619u;
+  }
+
+  return hash;
+}
+
+/* Returns the id whose cached parameter set is identical to @data,
+ * or -1 if there is none */
+gint
+nal_param_set_cache_lookup (GBytes * const *cache, const guint32 * hashes,
+    guint n_entries, const guint8 * data, gsize size, guint32 hash)
+{
+  guint i;
+
+  for (i = 0; i < n_entries; i++) {
+    gconstpointer cached;
+    gsize cached_size;
+
+    if (!cache[i] || hashes[i] != hash)
+      continue;
+
+    cached = g_bytes_get_data (cache[i], &cached_size);
+    if (cached_size == size && memcmp (cached, data, size) == 0)
+      return i;
+  }
+
+  return -1;
+}
+
+void
+nal_param_set_cache_store (GBytes ** cache, guint32 * hashes, guint id,
+    const guint8 * data, gsize size, guint32 hash)
+{
+  if (cache[id])
+    g_bytes_unref (cache[id]);
+  cache[id] = g_bytes_new (data, size);
+  hashes[id] = hash;
+}
+
+void
+nal_param_set_cache_clear (GBytes ** cache, guint n_entries)
+{
+  guint i;
+
+  for (i = 0; i < n_entries; i++)
+    g_clear_pointer (&cache[i], g_bytes_unref);
+}
+
+/***********  end of parameter set cache ***************/
+
 void
 nal_writer_init (NalWriter * nw, guint nal_prefix_size, gboolean packetized)
 {
@@ -49,10 +49,9 @@ typedef struct
 
   guint n_epb;                  /* Number of emulation prevention bytes */
   guint byte;                   /* Byte position */
-  guint bits_in_cache;          /* bitpos in the cache of next bit */
-  guint8 first_byte;
+  guint bits_in_cache;          /* number of unread bits in the cache */
   guint32 epb_cache;            /* cache 3 bytes to check emulation prevention bytes */
-  guint64 cache;                /* cached bytes */
+  guint64 cache;                /* cached bytes, unread bits are the lowest ones */
 } NalReader;
 
 typedef struct
@@ -196,6 +195,20 @@ gboolean nal_reader_get_se (NalReader * nr, gint32 * val);
 G_GNUC_INTERNAL
 gint scan_for_start_codes (const guint8 * data, guint size);
 
+G_GNUC_INTERNAL
+guint32 nal_param_set_hash (const guint8 * data, gsize size);
+
+G_GNUC_INTERNAL
+gint nal_param_set_cache_lookup (GBytes * const * cache, const guint32 * hashes,
+    guint n_entries, const guint8 * data, gsize size, guint32 hash);
+
+G_GNUC_INTERNAL
+void nal_param_set_cache_store (GBytes ** cache, guint32 * hashes, guint id,
+    const guint8 * data, gsize size, guint32 hash);
+
+G_GNUC_INTERNAL
+void nal_param_set_cache_clear (GBytes ** cache, guint n_entries);
+
 G_GNUC_INTERNAL
 void nal_writer_init (NalWriter * nw, guint nal_prefix_size, gboolean packetized);
 
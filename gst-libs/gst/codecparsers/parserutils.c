@@ -24,6 +24,8 @@
 
 #include "parserutils.h"
 
+#include <string.h>
+
 gboolean
 decode_vlc (GstBitReader * br, guint * res, const VLCTable * table,
     guint length)
@@ -58,3 +60,38 @@ failed:
     return FALSE;
   }
 }
+
+/* Returns the offset of the first 0x000001 start code prefix of @data that is
+ * followed by at least one byte, or -1 if there is none.
+ *
+ * Instead of checking the data byte by byte, this looks for the 0x01 byte with
+ * memchr(), which the C library implements with wide loads, and only then
+ * checks the two preceding bytes. In compressed payloads 0x01 bytes are rare,
+ * so most of the data is skipped in large chunks. */
+gint
+find_start_code (const guint8 * data, guint size)
+{
+  const guint8 *p, *end;
+
+  if (size < 4)
+    return -1;
+
+  /* The last byte can't be the 0x01 of a complete start code */
+  end = data + size - 1;
+  p = data + 2;
+
+  while (p < end) {
+    p = memchr (p, 0x01, end - p);
+    if (!p)
+      return -1;
+
+    if (p[-1] == 0x00 && p[-2] == 0x00)
+      return p - data - 2;
+
+    /* This 0x01 is one of the two bytes preceding the next two positions,
+     * so neither of them can end a start code either */
+    p += 3;
+  }
+
+  return -1;
+}
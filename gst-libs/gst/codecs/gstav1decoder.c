@@ -50,6 +50,12 @@ struct _GstAV1DecoderPrivate
   gboolean is_live;
 
   gboolean input_state_changed;
+
+  /* OBUs of the current input buffer, GstAV1OBUIndexEntry */
+  GArray *obu_index;
+  /* Tile group passed to decode_tile(), reused to avoid copying the whole
+   * entry array on the stack for every tile group */
+  GstAV1Tile tile;
 };
 
 typedef struct
@@ -126,6 +132,8 @@ gst_av1_decoder_init (GstAV1Decoder * self)
       gst_queue_array_new_for_struct (sizeof (GstAV1DecoderOutputFrame), 1);
   gst_queue_array_set_clear_func (priv->output_queue,
       (GDestroyNotify) gst_av1_decoder_clear_output_frame);
+  priv->obu_index = g_array_sized_new (FALSE, FALSE,
+      sizeof (GstAV1OBUIndexEntry), 8);
 }
 
 static void
@@ -135,6 +143,7 @@ gst_av1_decoder_finalize (GObject * object)
   GstAV1DecoderPrivate *priv = self->priv;
 
   gst_queue_array_free (priv->output_queue);
+  g_array_unref (priv->obu_index);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -428,7 +437,7 @@ gst_av1_decoder_decode_tile_group (GstAV1Decoder * self,
   GstAV1DecoderPrivate *priv = self->priv;
   GstAV1DecoderClass *klass = GST_AV1_DECODER_GET_CLASS (self);
   GstAV1Picture *picture = priv->current_picture;
-  GstAV1Tile tile;
+  GstAV1Tile *tile = &priv->tile;
   GstFlowReturn ret = GST_FLOW_OK;
 
   if (!picture) {
@@ -441,11 +450,22 @@ gst_av1_decoder_decode_tile_group (GstAV1Decoder * self,
     return GST_FLOW_ERROR;
   }
 
-  tile.obu = *obu;
-  tile.tile_group = *tile_group;
+  tile->obu = *obu;
+  /* Only the entries of this tile group are meaningful */
+  if (tile_group != &tile->tile_group) {
+    tile->tile_group.tile_start_and_end_present_flag =
+        tile_group->tile_start_and_end_present_flag;
+    tile->tile_group.tg_start = tile_group->tg_start;
+    tile->tile_group.tg_end = tile_group->tg_end;
+    tile->tile_group.num_tiles = tile_group->num_tiles;
+    memcpy (&tile->tile_group.entry[tile_group->tg_start],
+        &tile_group->entry[tile_group->tg_start],
+        (tile_group->tg_end - tile_group->tg_start + 1) *
+        sizeof (tile_group->entry[0]));
+  }
 
   g_assert (klass->decode_tile);
-  ret = klass->decode_tile (self, picture, &tile);
+  ret = klass->decode_tile (self, picture, tile);
   if (ret != GST_FLOW_OK) {
     GST_WARNING_OBJECT (self, "Decode tile error");
     return ret;
@@ -555,15 +575,15 @@ gst_av1_decoder_process_tile_group (GstAV1Decoder * self, GstAV1OBU * obu)
 {
   GstAV1ParserResult res;
   GstAV1DecoderPrivate *priv = self->priv;
-  GstAV1TileGroupOBU tile_group;
+  GstAV1TileGroupOBU *tile_group = &priv->tile.tile_group;
 
-  res = gst_av1_parser_parse_tile_group_obu (priv->parser, obu, &tile_group);
+  res = gst_av1_parser_parse_tile_group_obu (priv->parser, obu, tile_group);
   if (res != GST_AV1_PARSER_OK) {
     GST_WARNING_OBJECT (self, "Parsing tile group failed.");
     return GST_FLOW_ERROR;
   }
 
-  return gst_av1_decoder_decode_tile_group (self, &tile_group, obu);
+  return gst_av1_decoder_decode_tile_group (self, tile_group, obu);
 }
 
 static GstFlowReturn
@@ -675,8 +695,9 @@ gst_av1_decoder_handle_frame (GstVideoDecoder * decoder,
   GstMapInfo map;
   GstFlowReturn ret = GST_FLOW_OK;
   guint32 total_consumed, consumed;
-  GstAV1OBU obu;
+  GstAV1OBU obu = { 0, };
   GstAV1ParserResult res;
+  guint i;
 
   GST_LOG_OBJECT (self, "handle frame id %d, buf %" GST_PTR_FORMAT,
       frame->system_frame_number, in_buf);
@@ -693,11 +714,23 @@ gst_av1_decoder_handle_frame (GstVideoDecoder * decoder,
 
   total_consumed = 0;
   while (total_consumed < map.size) {
-    res = gst_av1_parser_identify_one_obu (priv->parser,
-        map.data + total_consumed, map.size, &obu, &consumed);
-    if (res == GST_AV1_PARSER_DROP) {
-      total_consumed += consumed;
-      continue;
+    /* Usually identifies the whole temporal unit at once, but stops after
+     * each sequence header which may change the operating point */
+    res = gst_av1_parser_identify_obus (priv->parser,
+        map.data + total_consumed, map.size - total_consumed,
+        priv->obu_index, &consumed);
+
+    for (i = 0; i < priv->obu_index->len; i++) {
+      GstAV1OBUIndexEntry *entry =
+          &g_array_index (priv->obu_index, GstAV1OBUIndexEntry, i);
+
+      obu = entry->obu;
+      if (entry->dropped)
+        continue;
+
+      ret = gst_av1_decoder_decode_one_obu (self, &obu);
+      if (ret != GST_FLOW_OK)
+        goto out;
     }
 
     if (res != GST_AV1_PARSER_OK) {
@@ -705,11 +738,6 @@ gst_av1_decoder_handle_frame (GstVideoDecoder * decoder,
       goto out;
     }
 
-    ret = gst_av1_decoder_decode_one_obu (self, &obu);
-    if (ret != GST_FLOW_OK) {
-      goto out;
-    }
-
     total_consumed += consumed;
   }
 
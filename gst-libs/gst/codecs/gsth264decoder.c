@@ -132,6 +132,16 @@ struct _GstH264DecoderPrivate
   gboolean process_ref_pic_lists;
   guint preferred_output_delay;
 
+  /* Reorder depth observed from the POCs, used instead of the whole DPB
+   * size in low-latency modes when the SPS doesn't signal
+   * max_num_reorder_frames */
+  gboolean infer_reorder;
+  gboolean reorder_known;
+  guint reorder_depth;
+  guint reorder_observed;
+  gint32 recent_pocs[GST_H264_DPB_MAX_SIZE];
+  guint n_recent_pocs;
+
   /* Reference picture lists, constructed for each frame */
   GArray *ref_pic_list_p0;
   GArray *ref_pic_list_b0;
@@ -148,6 +158,12 @@ struct _GstH264DecoderPrivate
   GArray *ref_pic_list0;
   GArray *ref_pic_list1;
 
+  /* The slice header fields ref_pic_list0 and ref_pic_list1 were built from.
+   * Following slices of the same picture requesting identical lists reuse
+   * them instead of building them again */
+  gboolean ref_pic_lists_valid;
+  GstH264SliceHdr ref_pic_lists_slice_hdr;
+
   /* For delayed output */
   GstQueueArray *output_queue;
 
@@ -208,7 +224,11 @@ static void gst_h264_decoder_finish_picture (GstH264Decoder * self,
 static void gst_h264_decoder_prepare_ref_pic_lists (GstH264Decoder * self,
     GstH264Picture * current_picture);
 static void gst_h264_decoder_clear_ref_pic_lists (GstH264Decoder * self);
+static void gst_h264_decoder_invalidate_slice_ref_pic_lists (GstH264Decoder *
+    self);
 static gboolean gst_h264_decoder_modify_ref_pic_lists (GstH264Decoder * self);
+static void gst_h264_decoder_set_latency (GstH264Decoder * self,
+    const GstH264SPS * sps, gint max_dpb_size);
 static gboolean
 gst_h264_decoder_sliding_window_picture_marking (GstH264Decoder * self,
     GstH264Picture * picture);
@@ -2063,6 +2083,61 @@ get_bump_level (GstH264Decoder * self)
   return GST_H264_DPB_BUMP_NORMAL_LATENCY;
 }
 
+/* Tracks the number of frames preceding @picture in decoding order and
+ * following it in output order, which is what max_num_reorder_frames bounds.
+ * A frame can't be delayed by more than the DPB size, so once twice as many
+ * frames have been seen the largest value is used as reorder depth. If the
+ * stream later reorders more, the depth and the latency are raised again. */
+static void
+gst_h264_decoder_observe_reorder (GstH264Decoder * self,
+    GstH264Picture * picture)
+{
+  GstH264DecoderPrivate *priv = self->priv;
+  guint max_num_frames = gst_h264_dpb_get_max_num_frames (priv->dpb);
+  guint reorder = 0;
+  guint i;
+
+  if (picture->second_field || picture->nonexisting)
+    return;
+
+  /* The POCs restart from here */
+  if (picture->idr || picture->mem_mgmt_5)
+    priv->n_recent_pocs = 0;
+
+  for (i = 0; i < priv->n_recent_pocs; i++) {
+    if (priv->recent_pocs[i] > picture->pic_order_cnt)
+      reorder++;
+  }
+
+  if (priv->n_recent_pocs >= max_num_frames) {
+    priv->n_recent_pocs = max_num_frames - 1;
+    memmove (priv->recent_pocs, priv->recent_pocs + 1,
+        priv->n_recent_pocs * sizeof (gint32));
+  }
+  priv->recent_pocs[priv->n_recent_pocs++] = picture->pic_order_cnt;
+
+  if (reorder > priv->reorder_depth) {
+    priv->reorder_depth = MIN (reorder, max_num_frames);
+    if (priv->reorder_known) {
+      GST_WARNING_OBJECT (self, "Stream reorders more than observed so far, "
+          "raising reorder depth to %u", priv->reorder_depth);
+      gst_h264_dpb_set_max_num_reorder_frames (priv->dpb,
+          priv->reorder_depth);
+      gst_h264_decoder_set_latency (self, priv->active_sps, max_num_frames);
+    }
+  }
+
+  if (priv->reorder_known || ++priv->reorder_observed < 2 * max_num_frames)
+    return;
+
+  GST_DEBUG_OBJECT (self, "Inferred reorder depth %u from %u frames",
+      priv->reorder_depth, priv->reorder_observed);
+
+  priv->reorder_known = TRUE;
+  gst_h264_dpb_set_max_num_reorder_frames (priv->dpb, priv->reorder_depth);
+  gst_h264_decoder_set_latency (self, priv->active_sps, max_num_frames);
+}
+
 static void
 gst_h264_decoder_finish_picture (GstH264Decoder * self,
     GstH264Picture * picture, GstFlowReturn * ret)
@@ -2103,6 +2178,9 @@ gst_h264_decoder_finish_picture (GstH264Decoder * self,
     gst_video_decoder_release_frame (decoder, frame);
   }
 
+  if (priv->infer_reorder)
+    gst_h264_decoder_observe_reorder (self, picture);
+
   /* C.4.4 */
   if (picture->mem_mgmt_5) {
     GstFlowReturn drain_ret;
@@ -2190,10 +2268,13 @@ gst_h264_decoder_update_max_num_reorder_frames (GstH264Decoder * self,
     }
 
     gst_h264_dpb_set_max_num_reorder_frames (priv->dpb, max_num_reorder_frames);
+    priv->infer_reorder = FALSE;
 
     return TRUE;
   }
 
+  priv->infer_reorder = FALSE;
+
   if (priv->compliance == GST_H264_DECODER_COMPLIANCE_STRICT) {
     gst_h264_dpb_set_max_num_reorder_frames (priv->dpb,
         gst_h264_dpb_get_max_num_frames (priv->dpb));
@@ -2224,6 +2305,18 @@ gst_h264_decoder_update_max_num_reorder_frames (GstH264Decoder * self,
     max_num_reorder_frames = gst_h264_dpb_get_max_num_frames (priv->dpb);
   }
 
+  /* Without any hint, assuming the whole DPB may be used for reordering
+   * means up to 16 frames of latency. In low-latency modes the reorder depth
+   * is inferred from the stream instead, see
+   * gst_h264_decoder_observe_reorder() */
+  if (max_num_reorder_frames > 0 &&
+      get_bump_level (self) != GST_H264_DPB_BUMP_NORMAL_LATENCY &&
+      !gst_h264_dpb_get_interlaced (priv->dpb)) {
+    priv->infer_reorder = TRUE;
+    if (priv->reorder_known)
+      max_num_reorder_frames = priv->reorder_depth;
+  }
+
   gst_h264_dpb_set_max_num_reorder_frames (priv->dpb, max_num_reorder_frames);
 
   return TRUE;
@@ -2349,6 +2442,11 @@ gst_h264_decoder_set_latency (GstH264Decoder * self, const GstH264SPS * sps,
       break;
   }
 
+  /* The pictures are output as soon as the observed reordering allows */
+  if (bump_level != GST_H264_DPB_BUMP_NORMAL_LATENCY && priv->infer_reorder
+      && priv->reorder_known)
+    frames_delay = priv->reorder_depth;
+
   /* Consider output delay wanted by subclass */
   frames_delay += priv->preferred_output_delay;
 
@@ -2471,6 +2569,11 @@ gst_h264_decoder_process_sps (GstH264Decoder * self, GstH264SPS * sps)
     priv->width = sps->width;
     priv->height = sps->height;
 
+    priv->reorder_known = FALSE;
+    priv->reorder_depth = 0;
+    priv->reorder_observed = 0;
+    priv->n_recent_pocs = 0;
+
     gst_h264_decoder_set_latency (self, sps, max_dpb_size);
     gst_h264_dpb_set_max_num_frames (priv->dpb, max_dpb_size);
     gst_h264_dpb_set_interlaced (priv->dpb, interlaced);
@@ -2521,8 +2624,8 @@ gst_h264_decoder_decode_slice (GstH264Decoder * self)
 
   if (priv->process_ref_pic_lists) {
     if (!gst_h264_decoder_modify_ref_pic_lists (self)) {
-      ret = GST_FLOW_ERROR;
-      goto beach;
+      gst_h264_decoder_invalidate_slice_ref_pic_lists (self);
+      return GST_FLOW_ERROR;
     }
 
     ref_pic_list0 = priv->ref_pic_list0;
@@ -2539,10 +2642,6 @@ gst_h264_decoder_decode_slice (GstH264Decoder * self)
         picture, picture->frame_num, picture->pic_order_cnt);
   }
 
-beach:
-  g_array_set_size (priv->ref_pic_list0, 0);
-  g_array_set_size (priv->ref_pic_list1, 0);
-
   return ret;
 }
 
@@ -2999,6 +3098,8 @@ gst_h264_decoder_prepare_ref_pic_lists (GstH264Decoder * self,
   gint i;
   GArray *dpb_array = gst_h264_dpb_get_pictures_all (priv->dpb);
 
+  gst_h264_decoder_invalidate_slice_ref_pic_lists (self);
+
   /* 8.2.4.2.1 ~ 8.2.4.2.4
    * When this process is invoked, there shall be at least one reference entry
    * that is currently marked as "used for reference"
@@ -3028,6 +3129,16 @@ gst_h264_decoder_prepare_ref_pic_lists (GstH264Decoder * self,
   }
 }
 
+static void
+gst_h264_decoder_invalidate_slice_ref_pic_lists (GstH264Decoder * self)
+{
+  GstH264DecoderPrivate *priv = self->priv;
+
+  priv->ref_pic_lists_valid = FALSE;
+  g_array_set_size (priv->ref_pic_list0, 0);
+  g_array_set_size (priv->ref_pic_list1, 0);
+}
+
 static void
 gst_h264_decoder_clear_ref_pic_lists (GstH264Decoder * self)
 {
@@ -3036,6 +3147,8 @@ gst_h264_decoder_clear_ref_pic_lists (GstH264Decoder * self)
   g_array_set_size (priv->ref_pic_list_p0, 0);
   g_array_set_size (priv->ref_pic_list_b0, 0);
   g_array_set_size (priv->ref_pic_list_b1, 0);
+
+  gst_h264_decoder_invalidate_slice_ref_pic_lists (self);
 }
 
 static gint
@@ -3237,11 +3350,97 @@ copy_pic_list_into (GArray * dest, GArray * src)
     g_array_append_val (dest, g_array_index (src, gpointer, i));
 }
 
+static gboolean
+ref_pic_list_modifications_equal (guint8 flag_a, guint8 n_a,
+    const GstH264RefPicListModification * mod_a, guint8 flag_b, guint8 n_b,
+    const GstH264RefPicListModification * mod_b)
+{
+  guint i;
+
+  if (flag_a != flag_b)
+    return FALSE;
+
+  if (!flag_a)
+    return TRUE;
+
+  if (n_a != n_b)
+    return FALSE;
+
+  for (i = 0; i < n_a; i++) {
+    if (mod_a[i].modification_of_pic_nums_idc !=
+        mod_b[i].modification_of_pic_nums_idc ||
+        mod_a[i].value.abs_diff_pic_num_minus1 !=
+        mod_b[i].value.abs_diff_pic_num_minus1)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/* Whether the lists built for the previous slice of the current picture
+ * are exactly what @slice_hdr asks for. The initial lists only depend on
+ * the picture, so only the slice type, the number of active references
+ * and the modification commands have to be compared */
+static gboolean
+gst_h264_decoder_can_reuse_ref_pic_lists (GstH264Decoder * self,
+    const GstH264SliceHdr * slice_hdr)
+{
+  GstH264DecoderPrivate *priv = self->priv;
+  const GstH264SliceHdr *prev = &priv->ref_pic_lists_slice_hdr;
+
+  if (!priv->ref_pic_lists_valid)
+    return FALSE;
+
+  if (GST_H264_IS_B_SLICE (slice_hdr) != GST_H264_IS_B_SLICE (prev))
+    return FALSE;
+
+  if (slice_hdr->num_ref_idx_l0_active_minus1 !=
+      prev->num_ref_idx_l0_active_minus1)
+    return FALSE;
+
+  if (!ref_pic_list_modifications_equal
+      (slice_hdr->ref_pic_list_modification_flag_l0,
+          slice_hdr->n_ref_pic_list_modification_l0,
+          slice_hdr->ref_pic_list_modification_l0,
+          prev->ref_pic_list_modification_flag_l0,
+          prev->n_ref_pic_list_modification_l0,
+          prev->ref_pic_list_modification_l0))
+    return FALSE;
+
+  if (!GST_H264_IS_B_SLICE (slice_hdr))
+    return TRUE;
+
+  if (slice_hdr->num_ref_idx_l1_active_minus1 !=
+      prev->num_ref_idx_l1_active_minus1)
+    return FALSE;
+
+  return ref_pic_list_modifications_equal
+      (slice_hdr->ref_pic_list_modification_flag_l1,
+      slice_hdr->n_ref_pic_list_modification_l1,
+      slice_hdr->ref_pic_list_modification_l1,
+      prev->ref_pic_list_modification_flag_l1,
+      prev->n_ref_pic_list_modification_l1,
+      prev->ref_pic_list_modification_l1);
+}
+
 static gboolean
 gst_h264_decoder_modify_ref_pic_lists (GstH264Decoder * self)
 {
   GstH264DecoderPrivate *priv = self->priv;
   GstH264SliceHdr *slice_hdr = &priv->current_slice.header;
+  gboolean ret = TRUE;
+
+  if (!GST_H264_IS_P_SLICE (slice_hdr) && !GST_H264_IS_SP_SLICE (slice_hdr) &&
+      !GST_H264_IS_B_SLICE (slice_hdr)) {
+    /* No lists for I and SI slices */
+    gst_h264_decoder_invalidate_slice_ref_pic_lists (self);
+    return TRUE;
+  }
+
+  if (gst_h264_decoder_can_reuse_ref_pic_lists (self, slice_hdr)) {
+    GST_TRACE_OBJECT (self, "Reusing reference picture lists");
+    return TRUE;
+  }
 
   g_array_set_size (priv->ref_pic_list0, 0);
   g_array_set_size (priv->ref_pic_list1, 0);
@@ -3249,16 +3448,20 @@ gst_h264_decoder_modify_ref_pic_lists (GstH264Decoder * self)
   if (GST_H264_IS_P_SLICE (slice_hdr) || GST_H264_IS_SP_SLICE (slice_hdr)) {
     /* 8.2.4 fill reference picture list RefPicList0 for P or SP slice */
     copy_pic_list_into (priv->ref_pic_list0, priv->ref_pic_list_p0);
-    return modify_ref_pic_list (self, 0);
-  } else if (GST_H264_IS_B_SLICE (slice_hdr)) {
+    ret = modify_ref_pic_list (self, 0);
+  } else {
     /* 8.2.4 fill reference picture list RefPicList0 and RefPicList1 for B slice */
     copy_pic_list_into (priv->ref_pic_list0, priv->ref_pic_list_b0);
     copy_pic_list_into (priv->ref_pic_list1, priv->ref_pic_list_b1);
-    return modify_ref_pic_list (self, 0)
+    ret = modify_ref_pic_list (self, 0)
         && modify_ref_pic_list (self, 1);
   }
 
-  return TRUE;
+  priv->ref_pic_lists_valid = ret;
+  if (ret)
+    priv->ref_pic_lists_slice_hdr = *slice_hdr;
+
+  return ret;
 }
 
 /**
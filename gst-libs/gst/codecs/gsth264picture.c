@@ -109,6 +109,9 @@ gst_h264_picture_get_user_data (GstH264Picture * picture)
 struct _GstH264Dpb
 {
   GArray *pic_list;
+  /* Pictures of pic_list which can be output, sorted by picture order count.
+   * Doesn't hold references */
+  GArray *output_list;
   gint max_num_frames;
   gint num_output_needed;
   guint32 max_num_reorder_frames;
@@ -147,6 +150,10 @@ gst_h264_dpb_new (void)
   g_array_set_clear_func (dpb->pic_list,
       (GDestroyNotify) gst_clear_h264_picture);
 
+  dpb->output_list =
+      g_array_sized_new (FALSE, TRUE, sizeof (GstH264Picture *),
+      GST_H264_DPB_MAX_SIZE);
+
   return dpb;
 }
 
@@ -227,6 +234,7 @@ gst_h264_dpb_free (GstH264Dpb * dpb)
 
   gst_h264_dpb_clear (dpb);
   g_array_unref (dpb->pic_list);
+  g_array_unref (dpb->output_list);
   g_free (dpb);
 }
 
@@ -241,6 +249,7 @@ gst_h264_dpb_clear (GstH264Dpb * dpb)
 {
   g_return_if_fail (dpb != NULL);
 
+  g_array_set_size (dpb->output_list, 0);
   g_array_set_size (dpb->pic_list, 0);
   gst_h264_dpb_init (dpb);
 }
@@ -263,6 +272,70 @@ gst_h264_dpb_set_max_num_reorder_frames (GstH264Dpb * dpb,
   dpb->max_num_reorder_frames = max_num_reorder_frames;
 }
 
+/* A picture can be output once it is a frame or a complete field pair, in
+ * which case the first field represents the pair */
+static inline gboolean
+gst_h264_dpb_is_output_ready (GstH264Picture * picture)
+{
+  if (!picture->needed_for_output)
+    return FALSE;
+
+  return GST_H264_PICTURE_IS_FRAME (picture) ||
+      (picture->other_field && !picture->second_field);
+}
+
+static void
+gst_h264_dpb_add_output_ready (GstH264Dpb * dpb, GstH264Picture * picture)
+{
+  GstH264Picture **list = (GstH264Picture **) dpb->output_list->data;
+  guint low = 0, high = dpb->output_list->len;
+  guint i;
+
+  for (i = 0; i < dpb->output_list->len; i++) {
+    if (list[i] == picture)
+      return;
+  }
+
+  /* Insert after pictures with the same POC, so that those are still output
+   * in decoding order */
+  while (low < high) {
+    guint mid = low + (high - low) / 2;
+
+    if (list[mid]->pic_order_cnt <= picture->pic_order_cnt)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+
+  g_array_insert_val (dpb->output_list, low, picture);
+}
+
+static void
+gst_h264_dpb_remove_output_ready (GstH264Dpb * dpb, GstH264Picture * picture)
+{
+  guint i;
+
+  for (i = 0; i < dpb->output_list->len; i++) {
+    if (g_array_index (dpb->output_list, GstH264Picture *, i) == picture) {
+      g_array_remove_index (dpb->output_list, i);
+      return;
+    }
+  }
+}
+
+static gint
+gst_h264_dpb_get_index (GstH264Dpb * dpb, GstH264Picture * picture)
+{
+  gint i;
+
+  for (i = 0; i < dpb->pic_list->len; i++) {
+    if (g_array_index (dpb->pic_list, GstH264Picture *, i) == picture)
+      return i;
+  }
+
+  return -1;
+}
+
 /**
  * gst_h264_dpb_add:
  * @dpb: a #GstH264Dpb
@@ -302,6 +375,14 @@ gst_h264_dpb_add (GstH264Dpb * dpb, GstH264Picture * picture)
 
   g_array_append_val (dpb->pic_list, picture);
 
+  /* Either this picture or, when completing a field pair, the first field
+   * may have become ready for output */
+  if (gst_h264_dpb_is_output_ready (picture))
+    gst_h264_dpb_add_output_ready (dpb, picture);
+  else if (picture->other_field &&
+      gst_h264_dpb_is_output_ready (picture->other_field))
+    gst_h264_dpb_add_output_ready (dpb, picture->other_field);
+
   if (dpb->pic_list->len > dpb->max_num_frames * (dpb->interlaced + 1))
     GST_ERROR ("DPB size is %d, exceed the max size %d",
         dpb->pic_list->len, dpb->max_num_frames * (dpb->interlaced + 1));
@@ -658,43 +739,14 @@ gst_h264_dpb_has_empty_frame_buffer (GstH264Dpb * dpb)
   return FALSE;
 }
 
-static gint
-gst_h264_dpb_get_lowest_output_needed_picture (GstH264Dpb * dpb,
-    GstH264Picture ** picture)
+/* Returns: (transfer none) (nullable) */
+static GstH264Picture *
+gst_h264_dpb_get_lowest_output_needed_picture (GstH264Dpb * dpb)
 {
-  gint i;
-  GstH264Picture *lowest = NULL;
-  gint index = -1;
-
-  *picture = NULL;
-
-  for (i = 0; i < dpb->pic_list->len; i++) {
-    GstH264Picture *picture =
-        g_array_index (dpb->pic_list, GstH264Picture *, i);
-
-    if (!picture->needed_for_output)
-      continue;
-
-    if (!GST_H264_PICTURE_IS_FRAME (picture) &&
-        (!picture->other_field || picture->second_field))
-      continue;
-
-    if (!lowest) {
-      lowest = picture;
-      index = i;
-      continue;
-    }
-
-    if (picture->pic_order_cnt < lowest->pic_order_cnt) {
-      lowest = picture;
-      index = i;
-    }
-  }
-
-  if (lowest)
-    *picture = gst_h264_picture_ref (lowest);
+  if (dpb->output_list->len == 0)
+    return NULL;
 
-  return index;
+  return g_array_index (dpb->output_list, GstH264Picture *, 0);
 }
 
 /**
@@ -711,7 +763,7 @@ gboolean
 gst_h264_dpb_needs_bump (GstH264Dpb * dpb, GstH264Picture * to_insert,
     GstH264DpbBumpMode latency_mode)
 {
-  GstH264Picture *picture = NULL;
+  GstH264Picture *picture;
   gint32 lowest_poc;
   gboolean is_ref_picture;
   gint lowest_index;
@@ -721,11 +773,10 @@ gst_h264_dpb_needs_bump (GstH264Dpb * dpb, GstH264Picture * to_insert,
 
   lowest_poc = G_MAXINT32;
   is_ref_picture = FALSE;
-  lowest_index = gst_h264_dpb_get_lowest_output_needed_picture (dpb, &picture);
-  if (lowest_index >= 0) {
+  picture = gst_h264_dpb_get_lowest_output_needed_picture (dpb);
+  if (picture) {
     lowest_poc = picture->pic_order_cnt;
     is_ref_picture = picture->ref_pic;
-    gst_h264_picture_unref (picture);
   } else {
     goto normal_bump;
   }
@@ -756,6 +807,7 @@ gst_h264_dpb_needs_bump (GstH264Dpb * dpb, GstH264Picture * to_insert,
     /* num_reorder_frames indicates the maximum number of frames, that
        precede any frame in the coded video sequence in decoding order
        and follow it in output order. Safe. */
+    lowest_index = gst_h264_dpb_get_index (dpb, picture);
     if (lowest_index >= dpb->max_num_reorder_frames) {
       guint i, need_output;
 
@@ -885,16 +937,17 @@ gst_h264_dpb_bump (GstH264Dpb * dpb, gboolean drain)
 {
   GstH264Picture *picture;
   GstH264Picture *other_picture;
-  gint i;
   gint index;
 
   g_return_val_if_fail (dpb != NULL, NULL);
 
-  index = gst_h264_dpb_get_lowest_output_needed_picture (dpb, &picture);
-
-  if (!picture || index < 0)
+  picture = gst_h264_dpb_get_lowest_output_needed_picture (dpb);
+  if (!picture)
     return NULL;
 
+  gst_h264_picture_ref (picture);
+  g_array_remove_index (dpb->output_list, 0);
+
   picture->needed_for_output = FALSE;
 
   dpb->num_output_needed--;
@@ -902,12 +955,16 @@ gst_h264_dpb_bump (GstH264Dpb * dpb, gboolean drain)
 
   /* NOTE: don't use g_array_remove_index_fast here since the last picture
    * need to be referenced for bumping decision */
-  if (!GST_H264_PICTURE_IS_REF (picture) || drain)
+  if (!GST_H264_PICTURE_IS_REF (picture) || drain) {
+    index = gst_h264_dpb_get_index (dpb, picture);
+    g_assert (index >= 0);
     g_array_remove_index (dpb->pic_list, index);
+  }
 
   other_picture = picture->other_field;
   if (other_picture) {
     other_picture->needed_for_output = FALSE;
+    gst_h264_dpb_remove_output_ready (dpb, other_picture);
 
     /* At this moment, this picture should be interlaced */
     picture->buffer_flags |= GST_VIDEO_BUFFER_FLAG_INTERLACED;
@@ -918,15 +975,9 @@ gst_h264_dpb_bump (GstH264Dpb * dpb, gboolean drain)
       picture->buffer_flags |= GST_VIDEO_BUFFER_FLAG_TFF;
 
     if (!other_picture->ref) {
-      for (i = 0; i < dpb->pic_list->len; i++) {
-        GstH264Picture *tmp =
-            g_array_index (dpb->pic_list, GstH264Picture *, i);
-
-        if (tmp == other_picture) {
-          g_array_remove_index (dpb->pic_list, i);
-          break;
-        }
-      }
+      index = gst_h264_dpb_get_index (dpb, other_picture);
+      if (index >= 0)
+        g_array_remove_index (dpb->pic_list, index);
     }
     /* Now other field may or may not exist */
   }
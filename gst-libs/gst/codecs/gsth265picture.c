@@ -110,6 +110,9 @@ gst_h265_picture_get_user_data (GstH265Picture * picture)
 struct _GstH265Dpb
 {
   GArray *pic_list;
+  /* Pictures of pic_list needed for output, sorted by picture order count.
+   * Doesn't hold references */
+  GArray *output_list;
   gint max_num_pics;
   gint num_output_needed;
 };
@@ -134,6 +137,10 @@ gst_h265_dpb_new (void)
   g_array_set_clear_func (dpb->pic_list,
       (GDestroyNotify) gst_clear_h265_picture);
 
+  dpb->output_list =
+      g_array_sized_new (FALSE, TRUE, sizeof (GstH265Picture *),
+      GST_H265_DPB_MAX_SIZE);
+
   return dpb;
 }
 
@@ -179,6 +186,7 @@ gst_h265_dpb_free (GstH265Dpb * dpb)
 
   gst_h265_dpb_clear (dpb);
   g_array_unref (dpb->pic_list);
+  g_array_unref (dpb->output_list);
   g_free (dpb);
 }
 
@@ -193,6 +201,7 @@ gst_h265_dpb_clear (GstH265Dpb * dpb)
 {
   g_return_if_fail (dpb != NULL);
 
+  g_array_set_size (dpb->output_list, 0);
   g_array_set_size (dpb->pic_list, 0);
   dpb->num_output_needed = 0;
 }
@@ -212,16 +221,26 @@ gst_h265_dpb_add (GstH265Dpb * dpb, GstH265Picture * picture)
   g_return_if_fail (GST_IS_H265_PICTURE (picture));
 
   if (picture->output_flag) {
-    gint i;
-
-    for (i = 0; i < dpb->pic_list->len; i++) {
-      GstH265Picture *other =
-          g_array_index (dpb->pic_list, GstH265Picture *, i);
-
-      if (other->needed_for_output)
-        other->pic_latency_cnt++;
+    GstH265Picture **list = (GstH265Picture **) dpb->output_list->data;
+    guint low = 0, high = dpb->output_list->len;
+    guint i;
+
+    for (i = 0; i < dpb->output_list->len; i++)
+      list[i]->pic_latency_cnt++;
+
+    /* Insert after pictures with the same POC, so that those are still
+     * output in decoding order */
+    while (low < high) {
+      guint mid = low + (high - low) / 2;
+
+      if (list[mid]->pic_order_cnt <= picture->pic_order_cnt)
+        low = mid + 1;
+      else
+        high = mid;
     }
 
+    g_array_insert_val (dpb->output_list, low, picture);
+
     dpb->num_output_needed++;
     picture->needed_for_output = TRUE;
   } else {
@@ -488,12 +507,9 @@ gst_h265_dpb_check_latency_count (GstH265Dpb * dpb, guint32 max_latency)
 {
   gint i;
 
-  for (i = 0; i < dpb->pic_list->len; i++) {
+  for (i = 0; i < dpb->output_list->len; i++) {
     GstH265Picture *picture =
-        g_array_index (dpb->pic_list, GstH265Picture *, i);
-
-    if (!picture->needed_for_output)
-      continue;
+        g_array_index (dpb->output_list, GstH265Picture *, i);
 
     if (picture->pic_latency_cnt >= max_latency)
       return TRUE;
@@ -555,39 +571,14 @@ gst_h265_dpb_needs_bump (GstH265Dpb * dpb, guint max_num_reorder_pics,
   return FALSE;
 }
 
-static gint
-gst_h265_dpb_get_lowest_output_needed_picture (GstH265Dpb * dpb,
-    GstH265Picture ** picture)
+/* Returns: (transfer none) (nullable) */
+static GstH265Picture *
+gst_h265_dpb_get_lowest_output_needed_picture (GstH265Dpb * dpb)
 {
-  gint i;
-  GstH265Picture *lowest = NULL;
-  gint index = -1;
-
-  *picture = NULL;
-
-  for (i = 0; i < dpb->pic_list->len; i++) {
-    GstH265Picture *picture =
-        g_array_index (dpb->pic_list, GstH265Picture *, i);
-
-    if (!picture->needed_for_output)
-      continue;
-
-    if (!lowest) {
-      lowest = picture;
-      index = i;
-      continue;
-    }
-
-    if (picture->pic_order_cnt < lowest->pic_order_cnt) {
-      lowest = picture;
-      index = i;
-    }
-  }
-
-  if (lowest)
-    *picture = gst_h265_picture_ref (lowest);
+  if (dpb->output_list->len == 0)
+    return NULL;
 
-  return index;
+  return g_array_index (dpb->output_list, GstH265Picture *, 0);
 }
 
 /**
@@ -608,23 +599,31 @@ GstH265Picture *
 gst_h265_dpb_bump (GstH265Dpb * dpb, gboolean drain)
 {
   GstH265Picture *picture;
-  gint index;
+  gint i;
 
   g_return_val_if_fail (dpb != NULL, NULL);
 
   /* C.5.2.4 "Bumping" process */
-  index = gst_h265_dpb_get_lowest_output_needed_picture (dpb, &picture);
-
-  if (!picture || index < 0)
+  picture = gst_h265_dpb_get_lowest_output_needed_picture (dpb);
+  if (!picture)
     return NULL;
 
+  gst_h265_picture_ref (picture);
+  g_array_remove_index (dpb->output_list, 0);
+
   picture->needed_for_output = FALSE;
 
   dpb->num_output_needed--;
   g_assert (dpb->num_output_needed >= 0);
 
-  if (!picture->ref || drain)
-    g_array_remove_index_fast (dpb->pic_list, index);
+  if (!picture->ref || drain) {
+    for (i = 0; i < dpb->pic_list->len; i++) {
+      if (g_array_index (dpb->pic_list, GstH265Picture *, i) == picture) {
+        g_array_remove_index_fast (dpb->pic_list, i);
+        break;
+      }
+    }
+  }
 
   return picture;
 }
@@ -1272,7 +1272,9 @@ gst_mpeg2_decoder_handle_frame (GstVideoDecoder * decoder,
     if (last_one)
       break;
 
-    offset = packet.offset;
+    /* The next start code was already located to compute the packet size,
+     * don't scan the payload of this packet again */
+    offset = packet.offset + packet.size;
   }
 
   gst_buffer_unmap (in_buf, &map_info);
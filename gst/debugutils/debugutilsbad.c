@@ -40,6 +40,7 @@ plugin_init (GstPlugin * plugin)
   ret |= GST_ELEMENT_REGISTER (fakeaudiosink, plugin);
   ret |= GST_ELEMENT_REGISTER (fakevideosink, plugin);
   ret |= GST_ELEMENT_REGISTER (fpsdisplaysink, plugin);
+  ret |= GST_ELEMENT_REGISTER (latencymeter, plugin);
   ret |= GST_ELEMENT_REGISTER (testsrcbin, plugin);
   ret |= GST_ELEMENT_REGISTER (videocodectestsink, plugin);
   ret |= GST_ELEMENT_REGISTER (watchdog, plugin);
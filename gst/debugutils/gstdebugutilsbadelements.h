@@ -36,6 +36,7 @@ GST_ELEMENT_REGISTER_DECLARE (errorignore);
 GST_ELEMENT_REGISTER_DECLARE (fakeaudiosink);
 GST_ELEMENT_REGISTER_DECLARE (fakevideosink);
 GST_ELEMENT_REGISTER_DECLARE (fpsdisplaysink);
+GST_ELEMENT_REGISTER_DECLARE (latencymeter);
 GST_ELEMENT_REGISTER_DECLARE (testsrcbin);
 GST_ELEMENT_REGISTER_DECLARE (videocodectestsink);
 GST_ELEMENT_REGISTER_DECLARE (watchdog);
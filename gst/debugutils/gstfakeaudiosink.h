@@ -25,6 +25,8 @@
 
 #include <gst/gst.h>
 
+#include "gstfakesinkutils.h"
+
 #define GST_TYPE_FAKE_AUDIO_SINK \
   (gst_fake_audio_sink_get_type())
 #define GST_FAKE_AUDIO_SINK(obj) \
@@ -48,6 +50,7 @@ struct _GstFakeAudioSink
     GstBin parent;
     GstElement *child;
     GstPad *sinkpad;
+    GstFakeSinkBenchmark benchmark;
     gdouble volume;
     gboolean mute;
 };
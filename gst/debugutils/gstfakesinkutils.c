@@ -105,3 +105,136 @@ gst_util_proxy_class_properties (GObjectClass * object_class,
 
   g_free (properties);
 }
+
+static void
+gst_fake_sink_benchmark_reset (GstFakeSinkBenchmark * benchmark)
+{
+  benchmark->buffers = 0;
+  benchmark->bytes = 0;
+  benchmark->unpooled_buffers = 0;
+  benchmark->allocation_queries = 0;
+  benchmark->first_arrival = GST_CLOCK_TIME_NONE;
+  benchmark->last_arrival = GST_CLOCK_TIME_NONE;
+  benchmark->last_interval = GST_CLOCK_TIME_NONE;
+  benchmark->max_interval = 0;
+  benchmark->jitter = 0;
+}
+
+static gboolean
+gst_fake_sink_benchmark_add_buffer (GstBuffer ** buffer, guint idx,
+    gpointer user_data)
+{
+  GstFakeSinkBenchmark *benchmark = user_data;
+  GstClockTime now = gst_util_get_timestamp ();
+
+  if (benchmark->buffers == 0) {
+    benchmark->first_arrival = now;
+  } else {
+    GstClockTime interval = now - benchmark->last_arrival;
+
+    /* running estimate of the inter-arrival jitter, as in RFC 3550 */
+    if (GST_CLOCK_TIME_IS_VALID (benchmark->last_interval)) {
+      GstClockTime diff = (interval > benchmark->last_interval) ?
+          interval - benchmark->last_interval :
+          benchmark->last_interval - interval;
+
+      if (diff > benchmark->jitter)
+        benchmark->jitter += (diff - benchmark->jitter) / 16;
+      else
+        benchmark->jitter -= (benchmark->jitter - diff) / 16;
+    }
+
+    benchmark->last_interval = interval;
+    benchmark->max_interval = MAX (benchmark->max_interval, interval);
+  }
+
+  benchmark->last_arrival = now;
+  benchmark->buffers++;
+  benchmark->bytes += gst_buffer_get_size (*buffer);
+  if ((*buffer)->pool == NULL)
+    benchmark->unpooled_buffers++;
+
+  return TRUE;
+}
+
+static void
+gst_fake_sink_benchmark_post (GstFakeSinkBenchmark * benchmark,
+    GstElement * element)
+{
+  GstStructure *s;
+  GstClockTime duration = 0;
+  gdouble buffers_per_second = 0, bytes_per_second = 0;
+
+  if (benchmark->buffers > 1)
+    duration = benchmark->last_arrival - benchmark->first_arrival;
+
+  if (duration > 0) {
+    buffers_per_second =
+        (gdouble) (benchmark->buffers - 1) * GST_SECOND / duration;
+    bytes_per_second = (gdouble) benchmark->bytes * GST_SECOND / duration;
+  }
+
+  s = gst_structure_new ("benchmark",
+      "buffers", G_TYPE_UINT64, benchmark->buffers,
+      "bytes", G_TYPE_UINT64, benchmark->bytes,
+      "duration", G_TYPE_UINT64, duration,
+      "buffers-per-second", G_TYPE_DOUBLE, buffers_per_second,
+      "bytes-per-second", G_TYPE_DOUBLE, bytes_per_second,
+      "jitter", G_TYPE_UINT64, benchmark->jitter,
+      "max-interval", G_TYPE_UINT64, benchmark->max_interval,
+      "allocation-queries", G_TYPE_UINT64, benchmark->allocation_queries,
+      "unpooled-buffers", G_TYPE_UINT64, benchmark->unpooled_buffers, NULL);
+
+  gst_element_post_message (element,
+      gst_message_new_element (GST_OBJECT (element), s));
+}
+
+static GstPadProbeReturn
+gst_fake_sink_benchmark_probe (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  GstFakeSinkBenchmark *benchmark = user_data;
+
+  if (!g_atomic_int_get (&benchmark->enabled))
+    return GST_PAD_PROBE_OK;
+
+  if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_BUFFER) {
+    gst_fake_sink_benchmark_add_buffer (&GST_PAD_PROBE_INFO_BUFFER (info), 0,
+        benchmark);
+  } else if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_BUFFER_LIST) {
+    gst_buffer_list_foreach (GST_PAD_PROBE_INFO_BUFFER_LIST (info),
+        gst_fake_sink_benchmark_add_buffer, benchmark);
+  } else if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_QUERY_BOTH) {
+    if (GST_QUERY_TYPE (GST_PAD_PROBE_INFO_QUERY (info)) ==
+        GST_QUERY_ALLOCATION)
+      benchmark->allocation_queries++;
+  } else if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_EVENT_BOTH) {
+    switch (GST_EVENT_TYPE (GST_PAD_PROBE_INFO_EVENT (info))) {
+      case GST_EVENT_STREAM_START:
+        gst_fake_sink_benchmark_reset (benchmark);
+        break;
+      case GST_EVENT_EOS:
+        gst_fake_sink_benchmark_post (benchmark, GST_PAD_PARENT (pad));
+        gst_fake_sink_benchmark_reset (benchmark);
+        break;
+      default:
+        break;
+    }
+  }
+
+  return GST_PAD_PROBE_OK;
+}
+
+/* Collects the statistics of the data arriving at @pad, a sink pad of the
+ * fake sink, and posts them as an element message on EOS */
+void
+gst_fake_sink_benchmark_init (GstFakeSinkBenchmark * benchmark, GstPad * pad)
+{
+  benchmark->enabled = FALSE;
+  gst_fake_sink_benchmark_reset (benchmark);
+
+  gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER |
+      GST_PAD_PROBE_TYPE_BUFFER_LIST | GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM |
+      GST_PAD_PROBE_TYPE_QUERY_DOWNSTREAM | GST_PAD_PROBE_TYPE_PUSH,
+      gst_fake_sink_benchmark_probe, benchmark, NULL);
+}
@@ -26,11 +26,34 @@
 
 G_BEGIN_DECLS
 
+typedef struct _GstFakeSinkBenchmark GstFakeSinkBenchmark;
+
+/* Throughput statistics of the fake sinks' benchmark mode */
+struct _GstFakeSinkBenchmark
+{
+  gint enabled;
+
+  guint64 buffers;
+  guint64 bytes;
+  guint64 unpooled_buffers;
+  guint64 allocation_queries;
+
+  GstClockTime first_arrival;
+  GstClockTime last_arrival;
+  GstClockTime last_interval;
+  GstClockTime max_interval;
+  GstClockTime jitter;
+};
+
 void
 gst_util_proxy_class_properties (GObjectClass *object_class,
                                  GObjectClass *target_class,
                                  guint property_id_offset);
 
+void
+gst_fake_sink_benchmark_init (GstFakeSinkBenchmark *benchmark,
+                              GstPad *pad);
+
 G_END_DECLS
 
 #endif
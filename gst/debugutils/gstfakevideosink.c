@@ -90,6 +90,7 @@ typedef enum
 #define DEFAULT_CAN_ACTIVATE_PUSH TRUE
 #define DEFAULT_CAN_ACTIVATE_PULL FALSE
 #define DEFAULT_NUM_BUFFERS -1
+#define DEFAULT_BENCHMARK FALSE
 
 /**
  * GstFakeVideoSinkStateError:
@@ -142,6 +143,7 @@ enum
   PROP_CAN_ACTIVATE_PUSH,
   PROP_CAN_ACTIVATE_PULL,
   PROP_NUM_BUFFERS,
+  PROP_BENCHMARK,
   PROP_LAST
 };
 
@@ -255,6 +257,8 @@ gst_fake_video_sink_init (GstFakeVideoSink * self)
     gst_element_add_pad (GST_ELEMENT (self), ghost_pad);
     gst_object_unref (sink_pad);
 
+    gst_fake_sink_benchmark_init (&self->benchmark, ghost_pad);
+
     gst_pad_set_query_function (ghost_pad, gst_fake_video_sink_query);
 
     self->child = child;
@@ -283,6 +287,10 @@ gst_fake_video_sink_get_property (GObject * object, guint property_id,
       g_value_set_flags (value, self->allocation_meta_flags);
       GST_OBJECT_UNLOCK (self);
       break;
+    case PROP_BENCHMARK:
+      g_value_set_boolean (value,
+          g_atomic_int_get (&self->benchmark.enabled));
+      break;
     default:
       g_object_get_property (G_OBJECT (self->child), pspec->name, value);
       break;
@@ -301,6 +309,10 @@ gst_fake_video_sink_set_property (GObject * object, guint property_id,
       self->allocation_meta_flags = g_value_get_flags (value);
       GST_OBJECT_UNLOCK (self);
       break;
+    case PROP_BENCHMARK:
+      g_atomic_int_set (&self->benchmark.enabled,
+          g_value_get_boolean (value));
+      break;
     default:
       g_object_set_property (G_OBJECT (self->child), pspec->name, value);
       break;
@@ -410,6 +422,23 @@ gst_fake_video_sink_class_init (GstFakeVideoSinkClass * klass)
           "Number of buffers to accept going EOS", -1, G_MAXINT,
           DEFAULT_NUM_BUFFERS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstFakeVideoSink:benchmark
+   *
+   * Measure the throughput of the incoming stream. When enabled, an element
+   * message named "benchmark" is posted on EOS with the number of buffers
+   * and bytes received, the buffer and byte rates, the inter-arrival jitter
+   * and largest inter-arrival interval (both in nanoseconds), the number of
+   * ALLOCATION queries and the number of buffers that did not come from a
+   * buffer pool. Usually combined with sync=false.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (object_class, PROP_BENCHMARK,
+      g_param_spec_boolean ("benchmark", "Benchmark",
+          "Post throughput statistics on EOS", DEFAULT_BENCHMARK,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   base_sink_class = g_type_class_ref (GST_TYPE_BASE_SINK);
   gst_util_proxy_class_properties (object_class, base_sink_class, PROP_LAST);
   g_type_class_unref (base_sink_class);
@@ -24,6 +24,8 @@
 
 #include <gst/gst.h>
 
+#include "gstfakesinkutils.h"
+
 /**
  * GstFakeVideoSinkAllocationMetaFlags:
  * @GST_ALLOCATION_FLAG_CROP_META: Expose the crop meta as supported
@@ -66,6 +68,7 @@ struct _GstFakeVideoSink
     GstElement *child;
     GstFakeVideoSinkAllocationMetaFlags allocation_meta_flags;
     GstPad *sinkpad;
+    GstFakeSinkBenchmark benchmark;
 };
 
 struct _GstFakeVideoSinkClass
@@ -0,0 +1,447 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Suite 500,
+ * Boston, MA 02110-1335, USA.
+ */
+/**
+ * SECTION:element-latencymeter
+ * @title: latencymeter
+ *
+ * The latencymeter element measures how long buffers take to travel
+ * through a segment of a pipeline. Two instances with the same
+ * #GstLatencyMeter:channel are used: one in #GstLatencyMeter:mode entry
+ * at the start of the segment, which attaches a #GstReferenceTimestampMeta
+ * with the current monotonic time to each buffer, and one in
+ * #GstLatencyMeter:mode exit at the end of the segment, which reads the
+ * meta back and records the difference in a log-linear histogram with a
+ * precision of about 6%.
+ *
+ * Every #GstLatencyMeter:interval and on EOS, the exit element posts an
+ * element message named "latencymeter" with the statistics of the interval
+ * and resets the histogram. The message contains the following fields:
+ *
+ * * `channel` (string): the channel of the element
+ * * `count` (guint64): number of measured buffers
+ * * `min`, `max`, `mean` (guint64): latency in nanoseconds
+ * * `p50`, `p90`, `p99`, `p999` (guint64): latency percentiles in
+ *   nanoseconds
+ *
+ * Buffers only get measured if the elements of the segment keep their
+ * metas. When #GstLatencyMeter:enabled is %FALSE, both elements are in
+ * passthrough and do not touch the buffers.
+ *
+ * ## Example launch line
+ * |[
+ * gst-launch-1.0 -m videotestsrc ! latencymeter mode=entry ! x264enc ! \
+ *     avdec_h264 ! latencymeter mode=exit ! fakesink
+ * ]|
+ *
+ * Since: 1.24
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+
+#include <gst/gst.h>
+#include <gst/base/gstbasetransform.h>
+#include "gstdebugutilsbadelements.h"
+#include "gstlatencymeter.h"
+
+GST_DEBUG_CATEGORY_STATIC (gst_latency_meter_debug_category);
+#define GST_CAT_DEFAULT gst_latency_meter_debug_category
+
+#define SUB_BUCKET_BITS GST_LATENCY_METER_SUB_BUCKET_BITS
+#define SUB_BUCKET_MASK ((1 << SUB_BUCKET_BITS) - 1)
+
+/* prototypes */
+
+static void gst_latency_meter_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec);
+static void gst_latency_meter_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec);
+static void gst_latency_meter_finalize (GObject * object);
+
+static gboolean gst_latency_meter_start (GstBaseTransform * trans);
+static gboolean gst_latency_meter_sink_event (GstBaseTransform * trans,
+    GstEvent * event);
+static GstFlowReturn gst_latency_meter_transform_ip (GstBaseTransform * trans,
+    GstBuffer * buf);
+
+enum
+{
+  PROP_0,
+  PROP_MODE,
+  PROP_CHANNEL,
+  PROP_INTERVAL,
+  PROP_ENABLED
+};
+
+#define DEFAULT_MODE GST_LATENCY_METER_MODE_ENTRY
+#define DEFAULT_CHANNEL "default"
+#define DEFAULT_INTERVAL GST_SECOND
+#define DEFAULT_ENABLED TRUE
+
+GType
+gst_latency_meter_mode_get_type (void)
+{
+  static GType mode_type = 0;
+
+  static const GEnumValue mode_types[] = {
+    {GST_LATENCY_METER_MODE_ENTRY, "Stamp buffers", "entry"},
+    {GST_LATENCY_METER_MODE_EXIT, "Measure latency of buffers", "exit"},
+    {0, NULL, NULL}
+  };
+
+  if (!mode_type) {
+    mode_type = g_enum_register_static ("GstLatencyMeterMode", mode_types);
+  }
+  return mode_type;
+}
+
+/* class initialization */
+
+G_DEFINE_TYPE_WITH_CODE (GstLatencyMeter, gst_latency_meter,
+    GST_TYPE_BASE_TRANSFORM,
+    GST_DEBUG_CATEGORY_INIT (gst_latency_meter_debug_category, "latencymeter",
+        0, "debug category for latencymeter element"));
+GST_ELEMENT_REGISTER_DEFINE (latencymeter, "latencymeter", GST_RANK_NONE,
+    gst_latency_meter_get_type ());
+
+static void
+gst_latency_meter_class_init (GstLatencyMeterClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstBaseTransformClass *base_transform_class =
+      GST_BASE_TRANSFORM_CLASS (klass);
+
+  gst_element_class_add_pad_template (GST_ELEMENT_CLASS (klass),
+      gst_pad_template_new ("src", GST_PAD_SRC, GST_PAD_ALWAYS,
+          gst_caps_new_any ()));
+  gst_element_class_add_pad_template (GST_ELEMENT_CLASS (klass),
+      gst_pad_template_new ("sink", GST_PAD_SINK, GST_PAD_ALWAYS,
+          gst_caps_new_any ()));
+
+  gst_element_class_set_static_metadata (GST_ELEMENT_CLASS (klass),
+      "Latency meter", "Generic",
+      "Measures the latency of buffers between two points of a pipeline",
+      "GStreamer maintainers <gstreamer-devel@lists.freedesktop.org>");
+
+  gobject_class->set_property = gst_latency_meter_set_property;
+  gobject_class->get_property = gst_latency_meter_get_property;
+  gobject_class->finalize = gst_latency_meter_finalize;
+  base_transform_class->start = GST_DEBUG_FUNCPTR (gst_latency_meter_start);
+  base_transform_class->sink_event =
+      GST_DEBUG_FUNCPTR (gst_latency_meter_sink_event);
+  base_transform_class->transform_ip =
+      GST_DEBUG_FUNCPTR (gst_latency_meter_transform_ip);
+
+  g_object_class_install_property (gobject_class, PROP_MODE,
+      g_param_spec_enum ("mode", "Mode",
+          "Whether to stamp buffers or to measure their latency",
+          GST_TYPE_LATENCY_METER_MODE, DEFAULT_MODE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_CHANNEL,
+      g_param_spec_string ("channel", "Channel",
+          "Name shared by the entry and exit elements of a measurement",
+          DEFAULT_CHANNEL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_INTERVAL,
+      g_param_spec_uint64 ("interval", "Interval",
+          "Interval (in ns) between statistics messages, 0 to only post "
+          "them on EOS", 0, G_MAXUINT64, DEFAULT_INTERVAL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_ENABLED,
+      g_param_spec_boolean ("enabled", "Enabled",
+          "Whether to stamp and measure buffers", DEFAULT_ENABLED,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  gst_type_mark_as_plugin_api (GST_TYPE_LATENCY_METER_MODE, 0);
+}
+
+static void
+gst_latency_meter_init (GstLatencyMeter * latency_meter)
+{
+  latency_meter->mode = DEFAULT_MODE;
+  latency_meter->channel = g_strdup (DEFAULT_CHANNEL);
+  latency_meter->interval = DEFAULT_INTERVAL;
+  latency_meter->enabled = DEFAULT_ENABLED;
+}
+
+static void
+gst_latency_meter_finalize (GObject * object)
+{
+  GstLatencyMeter *latency_meter = GST_LATENCY_METER (object);
+
+  g_free (latency_meter->channel);
+  gst_clear_caps (&latency_meter->reference);
+
+  G_OBJECT_CLASS (gst_latency_meter_parent_class)->finalize (object);
+}
+
+static void
+gst_latency_meter_update_passthrough (GstLatencyMeter * latency_meter)
+{
+  /* only stamping modifies buffers, measuring just reads the meta */
+  gst_base_transform_set_passthrough (GST_BASE_TRANSFORM (latency_meter),
+      latency_meter->mode == GST_LATENCY_METER_MODE_EXIT
+      || !g_atomic_int_get (&latency_meter->enabled));
+}
+
+static void
+gst_latency_meter_set_property (GObject * object, guint property_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstLatencyMeter *latency_meter = GST_LATENCY_METER (object);
+
+  GST_DEBUG_OBJECT (latency_meter, "set_property");
+
+  switch (property_id) {
+    case PROP_MODE:
+      GST_OBJECT_LOCK (latency_meter);
+      latency_meter->mode = g_value_get_enum (value);
+      GST_OBJECT_UNLOCK (latency_meter);
+      gst_latency_meter_update_passthrough (latency_meter);
+      break;
+    case PROP_CHANNEL:
+      GST_OBJECT_LOCK (latency_meter);
+      g_free (latency_meter->channel);
+      latency_meter->channel = g_value_dup_string (value);
+      if (latency_meter->channel == NULL)
+        latency_meter->channel = g_strdup (DEFAULT_CHANNEL);
+      GST_OBJECT_UNLOCK (latency_meter);
+      break;
+    case PROP_INTERVAL:
+      GST_OBJECT_LOCK (latency_meter);
+      latency_meter->interval = g_value_get_uint64 (value);
+      GST_OBJECT_UNLOCK (latency_meter);
+      break;
+    case PROP_ENABLED:
+      g_atomic_int_set (&latency_meter->enabled, g_value_get_boolean (value));
+      gst_latency_meter_update_passthrough (latency_meter);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_latency_meter_get_property (GObject * object, guint property_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstLatencyMeter *latency_meter = GST_LATENCY_METER (object);
+
+  GST_DEBUG_OBJECT (latency_meter, "get_property");
+
+  switch (property_id) {
+    case PROP_MODE:
+      GST_OBJECT_LOCK (latency_meter);
+      g_value_set_enum (value, latency_meter->mode);
+      GST_OBJECT_UNLOCK (latency_meter);
+      break;
+    case PROP_CHANNEL:
+      GST_OBJECT_LOCK (latency_meter);
+      g_value_set_string (value, latency_meter->channel);
+      GST_OBJECT_UNLOCK (latency_meter);
+      break;
+    case PROP_INTERVAL:
+      GST_OBJECT_LOCK (latency_meter);
+      g_value_set_uint64 (value, latency_meter->interval);
+      GST_OBJECT_UNLOCK (latency_meter);
+      break;
+    case PROP_ENABLED:
+      g_value_set_boolean (value, g_atomic_int_get (&latency_meter->enabled));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_latency_meter_reset (GstLatencyMeter * latency_meter)
+{
+  memset (latency_meter->buckets, 0, sizeof (latency_meter->buckets));
+  latency_meter->count = 0;
+  latency_meter->sum = 0;
+  latency_meter->min = GST_CLOCK_TIME_NONE;
+  latency_meter->max = 0;
+}
+
+static gboolean
+gst_latency_meter_start (GstBaseTransform * trans)
+{
+  GstLatencyMeter *latency_meter = GST_LATENCY_METER (trans);
+
+  GST_OBJECT_LOCK (latency_meter);
+  gst_clear_caps (&latency_meter->reference);
+  latency_meter->reference =
+      gst_caps_new_simple ("timestamp/x-latencymeter", "channel",
+      G_TYPE_STRING, latency_meter->channel, NULL);
+  GST_OBJECT_UNLOCK (latency_meter);
+
+  gst_latency_meter_reset (latency_meter);
+  latency_meter->last_report = GST_CLOCK_TIME_NONE;
+
+  return TRUE;
+}
+
+static guint
+gst_latency_meter_bucket_index (guint64 value)
+{
+  guint msb;
+
+  if (value <= SUB_BUCKET_MASK)
+    return value;
+
+  if (value >> 32)
+    msb = g_bit_storage ((guint32) (value >> 32)) + 31;
+  else
+    msb = g_bit_storage ((guint32) value) - 1;
+
+  return ((msb - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) +
+      ((value >> (msb - SUB_BUCKET_BITS)) & SUB_BUCKET_MASK);
+}
+
+/* highest value that falls into the bucket @index */
+static guint64
+gst_latency_meter_bucket_value (guint index)
+{
+  guint shift;
+
+  if (index <= SUB_BUCKET_MASK)
+    return index;
+
+  shift = (index >> SUB_BUCKET_BITS) - 1;
+
+  return ((((guint64) 1 << SUB_BUCKET_BITS) + (index & SUB_BUCKET_MASK))
+      << shift) + (((guint64) 1 << shift) - 1);
+}
+
+static GstClockTime
+gst_latency_meter_percentile (GstLatencyMeter * latency_meter,
+    guint64 per_mille)
+{
+  guint64 target, seen = 0;
+  guint i;
+
+  target = gst_util_uint64_scale_ceil (latency_meter->count, per_mille, 1000);
+  target = MAX (target, 1);
+
+  for (i = 0; i < GST_LATENCY_METER_NUM_BUCKETS; i++) {
+    seen += latency_meter->buckets[i];
+    if (seen >= target)
+      return MIN (gst_latency_meter_bucket_value (i), latency_meter->max);
+  }
+
+  return latency_meter->max;
+}
+
+static void
+gst_latency_meter_post_report (GstLatencyMeter * latency_meter)
+{
+  GstStructure *s;
+
+  if (latency_meter->count == 0)
+    return;
+
+  s = gst_structure_new ("latencymeter",
+      "channel", G_TYPE_STRING, latency_meter->channel,
+      "count", G_TYPE_UINT64, latency_meter->count,
+      "min", G_TYPE_UINT64, latency_meter->min,
+      "max", G_TYPE_UINT64, latency_meter->max,
+      "mean", G_TYPE_UINT64, latency_meter->sum / latency_meter->count,
+      "p50", G_TYPE_UINT64, gst_latency_meter_percentile (latency_meter, 500),
+      "p90", G_TYPE_UINT64, gst_latency_meter_percentile (latency_meter, 900),
+      "p99", G_TYPE_UINT64, gst_latency_meter_percentile (latency_meter, 990),
+      "p999", G_TYPE_UINT64, gst_latency_meter_percentile (latency_meter, 999),
+      NULL);
+
+  GST_DEBUG_OBJECT (latency_meter, "posting statistics %" GST_PTR_FORMAT, s);
+
+  gst_element_post_message (GST_ELEMENT (latency_meter),
+      gst_message_new_element (GST_OBJECT (latency_meter), s));
+
+  gst_latency_meter_reset (latency_meter);
+}
+
+static gboolean
+gst_latency_meter_sink_event (GstBaseTransform * trans, GstEvent * event)
+{
+  GstLatencyMeter *latency_meter = GST_LATENCY_METER (trans);
+
+  if (GST_EVENT_TYPE (event) == GST_EVENT_EOS
+      && latency_meter->mode == GST_LATENCY_METER_MODE_EXIT)
+    gst_latency_meter_post_report (latency_meter);
+
+  return
+      GST_BASE_TRANSFORM_CLASS (gst_latency_meter_parent_class)->sink_event
+      (trans, event);
+}
+
+static GstFlowReturn
+gst_latency_meter_transform_ip (GstBaseTransform * trans, GstBuffer * buf)
+{
+  GstLatencyMeter *latency_meter = GST_LATENCY_METER (trans);
+  GstReferenceTimestampMeta *meta;
+  GstClockTime now, latency, interval;
+
+  if (!g_atomic_int_get (&latency_meter->enabled))
+    return GST_FLOW_OK;
+
+  now = gst_util_get_timestamp ();
+
+  if (latency_meter->mode == GST_LATENCY_METER_MODE_ENTRY) {
+    gst_buffer_add_reference_timestamp_meta (buf, latency_meter->reference,
+        now, GST_CLOCK_TIME_NONE);
+    return GST_FLOW_OK;
+  }
+
+  meta = gst_buffer_get_reference_timestamp_meta (buf,
+      latency_meter->reference);
+  if (meta != NULL && now >= meta->timestamp) {
+    latency = now - meta->timestamp;
+
+    latency_meter->buckets[gst_latency_meter_bucket_index (latency)]++;
+    latency_meter->count++;
+    latency_meter->sum += latency;
+    if (latency_meter->min == GST_CLOCK_TIME_NONE
+        || latency < latency_meter->min)
+      latency_meter->min = latency;
+    if (latency > latency_meter->max)
+      latency_meter->max = latency;
+  }
+
+  if (latency_meter->last_report == GST_CLOCK_TIME_NONE)
+    latency_meter->last_report = now;
+
+  GST_OBJECT_LOCK (latency_meter);
+  interval = latency_meter->interval;
+  GST_OBJECT_UNLOCK (latency_meter);
+
+  if (interval > 0 && now - latency_meter->last_report >= interval) {
+    gst_latency_meter_post_report (latency_meter);
+    latency_meter->last_report = now;
+  }
+
+  return GST_FLOW_OK;
+}
@@ -0,0 +1,88 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Suite 500,
+ * Boston, MA 02110-1335, USA.
+ */
+
+#ifndef _GST_LATENCY_METER_H_
+#define _GST_LATENCY_METER_H_
+
+#include <gst/base/gstbasetransform.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_LATENCY_METER   (gst_latency_meter_get_type())
+#define GST_LATENCY_METER(obj)   (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_LATENCY_METER,GstLatencyMeter))
+#define GST_LATENCY_METER_CLASS(klass)   (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_LATENCY_METER,GstLatencyMeterClass))
+#define GST_IS_LATENCY_METER(obj)   (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_LATENCY_METER))
+#define GST_IS_LATENCY_METER_CLASS(obj)   (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_LATENCY_METER))
+
+#define GST_TYPE_LATENCY_METER_MODE (gst_latency_meter_mode_get_type())
+
+typedef struct _GstLatencyMeter GstLatencyMeter;
+typedef struct _GstLatencyMeterClass GstLatencyMeterClass;
+
+/**
+ * GstLatencyMeterMode:
+ * @GST_LATENCY_METER_MODE_ENTRY: Stamp buffers entering the measured segment
+ * @GST_LATENCY_METER_MODE_EXIT: Measure latency of buffers leaving the
+ *     measured segment
+ *
+ * Since: 1.24
+ */
+typedef enum
+{
+  GST_LATENCY_METER_MODE_ENTRY,
+  GST_LATENCY_METER_MODE_EXIT,
+} GstLatencyMeterMode;
+
+/* Log-linear histogram: values below 2^SUB_BUCKET_BITS get one bucket each,
+ * every power of two above is split in 2^SUB_BUCKET_BITS linear buckets */
+#define GST_LATENCY_METER_SUB_BUCKET_BITS 4
+#define GST_LATENCY_METER_NUM_BUCKETS \
+    ((64 - GST_LATENCY_METER_SUB_BUCKET_BITS + 1) << GST_LATENCY_METER_SUB_BUCKET_BITS)
+
+struct _GstLatencyMeter
+{
+  GstBaseTransform base_latency_meter;
+
+  /* properties */
+  GstLatencyMeterMode mode;
+  gchar *channel;
+  GstClockTime interval;
+  gint enabled;
+
+  GstCaps *reference;
+
+  /* histogram of the current interval, only used in exit mode */
+  guint64 buckets[GST_LATENCY_METER_NUM_BUCKETS];
+  guint64 count;
+  GstClockTime sum;
+  GstClockTime min;
+  GstClockTime max;
+  GstClockTime last_report;
+};
+
+struct _GstLatencyMeterClass
+{
+  GstBaseTransformClass base_latency_meter_class;
+};
+
+GType gst_latency_meter_get_type (void);
+GType gst_latency_meter_mode_get_type (void);
+
+G_END_DECLS
+
+#endif
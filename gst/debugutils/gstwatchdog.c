@@ -33,6 +33,19 @@
  * This element is currently intended for transcoding pipelines,
  * although may be useful in other contexts.
  *
+ * To watch the streams of a pipeline separately, one watchdog is inserted
+ * per stream. With #GstWatchdog:degradation-factor set, the watchdog also
+ * tracks the average interval between buffers and posts a
+ * "watchdog-degraded" element message when no buffer arrived for that many
+ * average intervals, before the hard #GstWatchdog:timeout is reached. With
+ * #GstWatchdog:action set to message, a "watchdog-stalled" element message
+ * is posted on timeout instead of an error, so the application can recover
+ * the affected branch without tearing down the whole pipeline. Once buffers
+ * flow again after either message, a "watchdog-recovered" element message
+ * is posted. All these messages carry the average buffer interval as
+ * "expected-interval" and the time since the last buffer as "elapsed", both
+ * in nanoseconds.
+ *
  * ## Example launch line
  * |[
  * gst-launch-1.0 -v fakesrc ! watchdog ! fakesink
@@ -69,6 +82,8 @@ static GstFlowReturn gst_watchdog_transform_ip (GstBaseTransform * trans,
     GstBuffer * buf);
 static void gst_watchdog_feed (GstWatchdog * watchdog, gpointer mini_object,
     gboolean force);
+static void gst_watchdog_schedule_degraded (GstWatchdog * watchdog);
+static void gst_watchdog_clear_sources (GstWatchdog * watchdog);
 
 static GstStateChangeReturn
 gst_watchdog_change_state (GstElement * element, GstStateChange transition);
@@ -76,9 +91,35 @@ gst_watchdog_change_state (GstElement * element, GstStateChange transition);
 enum
 {
   PROP_0,
-  PROP_TIMEOUT
+  PROP_TIMEOUT,
+  PROP_DEGRADATION_FACTOR,
+  PROP_ACTION
 };
 
+#define DEFAULT_DEGRADATION_FACTOR 0.0
+#define DEFAULT_ACTION GST_WATCHDOG_ACTION_ERROR
+
+GType
+gst_watchdog_action_get_type (void)
+{
+  static GType action_type = 0;
+  static const GEnumValue action_types[] = {
+    {GST_WATCHDOG_ACTION_ERROR, "Post an element error", "error"},
+    {GST_WATCHDOG_ACTION_MESSAGE, "Post an element message", "message"},
+    {0, NULL, NULL}
+  };
+
+  if (g_once_init_enter ((gsize *) & action_type)) {
+    GType _type;
+
+    _type = g_enum_register_static ("GstWatchdogAction", action_types);
+
+    g_once_init_leave ((gsize *) & action_type, _type);
+  }
+
+  return action_type;
+}
+
 /* class initialization */
 
 G_DEFINE_TYPE_WITH_CODE (GstWatchdog, gst_watchdog, GST_TYPE_BASE_TRANSFORM,
@@ -125,11 +166,44 @@ gst_watchdog_class_init (GstWatchdogClass * klass)
           "received. 0 means disabled.", 0, G_MAXINT, 1000,
           G_PARAM_CONSTRUCT | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstWatchdog:degradation-factor:
+   *
+   * Post a "watchdog-degraded" element message when no buffer arrived for
+   * this many average buffer intervals. 0 disables rate tracking.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_DEGRADATION_FACTOR,
+      g_param_spec_double ("degradation-factor", "Degradation factor",
+          "Number of average buffer intervals without a buffer after which "
+          "the stream is reported as degraded. 0 means disabled.", 0,
+          G_MAXDOUBLE, DEFAULT_DEGRADATION_FACTOR,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstWatchdog:action:
+   *
+   * What to do when the timeout is reached.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_ACTION,
+      g_param_spec_enum ("action", "Action",
+          "What to do when no buffer arrived within the timeout",
+          GST_TYPE_WATCHDOG_ACTION, DEFAULT_ACTION,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  gst_type_mark_as_plugin_api (GST_TYPE_WATCHDOG_ACTION, 0);
 }
 
 static void
 gst_watchdog_init (GstWatchdog * watchdog)
 {
+  watchdog->degradation_factor = DEFAULT_DEGRADATION_FACTOR;
+  watchdog->action = DEFAULT_ACTION;
+  watchdog->last_buffer_time = GST_CLOCK_TIME_NONE;
+  watchdog->average_interval = GST_CLOCK_TIME_NONE;
 }
 
 static void
@@ -147,6 +221,17 @@ gst_watchdog_set_property (GObject * object, guint property_id,
       gst_watchdog_feed (watchdog, NULL, FALSE);
       GST_OBJECT_UNLOCK (watchdog);
       break;
+    case PROP_DEGRADATION_FACTOR:
+      GST_OBJECT_LOCK (watchdog);
+      watchdog->degradation_factor = g_value_get_double (value);
+      gst_watchdog_schedule_degraded (watchdog);
+      GST_OBJECT_UNLOCK (watchdog);
+      break;
+    case PROP_ACTION:
+      GST_OBJECT_LOCK (watchdog);
+      watchdog->action = g_value_get_enum (value);
+      GST_OBJECT_UNLOCK (watchdog);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -165,6 +250,16 @@ gst_watchdog_get_property (GObject * object, guint property_id,
     case PROP_TIMEOUT:
       g_value_set_int (value, watchdog->timeout);
       break;
+    case PROP_DEGRADATION_FACTOR:
+      GST_OBJECT_LOCK (watchdog);
+      g_value_set_double (value, watchdog->degradation_factor);
+      GST_OBJECT_UNLOCK (watchdog);
+      break;
+    case PROP_ACTION:
+      GST_OBJECT_LOCK (watchdog);
+      g_value_set_enum (value, watchdog->action);
+      GST_OBJECT_UNLOCK (watchdog);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -185,15 +280,74 @@ gst_watchdog_thread (gpointer user_data)
   return NULL;
 }
 
+static void
+gst_watchdog_post_message (GstWatchdog * watchdog, const gchar * name,
+    GstClockTime expected_interval, GstClockTime elapsed)
+{
+  GstStructure *s;
+
+  s = gst_structure_new (name,
+      "expected-interval", G_TYPE_UINT64, expected_interval,
+      "elapsed", G_TYPE_UINT64, elapsed, NULL);
+
+  gst_element_post_message (GST_ELEMENT (watchdog),
+      gst_message_new_element (GST_OBJECT (watchdog), s));
+}
+
+/*  Call with OBJECT_LOCK taken */
+static GstClockTime
+gst_watchdog_get_elapsed (GstWatchdog * watchdog)
+{
+  if (!GST_CLOCK_TIME_IS_VALID (watchdog->last_buffer_time))
+    return GST_CLOCK_TIME_NONE;
+
+  return gst_util_get_timestamp () - watchdog->last_buffer_time;
+}
+
 static gboolean
 gst_watchdog_trigger (gpointer ptr)
 {
   GstWatchdog *watchdog = GST_WATCHDOG (ptr);
+  GstClockTime expected_interval, elapsed;
+  GstWatchdogAction action;
 
   GST_DEBUG_OBJECT (watchdog, "watchdog triggered");
 
-  GST_ELEMENT_ERROR (watchdog, STREAM, FAILED, ("Watchdog triggered"),
-      ("Watchdog triggered"));
+  GST_OBJECT_LOCK (watchdog);
+  action = watchdog->action;
+  expected_interval = watchdog->average_interval;
+  elapsed = gst_watchdog_get_elapsed (watchdog);
+  if (action == GST_WATCHDOG_ACTION_MESSAGE)
+    watchdog->stalled = TRUE;
+  GST_OBJECT_UNLOCK (watchdog);
+
+  if (action == GST_WATCHDOG_ACTION_MESSAGE) {
+    gst_watchdog_post_message (watchdog, "watchdog-stalled",
+        expected_interval, elapsed);
+  } else {
+    GST_ELEMENT_ERROR (watchdog, STREAM, FAILED, ("Watchdog triggered"),
+        ("Watchdog triggered"));
+  }
+
+  return FALSE;
+}
+
+static gboolean
+gst_watchdog_degraded (gpointer ptr)
+{
+  GstWatchdog *watchdog = GST_WATCHDOG (ptr);
+  GstClockTime expected_interval, elapsed;
+
+  GST_DEBUG_OBJECT (watchdog, "buffer rate degraded");
+
+  GST_OBJECT_LOCK (watchdog);
+  watchdog->degraded = TRUE;
+  expected_interval = watchdog->average_interval;
+  elapsed = gst_watchdog_get_elapsed (watchdog);
+  GST_OBJECT_UNLOCK (watchdog);
+
+  gst_watchdog_post_message (watchdog, "watchdog-degraded", expected_interval,
+      elapsed);
 
   return FALSE;
 }
@@ -262,6 +416,60 @@ gst_watchdog_feed (GstWatchdog * watchdog, gpointer mini_object, gboolean force)
   }
 }
 
+/*  Call with OBJECT_LOCK taken */
+static void
+gst_watchdog_schedule_degraded (GstWatchdog * watchdog)
+{
+  gdouble delay;
+  guint delay_ms;
+
+  if (watchdog->degraded_source) {
+    g_source_destroy (watchdog->degraded_source);
+    g_source_unref (watchdog->degraded_source);
+    watchdog->degraded_source = NULL;
+  }
+
+  if (watchdog->degradation_factor <= 0
+      || !GST_CLOCK_TIME_IS_VALID (watchdog->average_interval)
+      || watchdog->main_context == NULL
+      || GST_STATE (watchdog) != GST_STATE_PLAYING)
+    return;
+
+  /* in milliseconds, clamped as a large factor would not fit the timeout */
+  delay = watchdog->average_interval * watchdog->degradation_factor /
+      GST_MSECOND;
+  if (delay >= G_MAXUINT)
+    delay_ms = G_MAXUINT;
+  else
+    delay_ms = MAX (1, (guint) delay + ((guint) delay < delay));
+
+  /* the stream would be reported as stalled first */
+  if (watchdog->timeout > 0 && delay_ms >= (guint) watchdog->timeout)
+    return;
+
+  watchdog->degraded_source = g_timeout_source_new (delay_ms);
+  g_source_set_callback (watchdog->degraded_source, gst_watchdog_degraded,
+      gst_object_ref (watchdog), gst_object_unref);
+  g_source_attach (watchdog->degraded_source, watchdog->main_context);
+}
+
+/*  Call with OBJECT_LOCK taken */
+static void
+gst_watchdog_clear_sources (GstWatchdog * watchdog)
+{
+  if (watchdog->source) {
+    g_source_destroy (watchdog->source);
+    g_source_unref (watchdog->source);
+    watchdog->source = NULL;
+  }
+
+  if (watchdog->degraded_source) {
+    g_source_destroy (watchdog->degraded_source);
+    g_source_unref (watchdog->degraded_source);
+    watchdog->degraded_source = NULL;
+  }
+}
+
 static gboolean
 gst_watchdog_start (GstBaseTransform * trans)
 {
@@ -287,11 +495,7 @@ gst_watchdog_stop (GstBaseTransform * trans)
   GST_DEBUG_OBJECT (watchdog, "stop");
   GST_OBJECT_LOCK (watchdog);
 
-  if (watchdog->source) {
-    g_source_destroy (watchdog->source);
-    g_source_unref (watchdog->source);
-    watchdog->source = NULL;
-  }
+  gst_watchdog_clear_sources (watchdog);
 
   /* dispatch an idle event that trigger g_main_loop_quit to avoid race
    * between g_main_loop_run and g_main_loop_quit */
@@ -322,6 +526,9 @@ gst_watchdog_sink_event (GstBaseTransform * trans, GstEvent * event)
   GST_DEBUG_OBJECT (watchdog, "sink_event");
 
   GST_OBJECT_LOCK (watchdog);
+  /* intervals across a flush are not part of the buffer rate */
+  if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_STOP)
+    watchdog->last_buffer_time = GST_CLOCK_TIME_NONE;
   gst_watchdog_feed (watchdog, event, FALSE);
   GST_OBJECT_UNLOCK (watchdog);
 
@@ -362,13 +569,40 @@ static GstFlowReturn
 gst_watchdog_transform_ip (GstBaseTransform * trans, GstBuffer * buf)
 {
   GstWatchdog *watchdog = GST_WATCHDOG (trans);
+  GstClockTime now, expected_interval = GST_CLOCK_TIME_NONE, elapsed = 0;
+  gboolean recovered;
 
   GST_DEBUG_OBJECT (watchdog, "transform_ip");
 
+  now = gst_util_get_timestamp ();
+
   GST_OBJECT_LOCK (watchdog);
+  if (GST_CLOCK_TIME_IS_VALID (watchdog->last_buffer_time)) {
+    elapsed = now - watchdog->last_buffer_time;
+
+    /* moving average over roughly the last 8 intervals */
+    if (GST_CLOCK_TIME_IS_VALID (watchdog->average_interval))
+      watchdog->average_interval =
+          (watchdog->average_interval * 7 + elapsed) / 8;
+    else
+      watchdog->average_interval = elapsed;
+  }
+  watchdog->last_buffer_time = now;
+
+  recovered = watchdog->degraded || watchdog->stalled;
+  if (recovered)
+    expected_interval = watchdog->average_interval;
+  watchdog->degraded = FALSE;
+  watchdog->stalled = FALSE;
+
   gst_watchdog_feed (watchdog, buf, FALSE);
+  gst_watchdog_schedule_degraded (watchdog);
   GST_OBJECT_UNLOCK (watchdog);
 
+  if (recovered)
+    gst_watchdog_post_message (watchdog, "watchdog-recovered",
+        expected_interval, elapsed);
+
   return GST_FLOW_OK;
 }
 
@@ -401,18 +635,19 @@ gst_watchdog_change_state (GstElement * element, GstStateChange transition)
   switch (transition) {
     case GST_STATE_CHANGE_READY_TO_PAUSED:
       GST_OBJECT_LOCK (watchdog);
+      watchdog->last_buffer_time = GST_CLOCK_TIME_NONE;
+      watchdog->average_interval = GST_CLOCK_TIME_NONE;
+      watchdog->degraded = FALSE;
+      watchdog->stalled = FALSE;
       watchdog->waiting_for_a_buffer = TRUE;
       gst_watchdog_feed (watchdog, NULL, TRUE);
       GST_OBJECT_UNLOCK (watchdog);
       break;
     case GST_STATE_CHANGE_PLAYING_TO_PAUSED:
-      /* Disable the timer */
+      /* Disable the timers, the pause is not part of the buffer rate */
       GST_OBJECT_LOCK (watchdog);
-      if (watchdog->source) {
-        g_source_destroy (watchdog->source);
-        g_source_unref (watchdog->source);
-        watchdog->source = NULL;
-      }
+      gst_watchdog_clear_sources (watchdog);
+      watchdog->last_buffer_time = GST_CLOCK_TIME_NONE;
       GST_OBJECT_UNLOCK (watchdog);
       break;
     default:
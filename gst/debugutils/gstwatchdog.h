@@ -31,6 +31,24 @@ G_BEGIN_DECLS
 #define GST_IS_WATCHDOG(obj)   (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_WATCHDOG))
 #define GST_IS_WATCHDOG_CLASS(obj)   (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_WATCHDOG))
 
+#define GST_TYPE_WATCHDOG_ACTION (gst_watchdog_action_get_type())
+
+/**
+ * GstWatchdogAction:
+ * @GST_WATCHDOG_ACTION_ERROR: Post an element error
+ * @GST_WATCHDOG_ACTION_MESSAGE: Post a "watchdog-stalled" element message and
+ *     keep waiting for the stream to recover
+ *
+ * What to do when no buffer arrived within the timeout.
+ *
+ * Since: 1.24
+ */
+typedef enum
+{
+  GST_WATCHDOG_ACTION_ERROR,
+  GST_WATCHDOG_ACTION_MESSAGE,
+} GstWatchdogAction;
+
 typedef struct _GstWatchdog GstWatchdog;
 typedef struct _GstWatchdogClass GstWatchdogClass;
 
@@ -40,15 +58,24 @@ struct _GstWatchdog
 
   /* properties */
   int timeout;
+  gdouble degradation_factor;
+  GstWatchdogAction action;
 
   GMainContext *main_context;
   GMainLoop *main_loop;
   GThread *thread;
   GSource *source;
+  GSource *degraded_source;
 
   gboolean waiting_for_a_buffer;
   gboolean waiting_for_flush_start;
   gboolean waiting_for_flush_stop;
+
+  /* buffer rate tracking */
+  GstClockTime last_buffer_time;
+  GstClockTime average_interval;
+  gboolean degraded;
+  gboolean stalled;
 };
 
 struct _GstWatchdogClass
@@ -57,6 +84,7 @@ struct _GstWatchdogClass
 };
 
 GType gst_watchdog_get_type (void);
+GType gst_watchdog_action_get_type (void);
 
 G_END_DECLS
 
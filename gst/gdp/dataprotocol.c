@@ -508,14 +508,39 @@ gst_dp_buffer_from_header (guint header_length, const guint8 * header,
       gst_buffer_new_allocate (allocator,
       (guint) GST_DP_HEADER_PAYLOAD_LENGTH (header), allocation_params);
 
+  gst_dp_buffer_set_header_fields (header_length, header, buffer);
+
+  return buffer;
+}
+
+/**
+ * gst_dp_buffer_set_header_fields:
+ * @header_length: the length of the packet header
+ * @header: the byte array of the packet header
+ * @buffer: a writable #GstBuffer
+ *
+ * Sets the timestamps, offsets and flags of @buffer from the given header.
+ * This allows using a buffer that already contains the payload, e.g. one
+ * taken out of an adapter, instead of copying the payload into a buffer
+ * created with gst_dp_buffer_from_header().
+ *
+ * This function does not check the header passed to it, use
+ * gst_dp_validate_header() first if the header data is unchecked.
+ */
+void
+gst_dp_buffer_set_header_fields (guint header_length, const guint8 * header,
+    GstBuffer * buffer)
+{
+  g_return_if_fail (header != NULL);
+  g_return_if_fail (header_length >= GST_DP_HEADER_LENGTH);
+  g_return_if_fail (gst_buffer_is_writable (buffer));
+
   GST_BUFFER_TIMESTAMP (buffer) = GST_DP_HEADER_TIMESTAMP (header);
   GST_BUFFER_DTS (buffer) = GST_DP_HEADER_DTS (header);
   GST_BUFFER_DURATION (buffer) = GST_DP_HEADER_DURATION (header);
   GST_BUFFER_OFFSET (buffer) = GST_DP_HEADER_OFFSET (header);
   GST_BUFFER_OFFSET_END (buffer) = GST_DP_HEADER_OFFSET_END (header);
   GST_BUFFER_FLAGS (buffer) = GST_DP_HEADER_BUFFER_FLAGS (header);
-
-  return buffer;
 }
 
 /**
@@ -39,6 +39,7 @@
 #include <string.h>
 
 #include "dataprotocol.h"
+#include "dp-private.h"
 
 #include "gstgdpelements.h"
 #include "gstgdpdepay.h"
@@ -262,6 +263,17 @@ gst_gdp_depay_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
   return res;
 }
 
+/* Whether buffers can use the memory of the input buffers, which is the case
+ * when downstream did not ask for a specific allocator or memory layout */
+static gboolean
+gst_gdp_depay_can_share_payload (GstGDPDepay * this)
+{
+  return this->allocator == NULL && this->allocation_params.flags == 0 &&
+      this->allocation_params.align == 0 &&
+      this->allocation_params.prefix == 0 &&
+      this->allocation_params.padding == 0;
+}
+
 static GstFlowReturn
 gst_gdp_depay_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
 {
@@ -343,7 +355,11 @@ gst_gdp_depay_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
           goto wrong_type;
         }
 
-        if (this->payload_length) {
+        /* only map the payload when there is a CRC to check, mapping would
+         * merge a payload that spans several input buffers */
+        if (this->payload_length &&
+            (GST_DP_HEADER_FLAGS (this->header) &
+                GST_DP_HEADER_FLAG_CRC_PAYLOAD)) {
           const guint8 *data;
           gboolean res;
 
@@ -365,21 +381,36 @@ gst_gdp_depay_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
           goto no_caps;
 
         GST_LOG_OBJECT (this, "reading GDP buffer from adapter");
-        buf =
-            gst_dp_buffer_from_header (GST_DP_HEADER_LENGTH, this->header,
-            this->allocator, &this->allocation_params);
-        if (!buf)
-          goto buffer_failed;
-
-        /* now take the payload if there is any */
-        if (this->payload_length > 0) {
-          GstMapInfo map;
-
-          gst_buffer_map (buf, &map, GST_MAP_WRITE);
-          gst_adapter_copy (this->adapter, map.data, 0, this->payload_length);
-          gst_buffer_unmap (buf, &map);
-
-          gst_adapter_flush (this->adapter, this->payload_length);
+        if (this->payload_length > 0
+            && gst_gdp_depay_can_share_payload (this)) {
+          /* downstream has no allocation requirements, so the payload can be
+           * handed out without copying as long as it is contained in the
+           * input buffers */
+          buf = gst_adapter_take_buffer_fast (this->adapter,
+              this->payload_length);
+          if (!buf)
+            goto buffer_failed;
+          buf = gst_buffer_make_writable (buf);
+          gst_dp_buffer_set_header_fields (GST_DP_HEADER_LENGTH, this->header,
+              buf);
+        } else {
+          buf =
+              gst_dp_buffer_from_header (GST_DP_HEADER_LENGTH, this->header,
+              this->allocator, &this->allocation_params);
+          if (!buf)
+            goto buffer_failed;
+
+          /* now take the payload if there is any */
+          if (this->payload_length > 0) {
+            GstMapInfo map;
+
+            gst_buffer_map (buf, &map, GST_MAP_WRITE);
+            gst_adapter_copy (this->adapter, map.data, 0,
+                this->payload_length);
+            gst_buffer_unmap (buf, &map);
+
+            gst_adapter_flush (this->adapter, this->payload_length);
+          }
         }
 
         if (GST_BUFFER_TIMESTAMP (buf) > -this->ts_offset)
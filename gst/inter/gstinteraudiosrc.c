@@ -289,6 +289,8 @@ gst_inter_audio_src_start (GstBaseSrc * src)
   interaudiosrc->surface->audio_buffer_time = interaudiosrc->buffer_time;
   interaudiosrc->surface->audio_latency_time = interaudiosrc->latency_time;
   interaudiosrc->surface->audio_period_time = interaudiosrc->period_time;
+  interaudiosrc->audio_reader =
+      gst_inter_surface_add_audio_reader (interaudiosrc->surface);
   g_mutex_unlock (&interaudiosrc->surface->mutex);
 
   return TRUE;
@@ -301,6 +303,12 @@ gst_inter_audio_src_stop (GstBaseSrc * src)
 
   GST_DEBUG_OBJECT (interaudiosrc, "stop");
 
+  g_mutex_lock (&interaudiosrc->surface->mutex);
+  gst_inter_surface_remove_audio_reader (interaudiosrc->surface,
+      interaudiosrc->audio_reader);
+  interaudiosrc->audio_reader = NULL;
+  g_mutex_unlock (&interaudiosrc->surface->mutex);
+
   gst_inter_surface_unref (interaudiosrc->surface);
   interaudiosrc->surface = NULL;
 
@@ -366,14 +374,15 @@ gst_inter_audio_src_create (GstBaseSrc * src, guint64 offset, guint size,
       gst_util_uint64_scale (period_time, interaudiosrc->info.rate, GST_SECOND);
 
   if (bpf > 0)
-    n = gst_adapter_available (interaudiosrc->surface->audio_adapter) / bpf;
+    n = gst_adapter_available (interaudiosrc->audio_reader) / bpf;
   else
     n = 0;
 
   if (n > period_samples)
     n = period_samples;
   if (n > 0) {
-    buffer = gst_adapter_take_buffer (interaudiosrc->surface->audio_adapter,
+    /* avoid merging the queued buffers, the memories can be used as is */
+    buffer = gst_adapter_take_buffer_fast (interaudiosrc->audio_reader,
         n * bpf);
   } else {
     buffer = gst_buffer_new ();
@@ -81,8 +81,104 @@ gst_inter_surface_unref (GstInterSurface * surface)
     gst_buffer_replace (&surface->video_buffer, NULL);
     gst_buffer_replace (&surface->sub_buffer, NULL);
     gst_object_unref (surface->audio_adapter);
+    g_list_free_full (surface->audio_readers, gst_object_unref);
     g_free (surface->name);
     g_free (surface);
   }
   g_mutex_unlock (&mutex);
 }
+
+/* Every audio reader gets its own adapter holding references to the same
+ * buffers, so several sources can read a channel without stealing samples
+ * from each other. The first reader takes over the audio that was queued
+ * before any reader was registered. */
+GstAdapter *
+gst_inter_surface_add_audio_reader (GstInterSurface * surface)
+{
+  GstAdapter *reader = gst_adapter_new ();
+
+  if (surface->audio_readers == NULL) {
+    gsize n = gst_adapter_available (surface->audio_adapter);
+
+    if (n > 0) {
+      GstBufferList *list =
+          gst_adapter_take_buffer_list (surface->audio_adapter, n);
+      guint i, len = gst_buffer_list_length (list);
+
+      for (i = 0; i < len; i++)
+        gst_adapter_push (reader,
+            gst_buffer_ref (gst_buffer_list_get (list, i)));
+      gst_buffer_list_unref (list);
+    }
+  }
+
+  surface->audio_readers = g_list_prepend (surface->audio_readers, reader);
+
+  return gst_object_ref (reader);
+}
+
+/* Releases the reference returned by gst_inter_surface_add_audio_reader() */
+void
+gst_inter_surface_remove_audio_reader (GstInterSurface * surface,
+    GstAdapter * reader)
+{
+  GList *l = g_list_find (surface->audio_readers, reader);
+
+  if (l) {
+    surface->audio_readers = g_list_delete_link (surface->audio_readers, l);
+    gst_object_unref (reader);
+  }
+  gst_object_unref (reader);
+}
+
+/* Takes ownership of @buffer */
+void
+gst_inter_surface_push_audio (GstInterSurface * surface, GstBuffer * buffer)
+{
+  GList *l;
+
+  if (surface->audio_readers == NULL) {
+    gst_adapter_push (surface->audio_adapter, buffer);
+    return;
+  }
+
+  for (l = surface->audio_readers; l; l = l->next)
+    gst_adapter_push (l->data, gst_buffer_ref (buffer));
+  gst_buffer_unref (buffer);
+}
+
+void
+gst_inter_surface_clear_audio (GstInterSurface * surface)
+{
+  GList *l;
+
+  gst_adapter_clear (surface->audio_adapter);
+  for (l = surface->audio_readers; l; l = l->next)
+    gst_adapter_clear (l->data);
+}
+
+static void
+trim_adapter (GstAdapter * adapter, gsize max_size, gsize period_size)
+{
+  gsize n = gst_adapter_available (adapter);
+
+  while (n > max_size) {
+    gst_adapter_flush (adapter, MIN (period_size, n));
+    n -= MIN (period_size, n);
+  }
+}
+
+/* Drops audio in periods until at most @max_size bytes are queued for every
+ * reader */
+void
+gst_inter_surface_trim_audio (GstInterSurface * surface, gsize max_size,
+    gsize period_size)
+{
+  GList *l;
+
+  g_return_if_fail (period_size > 0);
+
+  trim_adapter (surface->audio_adapter, max_size, period_size);
+  for (l = surface->audio_readers; l; l = l->next)
+    trim_adapter (l->data, max_size, period_size);
+}
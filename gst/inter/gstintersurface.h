@@ -37,7 +37,9 @@ struct _GstInterSurface
 
   /* video */
   GstVideoInfo video_info;
-  int video_buffer_count;
+  /* incremented for every new video_buffer, readers keep track of the
+   * last one they have seen */
+  guint64 video_buffer_seqnum;
 
   /* audio */
   GstAudioInfo audio_info;
@@ -47,7 +49,10 @@ struct _GstInterSurface
 
   GstBuffer *video_buffer;
   GstBuffer *sub_buffer;
+  /* holds audio while no reader is registered */
   GstAdapter *audio_adapter;
+  /* one GstAdapter per audio reader */
+  GList *audio_readers;
 };
 
 #define DEFAULT_AUDIO_BUFFER_TIME  (GST_SECOND)
@@ -58,6 +63,16 @@ struct _GstInterSurface
 GstInterSurface * gst_inter_surface_get (const char *name);
 void gst_inter_surface_unref (GstInterSurface *surface);
 
+/* with the surface mutex held */
+GstAdapter * gst_inter_surface_add_audio_reader (GstInterSurface *surface);
+void gst_inter_surface_remove_audio_reader (GstInterSurface *surface,
+    GstAdapter *reader);
+void gst_inter_surface_push_audio (GstInterSurface *surface,
+    GstBuffer *buffer);
+void gst_inter_surface_clear_audio (GstInterSurface *surface);
+void gst_inter_surface_trim_audio (GstInterSurface *surface, gsize max_size,
+    gsize period_size);
+
 
 G_END_DECLS
 
@@ -46,6 +46,9 @@ struct _GstInterVideoSrc
 
   GstVideoInfo info;
   GstBuffer *black_frame;
+  /* last surface buffer seen by this source and how often it was output */
+  guint64 video_buffer_seqnum;
+  guint64 video_buffer_count;
   int n_frames;
   GstClockTime timestamp_offset;
 };
@@ -586,6 +586,7 @@ gst_jpeg_parse_reset (GstJpegParse * parse)
   parse->height = 0;
   parse->last_offset = 0;
   parse->state = 0;
+  parse->in_entropy_data = FALSE;
   parse->sof = -1;
   parse->adobe_transform = 0;
   parse->x_density = 0;
@@ -670,6 +671,29 @@ gst_jpeg_parse_push_frame (GstJpegParse * parse, GstBaseParseFrame * frame,
   return gst_base_parse_finish_frame (bparse, frame, size);
 }
 
+/* Returns the offset of the first marker at or after @offset which isn't a
+ * restart marker, or -1 if there is none yet. Inside entropy-coded data a
+ * 0xff byte is only followed by a stuffed 0x00 or a RSTn code, so the scan
+ * is mostly memchr() and restart markers don't need a segment each */
+static gint
+gst_jpeg_parse_skip_entropy_coded_data (const guint8 * data, gsize size,
+    guint offset)
+{
+  const guint8 *p = data + offset;
+  const guint8 *end = data + size;
+
+  while (p < end && end - p >= 2) {
+    p = memchr (p, 0xff, end - p - 1);
+    if (!p)
+      return -1;
+    if (p[1] >= 0xc0 && p[1] < 0xff && (p[1] < GST_JPEG_MARKER_RST_MIN
+            || p[1] > GST_JPEG_MARKER_RST_MAX))
+      return p - data;
+    p++;
+  }
+  return -1;
+}
+
 static GstFlowReturn
 gst_jpeg_parse_handle_frame (GstBaseParse * bparse, GstBaseParseFrame * frame,
     gint * skipsize)
@@ -688,6 +712,18 @@ gst_jpeg_parse_handle_frame (GstBaseParse * bparse, GstBaseParseFrame * frame,
     offset -= 1;                /* it migth be in the middle marker */
 
   while (offset < mapinfo.size) {
+    if (parse->in_entropy_data) {
+      gint next = gst_jpeg_parse_skip_entropy_coded_data (mapinfo.data,
+          mapinfo.size, offset);
+
+      if (next < 0) {
+        parse->last_offset = mapinfo.size;
+        goto beach;
+      }
+      parse->in_entropy_data = FALSE;
+      offset = next;
+    }
+
     if (!gst_jpeg_parse (&seg, mapinfo.data, mapinfo.size, offset)) {
       if (!valid_state (parse->state, GST_JPEG_PARSER_STATE_GOT_SOI)) {
         /* Skip any garbage until SOI */
@@ -752,6 +788,7 @@ gst_jpeg_parse_handle_frame (GstBaseParse * bparse, GstBaseParseFrame * frame,
         if (!valid_state (parse->state, GST_JPEG_PARSER_STATE_GOT_SOF))
           GST_WARNING_OBJECT (parse, "SOS marker without SOF one");
         parse->state |= GST_JPEG_PARSER_STATE_GOT_SOS;
+        parse->in_entropy_data = TRUE;
         break;
       case GST_JPEG_MARKER_COM:
         if (!gst_jpeg_parse_com (parse, &seg)) {
@@ -49,6 +49,8 @@ struct _GstJpegParse {
 
   guint last_offset;
   gint state;
+  /* scanning the entropy-coded data following a SOS */
+  gboolean in_entropy_data;
 
   gint8 sof;
   gint8 adobe_transform;
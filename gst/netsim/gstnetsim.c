@@ -66,6 +66,10 @@ enum
   PROP_MAX_KBPS,
   PROP_MAX_BUCKET_SIZE,
   PROP_ALLOW_REORDERING,
+  PROP_BURST_ENTER_PROBABILITY,
+  PROP_BURST_EXIT_PROBABILITY,
+  PROP_BURST_DROP_PROBABILITY,
+  PROP_TRACE_FILE,
 };
 
 /* these numbers are nothing but wild guesses and don't reflect any reality */
@@ -79,6 +83,13 @@ enum
 #define DEFAULT_MAX_KBPS -1
 #define DEFAULT_MAX_BUCKET_SIZE -1
 #define DEFAULT_ALLOW_REORDERING TRUE
+#define DEFAULT_BURST_ENTER_PROBABILITY 0.0
+#define DEFAULT_BURST_EXIT_PROBABILITY 1.0
+#define DEFAULT_BURST_DROP_PROBABILITY 1.0
+#define DEFAULT_TRACE_FILE NULL
+
+/* Every delivery opportunity of a link trace can carry this many bytes */
+#define TRACE_MTU 1500
 
 static GstStaticPadTemplate gst_net_sim_sink_template =
 GST_STATIC_PAD_TEMPLATE ("sink",
@@ -96,12 +107,13 @@ G_DEFINE_TYPE (GstNetSim, gst_net_sim, GST_TYPE_ELEMENT);
 GST_ELEMENT_REGISTER_DEFINE (netsim, "netsim",
     GST_RANK_MARGINAL, GST_TYPE_NET_SIM);
 
+static gboolean gst_net_sim_release_buffers (GstNetSim * netsim);
+
 static gboolean
 gst_net_sim_source_dispatch (GSource * source,
     GSourceFunc callback, gpointer user_data)
 {
-  callback (user_data);
-  return FALSE;
+  return callback (user_data);
 }
 
 GSourceFuncs gst_net_sim_source_funcs = {
@@ -161,6 +173,12 @@ gst_net_sim_src_activatemode (GstPad * pad, GstObject * parent,
     if (netsim->main_loop == NULL) {
       GMainContext *main_context = g_main_context_new ();
       netsim->main_loop = g_main_loop_new (main_context, FALSE);
+
+      netsim->release_source =
+          g_source_new (&gst_net_sim_source_funcs, sizeof (GSource));
+      g_source_set_callback (netsim->release_source,
+          (GSourceFunc) gst_net_sim_release_buffers, netsim, NULL);
+      g_source_attach (netsim->release_source, main_context);
       g_main_context_unref (main_context);
 
       GST_TRACE_OBJECT (netsim, "ACT: Starting task on srcpad");
@@ -180,6 +198,13 @@ gst_net_sim_src_activatemode (GstPad * pad, GstObject * parent,
 
       /* Adds an Idle Source which quits the main loop from within.
        * This removes the possibility for run/quit race conditions. */
+      g_source_destroy (netsim->release_source);
+      g_source_unref (netsim->release_source);
+      netsim->release_source = NULL;
+      g_sequence_remove_range (g_sequence_get_begin_iter
+          (netsim->release_queue),
+          g_sequence_get_end_iter (netsim->release_queue));
+
       GST_TRACE_OBJECT (netsim, "DEACT: Stopping main loop on deactivate");
       source = g_idle_source_new ();
       g_source_set_callback (source, _main_loop_quit_and_remove_source,
@@ -209,35 +234,107 @@ gst_net_sim_src_activatemode (GstPad * pad, GstObject * parent,
 
 typedef struct
 {
-  GstPad *pad;
   GstBuffer *buf;
-} PushBufferCtx;
+  gint64 ready_time;
+  guint64 seqnum;
+} DelayedBuffer;
 
-static inline PushBufferCtx *
-push_buffer_ctx_new (GstPad * pad, GstBuffer * buf)
+static inline DelayedBuffer *
+delayed_buffer_new (GstBuffer * buf, gint64 ready_time, guint64 seqnum)
 {
-  PushBufferCtx *ctx = g_slice_new (PushBufferCtx);
-  ctx->pad = gst_object_ref (pad);
-  ctx->buf = gst_buffer_ref (buf);
-  return ctx;
+  DelayedBuffer *db = g_slice_new (DelayedBuffer);
+  db->buf = gst_buffer_ref (buf);
+  db->ready_time = ready_time;
+  db->seqnum = seqnum;
+  return db;
 }
 
-static inline void
-push_buffer_ctx_free (PushBufferCtx * ctx)
+static void
+delayed_buffer_free (DelayedBuffer * db)
 {
-  if (G_LIKELY (ctx != NULL)) {
-    gst_buffer_unref (ctx->buf);
-    gst_object_unref (ctx->pad);
-    g_slice_free (PushBufferCtx, ctx);
+  if (G_LIKELY (db != NULL)) {
+    gst_buffer_replace (&db->buf, NULL);
+    g_slice_free (DelayedBuffer, db);
   }
 }
 
+/* Buffers with the same release time keep their arrival order */
+static gint
+delayed_buffer_compare (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+  const DelayedBuffer *da = a;
+  const DelayedBuffer *db = b;
+
+  if (da->ready_time != db->ready_time)
+    return da->ready_time < db->ready_time ? -1 : 1;
+
+  return da->seqnum < db->seqnum ? -1 : (da->seqnum > db->seqnum);
+}
+
+/* Called from the srcpad task, pushes every buffer that is due and rearms
+ * the release source for the next one */
 static gboolean
-push_buffer_ctx_push (PushBufferCtx * ctx)
+gst_net_sim_release_buffers (GstNetSim * netsim)
 {
-  GST_DEBUG_OBJECT (ctx->pad, "Pushing buffer now");
-  gst_pad_push (ctx->pad, gst_buffer_ref (ctx->buf));
-  return FALSE;
+  GstBufferList *list;
+  gint64 now_time;
+
+  g_mutex_lock (&netsim->loop_mutex);
+  if (netsim->release_source == NULL) {
+    g_mutex_unlock (&netsim->loop_mutex);
+    return G_SOURCE_REMOVE;
+  }
+
+  list = gst_buffer_list_new ();
+  now_time = g_get_monotonic_time ();
+  while (!g_sequence_is_empty (netsim->release_queue)) {
+    GSequenceIter *iter = g_sequence_get_begin_iter (netsim->release_queue);
+    DelayedBuffer *db = g_sequence_get (iter);
+
+    if (db->ready_time > now_time) {
+      g_source_set_ready_time (netsim->release_source, db->ready_time);
+      break;
+    }
+
+    gst_buffer_list_add (list, db->buf);
+    db->buf = NULL;
+    g_sequence_remove (iter);
+  }
+
+  if (g_sequence_is_empty (netsim->release_queue))
+    g_source_set_ready_time (netsim->release_source, -1);
+  g_mutex_unlock (&netsim->loop_mutex);
+
+  if (gst_buffer_list_length (list) == 1) {
+    GST_LOG_OBJECT (netsim, "Pushing buffer now");
+    gst_pad_push (netsim->srcpad,
+        gst_buffer_ref (gst_buffer_list_get (list, 0)));
+    gst_buffer_list_unref (list);
+  } else if (gst_buffer_list_length (list) > 1) {
+    GST_LOG_OBJECT (netsim, "Pushing %u buffers now",
+        gst_buffer_list_length (list));
+    gst_pad_push_list (netsim->srcpad, list);
+  } else {
+    gst_buffer_list_unref (list);
+  }
+
+  return G_SOURCE_CONTINUE;
+}
+
+/* with loop_mutex held */
+static void
+gst_net_sim_schedule_buffer (GstNetSim * netsim, GstBuffer * buf,
+    gint64 ready_time)
+{
+  DelayedBuffer *db;
+  GSequenceIter *iter;
+
+  db = delayed_buffer_new (buf, ready_time, netsim->release_seqnum++);
+  iter = g_sequence_insert_sorted (netsim->release_queue, db,
+      delayed_buffer_compare, NULL);
+
+  if (g_sequence_iter_is_begin (iter))
+    g_source_set_ready_time (netsim->release_source, ready_time);
 }
 
 static gint
@@ -328,18 +425,81 @@ get_random_value_gamma (GRand * rand_seed, gint32 low, gint32 high,
   return round (x + low);
 }
 
+/* Time in microseconds of the delivery opportunity at @pos, the trace
+ * repeats itself after its last entry */
+static gint64
+gst_net_sim_trace_opportunity_time (GstNetSim * netsim, guint64 pos)
+{
+  guint n = netsim->trace->len;
+  guint64 period = g_array_index (netsim->trace, guint64, n - 1);
+
+  return netsim->trace_start_time +
+      ((pos / n) * period + g_array_index (netsim->trace, guint64, pos % n))
+      * 1000;
+}
+
+/* Mahimahi-style link emulation: packets are serialized on the link and
+ * leave it at the delivery opportunity that carries their last byte. */
+static gint64
+gst_net_sim_trace_release_time (GstNetSim * netsim, gsize size,
+    gint64 arrival_time)
+{
+  guint n = netsim->trace->len;
+  guint64 period = g_array_index (netsim->trace, guint64, n - 1) * 1000;
+  guint64 first_pos;
+  gint64 ready_time;
+
+  if (netsim->trace_start_time == -1) {
+    netsim->trace_start_time = arrival_time;
+    netsim->trace_pos = 0;
+    netsim->trace_bytes_left = TRACE_MTU;
+  }
+
+  /* Opportunities that passed while the link was idle are lost, skip whole
+   * trace periods at once before walking the current one */
+  first_pos = 0;
+  if (arrival_time > netsim->trace_start_time)
+    first_pos = (arrival_time - netsim->trace_start_time) / period * n;
+  if (netsim->trace_pos < first_pos) {
+    netsim->trace_pos = first_pos;
+    netsim->trace_bytes_left = TRACE_MTU;
+  }
+  while (gst_net_sim_trace_opportunity_time (netsim,
+          netsim->trace_pos) < arrival_time) {
+    netsim->trace_pos++;
+    netsim->trace_bytes_left = TRACE_MTU;
+  }
+
+  while (size > netsim->trace_bytes_left) {
+    size -= netsim->trace_bytes_left;
+    netsim->trace_pos++;
+    netsim->trace_bytes_left = TRACE_MTU;
+  }
+  netsim->trace_bytes_left -= size;
+
+  ready_time = gst_net_sim_trace_opportunity_time (netsim, netsim->trace_pos);
+  if (netsim->trace_bytes_left == 0) {
+    netsim->trace_pos++;
+    netsim->trace_bytes_left = TRACE_MTU;
+  }
+
+  return ready_time;
+}
+
 static GstFlowReturn
 gst_net_sim_delay_buffer (GstNetSim * netsim, GstBuffer * buf)
 {
   GstFlowReturn ret = GST_FLOW_OK;
+  gboolean delayed = FALSE;
+  gint64 ready_time, now_time;
 
   g_mutex_lock (&netsim->loop_mutex);
-  if (netsim->main_loop != NULL && netsim->delay_probability > 0 &&
+  now_time = g_get_monotonic_time ();
+  ready_time = now_time;
+
+  if (netsim->release_source != NULL && netsim->delay_probability > 0 &&
       g_rand_double (netsim->rand_seed) < netsim->delay_probability) {
     gint delay;
-    PushBufferCtx *ctx;
-    GSource *source;
-    gint64 ready_time, now_time;
 
     switch (netsim->delay_distribution) {
       case DISTRIBUTION_UNIFORM:
@@ -362,11 +522,17 @@ gst_net_sim_delay_buffer (GstNetSim * netsim, GstBuffer * buf)
     if (delay < 0)
       delay = 0;
 
-    ctx = push_buffer_ctx_new (netsim->srcpad, buf);
+    ready_time += delay * 1000;
+    delayed = TRUE;
+  }
+
+  if (netsim->release_source != NULL && netsim->trace != NULL) {
+    ready_time = gst_net_sim_trace_release_time (netsim,
+        gst_buffer_get_size (buf), ready_time);
+    delayed = TRUE;
+  }
 
-    source = g_source_new (&gst_net_sim_source_funcs, sizeof (GSource));
-    now_time = g_get_monotonic_time ();
-    ready_time = now_time + delay * 1000;
+  if (delayed) {
     if (!netsim->allow_reordering && ready_time < netsim->last_ready_time)
       ready_time = netsim->last_ready_time + 1;
 
@@ -374,11 +540,7 @@ gst_net_sim_delay_buffer (GstNetSim * netsim, GstBuffer * buf)
     GST_DEBUG_OBJECT (netsim, "Delaying packet by %" G_GINT64_FORMAT "ms",
         (ready_time - now_time) / 1000);
 
-    g_source_set_ready_time (source, ready_time);
-    g_source_set_callback (source, (GSourceFunc) push_buffer_ctx_push,
-        ctx, (GDestroyNotify) push_buffer_ctx_free);
-    g_source_attach (source, g_main_loop_get_context (netsim->main_loop));
-    g_source_unref (source);
+    gst_net_sim_schedule_buffer (netsim, buf, ready_time);
   } else {
     ret = gst_pad_push (netsim->srcpad, gst_buffer_ref (buf));
   }
@@ -470,6 +632,28 @@ gst_net_sim_token_bucket (GstNetSim * netsim, GstBuffer * buf)
   return TRUE;
 }
 
+/* Gilbert-Elliott model: a two state Markov chain where the bad state drops
+ * packets with burst-drop-probability, the good state uses drop-probability */
+static gboolean
+gst_net_sim_burst_loss (GstNetSim * netsim)
+{
+  if (netsim->burst_enter_probability <= 0 && !netsim->burst_loss_bad_state)
+    return FALSE;
+
+  if (netsim->burst_loss_bad_state) {
+    if (g_rand_double (netsim->rand_seed) <
+        (gdouble) netsim->burst_exit_probability)
+      netsim->burst_loss_bad_state = FALSE;
+  } else if (g_rand_double (netsim->rand_seed) <
+      (gdouble) netsim->burst_enter_probability) {
+    netsim->burst_loss_bad_state = TRUE;
+  }
+
+  return netsim->burst_loss_bad_state &&
+      g_rand_double (netsim->rand_seed) <
+      (gdouble) netsim->burst_drop_probability;
+}
+
 static GstFlowReturn
 gst_net_sim_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 {
@@ -483,6 +667,8 @@ gst_net_sim_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
     netsim->drop_packets--;
     GST_DEBUG_OBJECT (netsim, "Dropping packet (%d left)",
         netsim->drop_packets);
+  } else if (gst_net_sim_burst_loss (netsim)) {
+    GST_DEBUG_OBJECT (netsim, "Dropping packet in loss burst");
   } else if (netsim->drop_probability > 0
       && g_rand_double (netsim->rand_seed) <
       (gdouble) netsim->drop_probability) {
@@ -542,6 +728,19 @@ gst_net_sim_set_property (GObject * object,
     case PROP_ALLOW_REORDERING:
       netsim->allow_reordering = g_value_get_boolean (value);
       break;
+    case PROP_BURST_ENTER_PROBABILITY:
+      netsim->burst_enter_probability = g_value_get_float (value);
+      break;
+    case PROP_BURST_EXIT_PROBABILITY:
+      netsim->burst_exit_probability = g_value_get_float (value);
+      break;
+    case PROP_BURST_DROP_PROBABILITY:
+      netsim->burst_drop_probability = g_value_get_float (value);
+      break;
+    case PROP_TRACE_FILE:
+      g_free (netsim->trace_file);
+      netsim->trace_file = g_value_dup_string (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -585,6 +784,18 @@ gst_net_sim_get_property (GObject * object,
     case PROP_ALLOW_REORDERING:
       g_value_set_boolean (value, netsim->allow_reordering);
       break;
+    case PROP_BURST_ENTER_PROBABILITY:
+      g_value_set_float (value, netsim->burst_enter_probability);
+      break;
+    case PROP_BURST_EXIT_PROBABILITY:
+      g_value_set_float (value, netsim->burst_exit_probability);
+      break;
+    case PROP_BURST_DROP_PROBABILITY:
+      g_value_set_float (value, netsim->burst_drop_probability);
+      break;
+    case PROP_TRACE_FILE:
+      g_value_set_string (value, netsim->trace_file);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -592,6 +803,101 @@ gst_net_sim_get_property (GObject * object,
 }
 
 
+static gboolean
+gst_net_sim_load_trace (GstNetSim * netsim, GError ** error)
+{
+  gchar *contents;
+  gchar **lines;
+  GArray *trace;
+  guint64 last = 0;
+  guint i;
+
+  if (!g_file_get_contents (netsim->trace_file, &contents, NULL, error))
+    return FALSE;
+
+  trace = g_array_new (FALSE, FALSE, sizeof (guint64));
+  lines = g_strsplit (contents, "\n", -1);
+  g_free (contents);
+
+  for (i = 0; lines[i]; i++) {
+    gchar *line = g_strstrip (lines[i]);
+    guint64 value;
+
+    if (*line == '\0')
+      continue;
+
+    if (!g_ascii_string_to_unsigned (line, 10, last, G_MAXUINT32, &value,
+            error)) {
+      g_prefix_error (error, "line %u: ", i + 1);
+      goto error;
+    }
+
+    g_array_append_val (trace, value);
+    last = value;
+  }
+
+  if (last == 0) {
+    g_set_error_literal (error, G_FILE_ERROR, G_FILE_ERROR_INVAL,
+        "trace must cover a period of at least 1 ms");
+    goto error;
+  }
+
+  g_strfreev (lines);
+  g_clear_pointer (&netsim->trace, g_array_unref);
+  netsim->trace = trace;
+
+  return TRUE;
+
+error:
+  g_strfreev (lines);
+  g_array_unref (trace);
+  return FALSE;
+}
+
+static GstStateChangeReturn
+gst_net_sim_change_state (GstElement * element, GstStateChange transition)
+{
+  GstNetSim *netsim = GST_NET_SIM (element);
+  GstStateChangeReturn ret;
+
+  switch (transition) {
+    case GST_STATE_CHANGE_NULL_TO_READY:
+      if (netsim->trace_file) {
+        GError *err = NULL;
+
+        if (!gst_net_sim_load_trace (netsim, &err)) {
+          GST_ELEMENT_ERROR (netsim, RESOURCE, READ,
+              ("Could not read trace file \"%s\"", netsim->trace_file),
+              ("%s", err->message));
+          g_error_free (err);
+          return GST_STATE_CHANGE_FAILURE;
+        }
+      }
+      break;
+    case GST_STATE_CHANGE_READY_TO_PAUSED:
+      g_mutex_lock (&netsim->loop_mutex);
+      netsim->trace_start_time = -1;
+      netsim->burst_loss_bad_state = FALSE;
+      g_mutex_unlock (&netsim->loop_mutex);
+      break;
+    default:
+      break;
+  }
+
+  ret = GST_ELEMENT_CLASS (gst_net_sim_parent_class)->change_state (element,
+      transition);
+
+  switch (transition) {
+    case GST_STATE_CHANGE_READY_TO_NULL:
+      g_clear_pointer (&netsim->trace, g_array_unref);
+      break;
+    default:
+      break;
+  }
+
+  return ret;
+}
+
 static void
 gst_net_sim_init (GstNetSim * netsim)
 {
@@ -608,6 +914,9 @@ gst_net_sim_init (GstNetSim * netsim)
   netsim->rand_seed = g_rand_new ();
   netsim->main_loop = NULL;
   netsim->prev_time = GST_CLOCK_TIME_NONE;
+  netsim->release_queue =
+      g_sequence_new ((GDestroyNotify) delayed_buffer_free);
+  netsim->trace_start_time = -1;
 
   GST_OBJECT_FLAG_SET (netsim->sinkpad,
       GST_PAD_FLAG_PROXY_CAPS | GST_PAD_FLAG_PROXY_ALLOCATION);
@@ -624,6 +933,9 @@ gst_net_sim_finalize (GObject * object)
   GstNetSim *netsim = GST_NET_SIM (object);
 
   g_rand_free (netsim->rand_seed);
+  g_sequence_free (netsim->release_queue);
+  g_clear_pointer (&netsim->trace, g_array_unref);
+  g_free (netsim->trace_file);
   g_mutex_clear (&netsim->loop_mutex);
   g_cond_clear (&netsim->start_cond);
 
@@ -665,6 +977,9 @@ gst_net_sim_class_init (GstNetSimClass * klass)
   gobject_class->set_property = gst_net_sim_set_property;
   gobject_class->get_property = gst_net_sim_get_property;
 
+  gstelement_class->change_state =
+      GST_DEBUG_FUNCPTR (gst_net_sim_change_state);
+
   g_object_class_install_property (gobject_class, PROP_MIN_DELAY,
       g_param_spec_int ("min-delay", "Minimum delay (ms)",
           "The minimum delay in ms to apply to buffers",
@@ -757,6 +1072,73 @@ gst_net_sim_class_init (GstNetSimClass * klass)
           DEFAULT_ALLOW_REORDERING,
           G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstNetSim:burst-enter-probability:
+   *
+   * Probability of moving from the good to the bad state of the
+   * Gilbert-Elliott loss model for every packet. Setting this to a positive
+   * value enables bursty packet loss, see also "burst-exit-probability" and
+   * "burst-drop-probability". In the good state "drop-probability" applies.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class,
+      PROP_BURST_ENTER_PROBABILITY,
+      g_param_spec_float ("burst-enter-probability",
+          "Burst Enter Probability",
+          "The Probability to enter a loss burst (Gilbert-Elliott p)",
+          0.0, 1.0, DEFAULT_BURST_ENTER_PROBABILITY,
+          G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstNetSim:burst-exit-probability:
+   *
+   * Probability of moving from the bad back to the good state of the
+   * Gilbert-Elliott loss model for every packet. The mean burst length is
+   * 1 / burst-exit-probability packets.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class,
+      PROP_BURST_EXIT_PROBABILITY,
+      g_param_spec_float ("burst-exit-probability", "Burst Exit Probability",
+          "The Probability to leave a loss burst (Gilbert-Elliott r)",
+          0.0, 1.0, DEFAULT_BURST_EXIT_PROBABILITY,
+          G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstNetSim:burst-drop-probability:
+   *
+   * Probability a packet is dropped while in the bad state of the
+   * Gilbert-Elliott loss model.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class,
+      PROP_BURST_DROP_PROBABILITY,
+      g_param_spec_float ("burst-drop-probability", "Burst Drop Probability",
+          "The Probability a buffer is dropped during a loss burst",
+          0.0, 1.0, DEFAULT_BURST_DROP_PROBABILITY,
+          G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstNetSim:trace-file:
+   *
+   * A link capacity trace in the format used by Mahimahi: every line holds
+   * the time in milliseconds at which the link can deliver one packet of up
+   * to 1500 bytes. The trace is repeated after its last entry. Packets are
+   * queued and released at the delivery opportunities, which emulates a link
+   * with varying bandwidth. The file is read when going to READY.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_TRACE_FILE,
+      g_param_spec_string ("trace-file", "Trace File",
+          "Link capacity trace to replay (NULL = disabled)",
+          DEFAULT_TRACE_FILE,
+          G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
   GST_DEBUG_CATEGORY_INIT (netsim_debug, "netsim", 0, "Network simulator");
 
   gst_type_mark_as_plugin_api (distribution_get_type (), 0);
@@ -77,6 +77,21 @@ struct _GstNetSim
   NormalDistributionState delay_state;
   gint64 last_ready_time;
 
+  /* delayed buffers, sorted by release time and released from a single
+   * GSource on the srcpad task */
+  GSource *release_source;
+  GSequence *release_queue;
+  guint64 release_seqnum;
+
+  /* Gilbert-Elliott burst loss state */
+  gboolean burst_loss_bad_state;
+
+  /* link capacity trace, delivery opportunities in ms */
+  GArray *trace;
+  gint64 trace_start_time;
+  guint64 trace_pos;
+  gsize trace_bytes_left;
+
   /* properties */
   gint min_delay;
   gint max_delay;
@@ -88,6 +103,10 @@ struct _GstNetSim
   gint max_kbps;
   gint max_bucket_size;
   gboolean allow_reordering;
+  gfloat burst_enter_probability;
+  gfloat burst_exit_probability;
+  gfloat burst_drop_probability;
+  gchar *trace_file;
 };
 
 struct _GstNetSimClass
@@ -0,0 +1,212 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/**
+ * SECTION:element-nullav1dec
+ * @title: nullav1dec
+ *
+ * Runs the #GstAV1Decoder state machine (OBU parsing, reference frame
+ * updates, show-existing-frame handling and operating point selection)
+ * without decoding any tile data.
+ *
+ * Each output buffer is a small placeholder carrying the decode order and
+ * the order hint of the picture, see the nulldec plugin documentation for the exact layout.
+ * This allows testing and benchmarking the codec base class and upstream
+ * elements without any hardware.
+ *
+ * ## Example launch line
+ * ```
+ * gst-launch-1.0 filesrc location=/path/to/av1/file ! parsebin ! nullav1dec ! fakesink
+ * ```
+ *
+ * Since: 1.24
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstnullav1dec.h"
+#include "gstnulldecutils.h"
+
+GST_DEBUG_CATEGORY_STATIC (gst_null_av1_dec_debug);
+#define GST_CAT_DEFAULT gst_null_av1_dec_debug
+
+struct _GstNullAV1Dec
+{
+  GstAV1Decoder parent;
+
+  GstNullDecState state;
+};
+
+static GstStaticPadTemplate sink_template =
+GST_STATIC_PAD_TEMPLATE (GST_VIDEO_DECODER_SINK_NAME,
+    GST_PAD_SINK, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS ("video/x-av1, "
+        "stream-format = (string) obu-stream, alignment = (string) frame"));
+
+static GstStaticPadTemplate src_template =
+GST_STATIC_PAD_TEMPLATE (GST_VIDEO_DECODER_SRC_NAME,
+    GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (GST_NULL_DEC_SRC_CAPS));
+
+#define parent_class gst_null_av1_dec_parent_class
+G_DEFINE_TYPE (GstNullAV1Dec, gst_null_av1_dec, GST_TYPE_AV1_DECODER);
+
+GST_ELEMENT_REGISTER_DEFINE (nullav1dec, "nullav1dec",
+    GST_RANK_NONE, GST_TYPE_NULL_AV1_DEC);
+
+static gboolean gst_null_av1_dec_stop (GstVideoDecoder * decoder);
+static gboolean gst_null_av1_dec_negotiate (GstVideoDecoder * decoder);
+static GstFlowReturn gst_null_av1_dec_new_sequence (GstAV1Decoder * decoder,
+    const GstAV1SequenceHeaderOBU * seq_hdr, gint max_dpb_size);
+static GstFlowReturn gst_null_av1_dec_new_picture (GstAV1Decoder * decoder,
+    GstVideoCodecFrame * frame, GstAV1Picture * picture);
+static GstAV1Picture *gst_null_av1_dec_duplicate_picture (GstAV1Decoder *
+    decoder, GstVideoCodecFrame * frame, GstAV1Picture * picture);
+static GstFlowReturn gst_null_av1_dec_decode_tile (GstAV1Decoder * decoder,
+    GstAV1Picture * picture, GstAV1Tile * tile);
+static GstFlowReturn gst_null_av1_dec_output_picture (GstAV1Decoder * decoder,
+    GstVideoCodecFrame * frame, GstAV1Picture * picture);
+
+static void
+gst_null_av1_dec_class_init (GstNullAV1DecClass * klass)
+{
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+  GstVideoDecoderClass *decoder_class = GST_VIDEO_DECODER_CLASS (klass);
+  GstAV1DecoderClass *av1decoder_class = GST_AV1_DECODER_CLASS (klass);
+
+  gst_element_class_add_static_pad_template (element_class, &sink_template);
+  gst_element_class_add_static_pad_template (element_class, &src_template);
+
+  gst_element_class_set_static_metadata (element_class,
+      "Null AV1 decoder", "Codec/Decoder/Video",
+      "Runs the AV1 decoding process without decoding pixels",
+      "GStreamer developers <gstreamer-devel@lists.freedesktop.org>");
+
+  decoder_class->stop = GST_DEBUG_FUNCPTR (gst_null_av1_dec_stop);
+  decoder_class->negotiate = GST_DEBUG_FUNCPTR (gst_null_av1_dec_negotiate);
+  decoder_class->decide_allocation =
+      GST_DEBUG_FUNCPTR (gst_null_dec_decide_allocation);
+
+  av1decoder_class->new_sequence =
+      GST_DEBUG_FUNCPTR (gst_null_av1_dec_new_sequence);
+  av1decoder_class->new_picture =
+      GST_DEBUG_FUNCPTR (gst_null_av1_dec_new_picture);
+  av1decoder_class->duplicate_picture =
+      GST_DEBUG_FUNCPTR (gst_null_av1_dec_duplicate_picture);
+  av1decoder_class->decode_tile =
+      GST_DEBUG_FUNCPTR (gst_null_av1_dec_decode_tile);
+  av1decoder_class->output_picture =
+      GST_DEBUG_FUNCPTR (gst_null_av1_dec_output_picture);
+
+  GST_DEBUG_CATEGORY_INIT (gst_null_av1_dec_debug, "nullav1dec", 0,
+      "nullav1dec");
+}
+
+static void
+gst_null_av1_dec_init (GstNullAV1Dec * self)
+{
+}
+
+static gboolean
+gst_null_av1_dec_stop (GstVideoDecoder * decoder)
+{
+  GstNullAV1Dec *self = GST_NULL_AV1_DEC (decoder);
+
+  gst_null_dec_state_clear (&self->state);
+
+  return GST_VIDEO_DECODER_CLASS (parent_class)->stop (decoder);
+}
+
+static gboolean
+gst_null_av1_dec_negotiate (GstVideoDecoder * decoder)
+{
+  GstNullAV1Dec *self = GST_NULL_AV1_DEC (decoder);
+
+  if (!gst_null_dec_set_output_state (decoder, &self->state))
+    return FALSE;
+
+  return GST_VIDEO_DECODER_CLASS (parent_class)->negotiate (decoder);
+}
+
+static GstFlowReturn
+gst_null_av1_dec_new_sequence (GstAV1Decoder * decoder,
+    const GstAV1SequenceHeaderOBU * seq_hdr, gint max_dpb_size)
+{
+  GstNullAV1Dec *self = GST_NULL_AV1_DEC (decoder);
+  guint width, height;
+
+  width = seq_hdr->max_frame_width_minus_1 + 1;
+  height = seq_hdr->max_frame_height_minus_1 + 1;
+
+  GST_DEBUG_OBJECT (self, "New sequence %ux%u, max DPB size %d",
+      width, height, max_dpb_size);
+
+  gst_null_dec_state_update (&self->state, decoder->input_state, width,
+      height, GST_VIDEO_INTERLACE_MODE_PROGRESSIVE);
+
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+gst_null_av1_dec_new_picture (GstAV1Decoder * decoder,
+    GstVideoCodecFrame * frame, GstAV1Picture * picture)
+{
+  return GST_FLOW_OK;
+}
+
+static GstAV1Picture *
+gst_null_av1_dec_duplicate_picture (GstAV1Decoder * decoder,
+    GstVideoCodecFrame * frame, GstAV1Picture * picture)
+{
+  GstAV1Picture *new_picture;
+
+  GST_LOG_OBJECT (decoder, "Duplicating picture %p", picture);
+
+  new_picture = gst_av1_picture_new ();
+  new_picture->frame_hdr = picture->frame_hdr;
+
+  return new_picture;
+}
+
+static GstFlowReturn
+gst_null_av1_dec_decode_tile (GstAV1Decoder * decoder,
+    GstAV1Picture * picture, GstAV1Tile * tile)
+{
+  GST_TRACE_OBJECT (decoder, "Decoding tile group of picture %p", picture);
+
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+gst_null_av1_dec_output_picture (GstAV1Decoder * decoder,
+    GstVideoCodecFrame * frame, GstAV1Picture * picture)
+{
+  GstNullAV1Dec *self = GST_NULL_AV1_DEC (decoder);
+  GstFlowReturn ret;
+
+  GST_LOG_OBJECT (self, "Outputting picture %p", picture);
+
+  ret = gst_null_dec_finish_frame (GST_VIDEO_DECODER (decoder), &self->state,
+      frame, picture->discont_state, 0, picture->system_frame_number,
+      picture->frame_hdr.order_hint);
+  gst_av1_picture_unref (picture);
+
+  return ret;
+}
@@ -0,0 +1,170 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstnulldecutils.h"
+
+GST_DEBUG_CATEGORY_EXTERN (gst_null_dec_debug);
+#define GST_CAT_DEFAULT gst_null_dec_debug
+
+void
+gst_null_dec_state_clear (GstNullDecState * state)
+{
+  g_clear_pointer (&state->input_state, gst_video_codec_state_unref);
+  state->width = 0;
+  state->height = 0;
+  state->interlace_mode = GST_VIDEO_INTERLACE_MODE_PROGRESSIVE;
+  state->need_negotiation = FALSE;
+}
+
+void
+gst_null_dec_state_update (GstNullDecState * state,
+    GstVideoCodecState * input_state, guint width, guint height,
+    GstVideoInterlaceMode interlace_mode)
+{
+  if (state->input_state != input_state) {
+    g_clear_pointer (&state->input_state, gst_video_codec_state_unref);
+    if (input_state)
+      state->input_state = gst_video_codec_state_ref (input_state);
+    state->need_negotiation = TRUE;
+  }
+
+  if (state->width != width || state->height != height ||
+      state->interlace_mode != interlace_mode) {
+    state->width = width;
+    state->height = height;
+    state->interlace_mode = interlace_mode;
+    state->need_negotiation = TRUE;
+  }
+}
+
+gboolean
+gst_null_dec_set_output_state (GstVideoDecoder * decoder,
+    GstNullDecState * state)
+{
+  GstVideoCodecState *output_state;
+  GstStructure *s;
+
+  if (state->width == 0 || state->height == 0) {
+    GST_DEBUG_OBJECT (decoder, "No sequence configured yet");
+    return FALSE;
+  }
+
+  /* The format is never used, the output caps only describe the stream */
+  output_state = gst_video_decoder_set_interlaced_output_state (decoder,
+      GST_VIDEO_FORMAT_GRAY8, state->interlace_mode, state->width,
+      state->height, state->input_state);
+
+  output_state->caps = gst_video_info_to_caps (&output_state->info);
+  s = gst_caps_get_structure (output_state->caps, 0);
+  gst_structure_set_name (s, GST_NULL_DEC_SRC_CAPS);
+  gst_structure_remove_field (s, "format");
+
+  GST_DEBUG_OBJECT (decoder, "Output caps %" GST_PTR_FORMAT,
+      output_state->caps);
+
+  gst_video_codec_state_unref (output_state);
+  state->need_negotiation = FALSE;
+
+  return TRUE;
+}
+
+gboolean
+gst_null_dec_decide_allocation (GstVideoDecoder * decoder, GstQuery * query)
+{
+  GstBufferPool *pool;
+  GstStructure *config;
+  GstCaps *caps;
+  guint min = 0, max = 0;
+
+  /* Downstream cannot know anything about our placeholder buffers, always
+   * use a plain buffer pool sized for the payload */
+  gst_query_parse_allocation (query, &caps, NULL);
+
+  if (gst_query_get_n_allocation_pools (query) > 0)
+    gst_query_parse_nth_allocation_pool (query, 0, NULL, NULL, &min, &max);
+
+  pool = gst_buffer_pool_new ();
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_set_params (config, caps, GST_NULL_DEC_PAYLOAD_SIZE,
+      min, max);
+  if (!gst_buffer_pool_set_config (pool, config)) {
+    GST_ERROR_OBJECT (decoder, "Couldn't configure buffer pool");
+    gst_object_unref (pool);
+    return FALSE;
+  }
+
+  if (gst_query_get_n_allocation_pools (query) > 0) {
+    gst_query_set_nth_allocation_pool (query, 0, pool,
+        GST_NULL_DEC_PAYLOAD_SIZE, min, max);
+  } else {
+    gst_query_add_allocation_pool (query, pool, GST_NULL_DEC_PAYLOAD_SIZE,
+        min, max);
+  }
+
+  gst_object_unref (pool);
+
+  return TRUE;
+}
+
+GstFlowReturn
+gst_null_dec_finish_frame (GstVideoDecoder * decoder, GstNullDecState * state,
+    GstVideoCodecFrame * frame, GstVideoCodecState * discont_state,
+    GstVideoBufferFlags buffer_flags, guint32 decode_order, gint order_cnt)
+{
+  GstMapInfo map;
+  GstFlowReturn ret;
+
+  if (discont_state) {
+    g_clear_pointer (&state->input_state, gst_video_codec_state_unref);
+    state->input_state = gst_video_codec_state_ref (discont_state);
+    state->need_negotiation = TRUE;
+  }
+
+  if (state->need_negotiation && !gst_video_decoder_negotiate (decoder)) {
+    GST_ERROR_OBJECT (decoder, "Couldn't negotiate with downstream");
+    gst_video_decoder_release_frame (decoder, frame);
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+
+  ret = gst_video_decoder_allocate_output_frame (decoder, frame);
+  if (ret != GST_FLOW_OK) {
+    GST_WARNING_OBJECT (decoder, "Couldn't allocate output buffer, %s",
+        gst_flow_get_name (ret));
+    gst_video_decoder_release_frame (decoder, frame);
+    return ret;
+  }
+
+  if (!gst_buffer_map (frame->output_buffer, &map, GST_MAP_WRITE)) {
+    GST_ERROR_OBJECT (decoder, "Couldn't map output buffer");
+    gst_video_decoder_release_frame (decoder, frame);
+    return GST_FLOW_ERROR;
+  }
+
+  GST_WRITE_UINT32_BE (map.data, decode_order);
+  GST_WRITE_UINT32_BE (map.data + 4, (guint32) order_cnt);
+  gst_buffer_unmap (frame->output_buffer, &map);
+
+  if (buffer_flags != 0)
+    GST_BUFFER_FLAG_SET (frame->output_buffer, buffer_flags);
+
+  return gst_video_decoder_finish_frame (decoder, frame);
+}
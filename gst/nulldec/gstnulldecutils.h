@@ -0,0 +1,64 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+G_BEGIN_DECLS
+
+#define GST_NULL_DEC_SRC_CAPS "video/x-null-decoded"
+
+/* Output buffers carry a big-endian guint32 with the system frame number of
+ * the frame the picture was decoded from (i.e. its decode order), followed
+ * by a big-endian gint32 with the picture order count of the picture */
+#define GST_NULL_DEC_PAYLOAD_SIZE 8
+
+typedef struct _GstNullDecState
+{
+  GstVideoCodecState *input_state;
+  guint width;
+  guint height;
+  GstVideoInterlaceMode interlace_mode;
+  gboolean need_negotiation;
+} GstNullDecState;
+
+void          gst_null_dec_state_clear (GstNullDecState * state);
+
+void          gst_null_dec_state_update (GstNullDecState * state,
+                                         GstVideoCodecState * input_state,
+                                         guint width,
+                                         guint height,
+                                         GstVideoInterlaceMode interlace_mode);
+
+gboolean      gst_null_dec_set_output_state (GstVideoDecoder * decoder,
+                                             GstNullDecState * state);
+
+gboolean      gst_null_dec_decide_allocation (GstVideoDecoder * decoder,
+                                              GstQuery * query);
+
+GstFlowReturn gst_null_dec_finish_frame (GstVideoDecoder * decoder,
+                                         GstNullDecState * state,
+                                         GstVideoCodecFrame * frame,
+                                         GstVideoCodecState * discont_state,
+                                         GstVideoBufferFlags buffer_flags,
+                                         guint32 decode_order,
+                                         gint order_cnt);
+
+G_END_DECLS
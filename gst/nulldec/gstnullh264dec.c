@@ -0,0 +1,221 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/**
+ * SECTION:element-nullh264dec
+ * @title: nullh264dec
+ *
+ * Runs the #GstH264Decoder state machine (parameter set handling, POC
+ * computation, reference picture marking, reference picture list
+ * construction and DPB bumping) without decoding any slice data.
+ *
+ * Each output buffer is a small placeholder carrying the decode order and
+ * the picture order count of the picture, see the nulldec plugin
+ * documentation for the exact layout. This allows testing and benchmarking
+ * the codec base class and upstream elements without any hardware.
+ *
+ * ## Example launch line
+ * ```
+ * gst-launch-1.0 filesrc location=/path/to/h264/file ! parsebin ! nullh264dec ! fakesink
+ * ```
+ *
+ * Since: 1.24
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstnullh264dec.h"
+#include "gstnulldecutils.h"
+
+GST_DEBUG_CATEGORY_STATIC (gst_null_h264_dec_debug);
+#define GST_CAT_DEFAULT gst_null_h264_dec_debug
+
+struct _GstNullH264Dec
+{
+  GstH264Decoder parent;
+
+  GstNullDecState state;
+};
+
+static GstStaticPadTemplate sink_template =
+GST_STATIC_PAD_TEMPLATE (GST_VIDEO_DECODER_SINK_NAME,
+    GST_PAD_SINK, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS ("video/x-h264, "
+        "stream-format = (string) { avc, avc3, byte-stream }, "
+        "alignment = (string) au"));
+
+static GstStaticPadTemplate src_template =
+GST_STATIC_PAD_TEMPLATE (GST_VIDEO_DECODER_SRC_NAME,
+    GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (GST_NULL_DEC_SRC_CAPS));
+
+#define parent_class gst_null_h264_dec_parent_class
+G_DEFINE_TYPE (GstNullH264Dec, gst_null_h264_dec, GST_TYPE_H264_DECODER);
+
+GST_ELEMENT_REGISTER_DEFINE (nullh264dec, "nullh264dec",
+    GST_RANK_NONE, GST_TYPE_NULL_H264_DEC);
+
+static gboolean gst_null_h264_dec_stop (GstVideoDecoder * decoder);
+static gboolean gst_null_h264_dec_negotiate (GstVideoDecoder * decoder);
+static GstFlowReturn gst_null_h264_dec_new_sequence (GstH264Decoder * decoder,
+    const GstH264SPS * sps, gint max_dpb_size);
+static GstFlowReturn gst_null_h264_dec_new_picture (GstH264Decoder * decoder,
+    GstVideoCodecFrame * frame, GstH264Picture * picture);
+static GstFlowReturn gst_null_h264_dec_new_field_picture (GstH264Decoder *
+    decoder, GstH264Picture * first_field, GstH264Picture * second_field);
+static GstFlowReturn gst_null_h264_dec_decode_slice (GstH264Decoder * decoder,
+    GstH264Picture * picture, GstH264Slice * slice, GArray * ref_pic_list0,
+    GArray * ref_pic_list1);
+static GstFlowReturn gst_null_h264_dec_output_picture (GstH264Decoder *
+    decoder, GstVideoCodecFrame * frame, GstH264Picture * picture);
+
+static void
+gst_null_h264_dec_class_init (GstNullH264DecClass * klass)
+{
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+  GstVideoDecoderClass *decoder_class = GST_VIDEO_DECODER_CLASS (klass);
+  GstH264DecoderClass *h264decoder_class = GST_H264_DECODER_CLASS (klass);
+
+  gst_element_class_add_static_pad_template (element_class, &sink_template);
+  gst_element_class_add_static_pad_template (element_class, &src_template);
+
+  gst_element_class_set_static_metadata (element_class,
+      "Null H.264 decoder", "Codec/Decoder/Video",
+      "Runs the H.264 decoding process without decoding pixels",
+      "GStreamer developers <gstreamer-devel@lists.freedesktop.org>");
+
+  decoder_class->stop = GST_DEBUG_FUNCPTR (gst_null_h264_dec_stop);
+  decoder_class->negotiate = GST_DEBUG_FUNCPTR (gst_null_h264_dec_negotiate);
+  decoder_class->decide_allocation =
+      GST_DEBUG_FUNCPTR (gst_null_dec_decide_allocation);
+
+  h264decoder_class->new_sequence =
+      GST_DEBUG_FUNCPTR (gst_null_h264_dec_new_sequence);
+  h264decoder_class->new_picture =
+      GST_DEBUG_FUNCPTR (gst_null_h264_dec_new_picture);
+  h264decoder_class->new_field_picture =
+      GST_DEBUG_FUNCPTR (gst_null_h264_dec_new_field_picture);
+  h264decoder_class->decode_slice =
+      GST_DEBUG_FUNCPTR (gst_null_h264_dec_decode_slice);
+  h264decoder_class->output_picture =
+      GST_DEBUG_FUNCPTR (gst_null_h264_dec_output_picture);
+
+  GST_DEBUG_CATEGORY_INIT (gst_null_h264_dec_debug, "nullh264dec", 0,
+      "nullh264dec");
+}
+
+static void
+gst_null_h264_dec_init (GstNullH264Dec * self)
+{
+  /* Build the reference picture lists like a real decoder would */
+  gst_h264_decoder_set_process_ref_pic_lists (GST_H264_DECODER (self), TRUE);
+}
+
+static gboolean
+gst_null_h264_dec_stop (GstVideoDecoder * decoder)
+{
+  GstNullH264Dec *self = GST_NULL_H264_DEC (decoder);
+
+  gst_null_dec_state_clear (&self->state);
+
+  return GST_VIDEO_DECODER_CLASS (parent_class)->stop (decoder);
+}
+
+static gboolean
+gst_null_h264_dec_negotiate (GstVideoDecoder * decoder)
+{
+  GstNullH264Dec *self = GST_NULL_H264_DEC (decoder);
+
+  if (!gst_null_dec_set_output_state (decoder, &self->state))
+    return FALSE;
+
+  return GST_VIDEO_DECODER_CLASS (parent_class)->negotiate (decoder);
+}
+
+static GstFlowReturn
+gst_null_h264_dec_new_sequence (GstH264Decoder * decoder,
+    const GstH264SPS * sps, gint max_dpb_size)
+{
+  GstNullH264Dec *self = GST_NULL_H264_DEC (decoder);
+  guint width, height;
+  GstVideoInterlaceMode interlace_mode = GST_VIDEO_INTERLACE_MODE_PROGRESSIVE;
+
+  if (sps->frame_cropping_flag) {
+    width = sps->crop_rect_width;
+    height = sps->crop_rect_height;
+  } else {
+    width = sps->width;
+    height = sps->height;
+  }
+
+  if (!sps->frame_mbs_only_flag)
+    interlace_mode = GST_VIDEO_INTERLACE_MODE_MIXED;
+
+  GST_DEBUG_OBJECT (self, "New sequence %ux%u, max DPB size %d",
+      width, height, max_dpb_size);
+
+  gst_null_dec_state_update (&self->state, decoder->input_state, width,
+      height, interlace_mode);
+
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+gst_null_h264_dec_new_picture (GstH264Decoder * decoder,
+    GstVideoCodecFrame * frame, GstH264Picture * picture)
+{
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+gst_null_h264_dec_new_field_picture (GstH264Decoder * decoder,
+    GstH264Picture * first_field, GstH264Picture * second_field)
+{
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+gst_null_h264_dec_decode_slice (GstH264Decoder * decoder,
+    GstH264Picture * picture, GstH264Slice * slice, GArray * ref_pic_list0,
+    GArray * ref_pic_list1)
+{
+  GST_TRACE_OBJECT (decoder, "Slice of picture %p (poc %d)", picture,
+      picture->pic_order_cnt);
+
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+gst_null_h264_dec_output_picture (GstH264Decoder * decoder,
+    GstVideoCodecFrame * frame, GstH264Picture * picture)
+{
+  GstNullH264Dec *self = GST_NULL_H264_DEC (decoder);
+  GstFlowReturn ret;
+
+  GST_LOG_OBJECT (self, "Outputting picture %p (poc %d)", picture,
+      picture->pic_order_cnt);
+
+  ret = gst_null_dec_finish_frame (GST_VIDEO_DECODER (decoder), &self->state,
+      frame, picture->discont_state, picture->buffer_flags,
+      picture->system_frame_number, picture->pic_order_cnt);
+  gst_h264_picture_unref (picture);
+
+  return ret;
+}
@@ -0,0 +1,223 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/**
+ * SECTION:element-nullmpeg2dec
+ * @title: nullmpeg2dec
+ *
+ * Runs the #GstMpeg2Decoder state machine (sequence and picture header
+ * handling, field pairing, reference picture tracking and reordering)
+ * without decoding any slice data.
+ *
+ * Each output buffer is a small placeholder carrying the decode order and
+ * the picture order count of the picture, see the nulldec plugin
+ * documentation for the exact layout. This allows testing and benchmarking
+ * the codec base class and upstream elements without any hardware.
+ *
+ * ## Example launch line
+ * ```
+ * gst-launch-1.0 filesrc location=/path/to/mpeg2/file ! parsebin ! nullmpeg2dec ! fakesink
+ * ```
+ *
+ * Since: 1.24
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstnullmpeg2dec.h"
+#include "gstnulldecutils.h"
+
+GST_DEBUG_CATEGORY_STATIC (gst_null_mpeg2_dec_debug);
+#define GST_CAT_DEFAULT gst_null_mpeg2_dec_debug
+
+struct _GstNullMpeg2Dec
+{
+  GstMpeg2Decoder parent;
+
+  GstNullDecState state;
+};
+
+static GstStaticPadTemplate sink_template =
+GST_STATIC_PAD_TEMPLATE (GST_VIDEO_DECODER_SINK_NAME,
+    GST_PAD_SINK, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS ("video/mpeg, "
+        "mpegversion = (int) 2, systemstream = (boolean) false"));
+
+static GstStaticPadTemplate src_template =
+GST_STATIC_PAD_TEMPLATE (GST_VIDEO_DECODER_SRC_NAME,
+    GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (GST_NULL_DEC_SRC_CAPS));
+
+#define parent_class gst_null_mpeg2_dec_parent_class
+G_DEFINE_TYPE (GstNullMpeg2Dec, gst_null_mpeg2_dec, GST_TYPE_MPEG2_DECODER);
+
+GST_ELEMENT_REGISTER_DEFINE (nullmpeg2dec, "nullmpeg2dec",
+    GST_RANK_NONE, GST_TYPE_NULL_MPEG2_DEC);
+
+static gboolean gst_null_mpeg2_dec_stop (GstVideoDecoder * decoder);
+static gboolean gst_null_mpeg2_dec_negotiate (GstVideoDecoder * decoder);
+static GstFlowReturn gst_null_mpeg2_dec_new_sequence (GstMpeg2Decoder *
+    decoder, const GstMpegVideoSequenceHdr * seq,
+    const GstMpegVideoSequenceExt * seq_ext,
+    const GstMpegVideoSequenceDisplayExt * seq_display_ext,
+    const GstMpegVideoSequenceScalableExt * seq_scalable_ext,
+    gint max_dpb_size);
+static GstFlowReturn gst_null_mpeg2_dec_new_picture (GstMpeg2Decoder * decoder,
+    GstVideoCodecFrame * frame, GstMpeg2Picture * picture);
+static GstFlowReturn gst_null_mpeg2_dec_new_field_picture (GstMpeg2Decoder *
+    decoder, GstMpeg2Picture * first_field, GstMpeg2Picture * second_field);
+static GstFlowReturn gst_null_mpeg2_dec_decode_slice (GstMpeg2Decoder *
+    decoder, GstMpeg2Picture * picture, GstMpeg2Slice * slice);
+static GstFlowReturn gst_null_mpeg2_dec_output_picture (GstMpeg2Decoder *
+    decoder, GstVideoCodecFrame * frame, GstMpeg2Picture * picture);
+
+static void
+gst_null_mpeg2_dec_class_init (GstNullMpeg2DecClass * klass)
+{
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+  GstVideoDecoderClass *decoder_class = GST_VIDEO_DECODER_CLASS (klass);
+  GstMpeg2DecoderClass *mpeg2decoder_class = GST_MPEG2_DECODER_CLASS (klass);
+
+  gst_element_class_add_static_pad_template (element_class, &sink_template);
+  gst_element_class_add_static_pad_template (element_class, &src_template);
+
+  gst_element_class_set_static_metadata (element_class,
+      "Null MPEG-2 decoder", "Codec/Decoder/Video",
+      "Runs the MPEG-2 decoding process without decoding pixels",
+      "GStreamer developers <gstreamer-devel@lists.freedesktop.org>");
+
+  decoder_class->stop = GST_DEBUG_FUNCPTR (gst_null_mpeg2_dec_stop);
+  decoder_class->negotiate = GST_DEBUG_FUNCPTR (gst_null_mpeg2_dec_negotiate);
+  decoder_class->decide_allocation =
+      GST_DEBUG_FUNCPTR (gst_null_dec_decide_allocation);
+
+  mpeg2decoder_class->new_sequence =
+      GST_DEBUG_FUNCPTR (gst_null_mpeg2_dec_new_sequence);
+  mpeg2decoder_class->new_picture =
+      GST_DEBUG_FUNCPTR (gst_null_mpeg2_dec_new_picture);
+  mpeg2decoder_class->new_field_picture =
+      GST_DEBUG_FUNCPTR (gst_null_mpeg2_dec_new_field_picture);
+  mpeg2decoder_class->decode_slice =
+      GST_DEBUG_FUNCPTR (gst_null_mpeg2_dec_decode_slice);
+  mpeg2decoder_class->output_picture =
+      GST_DEBUG_FUNCPTR (gst_null_mpeg2_dec_output_picture);
+
+  GST_DEBUG_CATEGORY_INIT (gst_null_mpeg2_dec_debug, "nullmpeg2dec", 0,
+      "nullmpeg2dec");
+}
+
+static void
+gst_null_mpeg2_dec_init (GstNullMpeg2Dec * self)
+{
+}
+
+static gboolean
+gst_null_mpeg2_dec_stop (GstVideoDecoder * decoder)
+{
+  GstNullMpeg2Dec *self = GST_NULL_MPEG2_DEC (decoder);
+
+  gst_null_dec_state_clear (&self->state);
+
+  return GST_VIDEO_DECODER_CLASS (parent_class)->stop (decoder);
+}
+
+static gboolean
+gst_null_mpeg2_dec_negotiate (GstVideoDecoder * decoder)
+{
+  GstNullMpeg2Dec *self = GST_NULL_MPEG2_DEC (decoder);
+
+  if (!gst_null_dec_set_output_state (decoder, &self->state))
+    return FALSE;
+
+  return GST_VIDEO_DECODER_CLASS (parent_class)->negotiate (decoder);
+}
+
+static GstFlowReturn
+gst_null_mpeg2_dec_new_sequence (GstMpeg2Decoder * decoder,
+    const GstMpegVideoSequenceHdr * seq,
+    const GstMpegVideoSequenceExt * seq_ext,
+    const GstMpegVideoSequenceDisplayExt * seq_display_ext,
+    const GstMpegVideoSequenceScalableExt * seq_scalable_ext,
+    gint max_dpb_size)
+{
+  GstNullMpeg2Dec *self = GST_NULL_MPEG2_DEC (decoder);
+  guint width, height;
+  GstVideoInterlaceMode interlace_mode = GST_VIDEO_INTERLACE_MODE_PROGRESSIVE;
+
+  width = seq->width;
+  height = seq->height;
+  if (seq_ext) {
+    width = (width & 0x0fff) | ((guint32) seq_ext->horiz_size_ext << 12);
+    height = (height & 0x0fff) | ((guint32) seq_ext->vert_size_ext << 12);
+
+    if (!seq_ext->progressive)
+      interlace_mode = GST_VIDEO_INTERLACE_MODE_MIXED;
+  }
+
+  GST_DEBUG_OBJECT (self, "New sequence %ux%u, max DPB size %d",
+      width, height, max_dpb_size);
+
+  gst_null_dec_state_update (&self->state, decoder->input_state, width,
+      height, interlace_mode);
+
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+gst_null_mpeg2_dec_new_picture (GstMpeg2Decoder * decoder,
+    GstVideoCodecFrame * frame, GstMpeg2Picture * picture)
+{
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+gst_null_mpeg2_dec_new_field_picture (GstMpeg2Decoder * decoder,
+    GstMpeg2Picture * first_field, GstMpeg2Picture * second_field)
+{
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+gst_null_mpeg2_dec_decode_slice (GstMpeg2Decoder * decoder,
+    GstMpeg2Picture * picture, GstMpeg2Slice * slice)
+{
+  GST_TRACE_OBJECT (decoder, "Slice of picture %p (poc %d)", picture,
+      picture->pic_order_cnt);
+
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+gst_null_mpeg2_dec_output_picture (GstMpeg2Decoder * decoder,
+    GstVideoCodecFrame * frame, GstMpeg2Picture * picture)
+{
+  GstNullMpeg2Dec *self = GST_NULL_MPEG2_DEC (decoder);
+  GstFlowReturn ret;
+
+  GST_LOG_OBJECT (self, "Outputting picture %p (poc %d)", picture,
+      picture->pic_order_cnt);
+
+  ret = gst_null_dec_finish_frame (GST_VIDEO_DECODER (decoder), &self->state,
+      frame, picture->discont_state, picture->buffer_flags,
+      picture->system_frame_number, picture->pic_order_cnt);
+  gst_mpeg2_picture_unref (picture);
+
+  return ret;
+}
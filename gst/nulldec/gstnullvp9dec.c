@@ -0,0 +1,210 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/**
+ * SECTION:element-nullvp9dec
+ * @title: nullvp9dec
+ *
+ * Runs the #GstVp9Decoder state machine (frame header parsing including
+ * the compressed header, reference frame updates and show-existing-frame
+ * handling) without decoding any tile data.
+ *
+ * Each output buffer is a small placeholder carrying the decode order of
+ * the picture, see the nulldec plugin documentation for the exact layout.
+ * This allows testing and benchmarking the codec base class and upstream
+ * elements without any hardware.
+ *
+ * ## Example launch line
+ * ```
+ * gst-launch-1.0 filesrc location=/path/to/vp9/file ! parsebin ! nullvp9dec ! fakesink
+ * ```
+ *
+ * Since: 1.24
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstnullvp9dec.h"
+#include "gstnulldecutils.h"
+
+GST_DEBUG_CATEGORY_STATIC (gst_null_vp9_dec_debug);
+#define GST_CAT_DEFAULT gst_null_vp9_dec_debug
+
+struct _GstNullVp9Dec
+{
+  GstVp9Decoder parent;
+
+  GstNullDecState state;
+};
+
+static GstStaticPadTemplate sink_template =
+GST_STATIC_PAD_TEMPLATE (GST_VIDEO_DECODER_SINK_NAME,
+    GST_PAD_SINK, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS ("video/x-vp9, alignment = (string) frame"));
+
+static GstStaticPadTemplate src_template =
+GST_STATIC_PAD_TEMPLATE (GST_VIDEO_DECODER_SRC_NAME,
+    GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (GST_NULL_DEC_SRC_CAPS));
+
+#define parent_class gst_null_vp9_dec_parent_class
+G_DEFINE_TYPE (GstNullVp9Dec, gst_null_vp9_dec, GST_TYPE_VP9_DECODER);
+
+GST_ELEMENT_REGISTER_DEFINE (nullvp9dec, "nullvp9dec",
+    GST_RANK_NONE, GST_TYPE_NULL_VP9_DEC);
+
+static gboolean gst_null_vp9_dec_stop (GstVideoDecoder * decoder);
+static gboolean gst_null_vp9_dec_negotiate (GstVideoDecoder * decoder);
+static GstFlowReturn gst_null_vp9_dec_new_sequence (GstVp9Decoder * decoder,
+    const GstVp9FrameHeader * frame_hdr, gint max_dpb_size);
+static GstFlowReturn gst_null_vp9_dec_new_picture (GstVp9Decoder * decoder,
+    GstVideoCodecFrame * frame, GstVp9Picture * picture);
+static GstVp9Picture *gst_null_vp9_dec_duplicate_picture (GstVp9Decoder *
+    decoder, GstVideoCodecFrame * frame, GstVp9Picture * picture);
+static GstFlowReturn gst_null_vp9_dec_decode_picture (GstVp9Decoder * decoder,
+    GstVp9Picture * picture, GstVp9Dpb * dpb);
+static GstFlowReturn gst_null_vp9_dec_output_picture (GstVp9Decoder * decoder,
+    GstVideoCodecFrame * frame, GstVp9Picture * picture);
+
+static void
+gst_null_vp9_dec_class_init (GstNullVp9DecClass * klass)
+{
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+  GstVideoDecoderClass *decoder_class = GST_VIDEO_DECODER_CLASS (klass);
+  GstVp9DecoderClass *vp9decoder_class = GST_VP9_DECODER_CLASS (klass);
+
+  gst_element_class_add_static_pad_template (element_class, &sink_template);
+  gst_element_class_add_static_pad_template (element_class, &src_template);
+
+  gst_element_class_set_static_metadata (element_class,
+      "Null VP9 decoder", "Codec/Decoder/Video",
+      "Runs the VP9 decoding process without decoding pixels",
+      "GStreamer developers <gstreamer-devel@lists.freedesktop.org>");
+
+  decoder_class->stop = GST_DEBUG_FUNCPTR (gst_null_vp9_dec_stop);
+  decoder_class->negotiate = GST_DEBUG_FUNCPTR (gst_null_vp9_dec_negotiate);
+  decoder_class->decide_allocation =
+      GST_DEBUG_FUNCPTR (gst_null_dec_decide_allocation);
+
+  vp9decoder_class->new_sequence =
+      GST_DEBUG_FUNCPTR (gst_null_vp9_dec_new_sequence);
+  vp9decoder_class->new_picture =
+      GST_DEBUG_FUNCPTR (gst_null_vp9_dec_new_picture);
+  vp9decoder_class->duplicate_picture =
+      GST_DEBUG_FUNCPTR (gst_null_vp9_dec_duplicate_picture);
+  vp9decoder_class->decode_picture =
+      GST_DEBUG_FUNCPTR (gst_null_vp9_dec_decode_picture);
+  vp9decoder_class->output_picture =
+      GST_DEBUG_FUNCPTR (gst_null_vp9_dec_output_picture);
+
+  GST_DEBUG_CATEGORY_INIT (gst_null_vp9_dec_debug, "nullvp9dec", 0,
+      "nullvp9dec");
+}
+
+static void
+gst_null_vp9_dec_init (GstNullVp9Dec * self)
+{
+  /* Real decoders need the compressed header, parse it as well */
+  GST_VP9_DECODER (self)->parse_compressed_headers = TRUE;
+}
+
+static gboolean
+gst_null_vp9_dec_stop (GstVideoDecoder * decoder)
+{
+  GstNullVp9Dec *self = GST_NULL_VP9_DEC (decoder);
+
+  gst_null_dec_state_clear (&self->state);
+
+  return GST_VIDEO_DECODER_CLASS (parent_class)->stop (decoder);
+}
+
+static gboolean
+gst_null_vp9_dec_negotiate (GstVideoDecoder * decoder)
+{
+  GstNullVp9Dec *self = GST_NULL_VP9_DEC (decoder);
+
+  if (!gst_null_dec_set_output_state (decoder, &self->state))
+    return FALSE;
+
+  return GST_VIDEO_DECODER_CLASS (parent_class)->negotiate (decoder);
+}
+
+static GstFlowReturn
+gst_null_vp9_dec_new_sequence (GstVp9Decoder * decoder,
+    const GstVp9FrameHeader * frame_hdr, gint max_dpb_size)
+{
+  GstNullVp9Dec *self = GST_NULL_VP9_DEC (decoder);
+
+  GST_DEBUG_OBJECT (self, "New sequence %ux%u, max DPB size %d",
+      frame_hdr->width, frame_hdr->height, max_dpb_size);
+
+  gst_null_dec_state_update (&self->state, decoder->input_state,
+      frame_hdr->width, frame_hdr->height,
+      GST_VIDEO_INTERLACE_MODE_PROGRESSIVE);
+
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+gst_null_vp9_dec_new_picture (GstVp9Decoder * decoder,
+    GstVideoCodecFrame * frame, GstVp9Picture * picture)
+{
+  return GST_FLOW_OK;
+}
+
+static GstVp9Picture *
+gst_null_vp9_dec_duplicate_picture (GstVp9Decoder * decoder,
+    GstVideoCodecFrame * frame, GstVp9Picture * picture)
+{
+  GstVp9Picture *new_picture;
+
+  GST_LOG_OBJECT (decoder, "Duplicating picture %p", picture);
+
+  new_picture = gst_vp9_picture_new ();
+  new_picture->frame_hdr = picture->frame_hdr;
+
+  return new_picture;
+}
+
+static GstFlowReturn
+gst_null_vp9_dec_decode_picture (GstVp9Decoder * decoder,
+    GstVp9Picture * picture, GstVp9Dpb * dpb)
+{
+  GST_TRACE_OBJECT (decoder, "Decoding picture %p", picture);
+
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+gst_null_vp9_dec_output_picture (GstVp9Decoder * decoder,
+    GstVideoCodecFrame * frame, GstVp9Picture * picture)
+{
+  GstNullVp9Dec *self = GST_NULL_VP9_DEC (decoder);
+  GstFlowReturn ret;
+
+  GST_LOG_OBJECT (self, "Outputting picture %p", picture);
+
+  /* VP9 has no picture order, pictures are output in decode order */
+  ret = gst_null_dec_finish_frame (GST_VIDEO_DECODER (decoder), &self->state,
+      frame, picture->discont_state, 0, picture->system_frame_number, 0);
+  gst_vp9_picture_unref (picture);
+
+  return ret;
+}
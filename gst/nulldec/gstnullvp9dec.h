@@ -0,0 +1,31 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+#include <gst/codecs/gstvp9decoder.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_NULL_VP9_DEC (gst_null_vp9_dec_get_type())
+G_DECLARE_FINAL_TYPE (GstNullVp9Dec, gst_null_vp9_dec,
+    GST, NULL_VP9_DEC, GstVp9Decoder);
+
+GST_ELEMENT_REGISTER_DECLARE (nullvp9dec);
+
+G_END_DECLS
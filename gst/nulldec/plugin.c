@@ -0,0 +1,67 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/**
+ * plugin-nulldec:
+ *
+ * Decoders built on top of the stateless codec base classes which run the
+ * whole decoding process except the actual pixel reconstruction.
+ *
+ * The output caps are `video/x-null-decoded` with the width, height,
+ * framerate and interlace-mode of the stream. Every output buffer is 8 bytes
+ * long and holds, in big-endian order:
+ *
+ * * a guint32 with the system frame number of the frame the picture was
+ *   decoded from, i.e. its position in decode order
+ * * a gint32 with the picture order of the picture: the picture order count
+ *   for H.264, H.265 and MPEG-2, the order hint for AV1 and 0 for VP9
+ *
+ * Since: 1.24
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstnullh264dec.h"
+#include "gstnullh265dec.h"
+#include "gstnullmpeg2dec.h"
+#include "gstnullvp9dec.h"
+#include "gstnullav1dec.h"
+
+GST_DEBUG_CATEGORY (gst_null_dec_debug);
+
+static gboolean
+plugin_init (GstPlugin * plugin)
+{
+  GST_DEBUG_CATEGORY_INIT (gst_null_dec_debug, "nulldec", 0, "nulldec");
+
+  GST_ELEMENT_REGISTER (nullh264dec, plugin);
+  GST_ELEMENT_REGISTER (nullh265dec, plugin);
+  GST_ELEMENT_REGISTER (nullmpeg2dec, plugin);
+  GST_ELEMENT_REGISTER (nullvp9dec, plugin);
+  GST_ELEMENT_REGISTER (nullav1dec, plugin);
+
+  return TRUE;
+}
+
+GST_PLUGIN_DEFINE (GST_VERSION_MAJOR,
+    GST_VERSION_MINOR,
+    nulldec,
+    "Null decoders for the stateless codec base classes",
+    plugin_init, VERSION, "LGPL", GST_PACKAGE_NAME, GST_PACKAGE_ORIGIN);
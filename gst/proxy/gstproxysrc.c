@@ -32,6 +32,10 @@
  * so everything downstream is properly decoupled from the upstream pipeline.
  * However, the queue may get filled up if the downstream pipeline does not
  * accept buffers quickly enough; perhaps because it is not yet PLAYING.
+ * The limits of that queue and what happens when it is full can be configured
+ * with the #GstProxySrc:max-size-buffers, #GstProxySrc:max-size-bytes,
+ * #GstProxySrc:max-size-time and #GstProxySrc:leaky properties, and its fill
+ * level can be read from the current-level-* properties.
  *
  * ## Usage
  * 
@@ -91,8 +95,52 @@ enum
 {
   PROP_0,
   PROP_PROXYSINK,
+  PROP_MAX_SIZE_BUFFERS,
+  PROP_MAX_SIZE_BYTES,
+  PROP_MAX_SIZE_TIME,
+  PROP_LEAKY,
+  PROP_CURRENT_LEVEL_BUFFERS,
+  PROP_CURRENT_LEVEL_BYTES,
+  PROP_CURRENT_LEVEL_TIME,
 };
 
+/* same defaults as the queue element */
+#define DEFAULT_MAX_SIZE_BUFFERS 200
+#define DEFAULT_MAX_SIZE_BYTES (10 * 1024 * 1024)
+#define DEFAULT_MAX_SIZE_TIME GST_SECOND
+#define DEFAULT_LEAKY GST_PROXY_SRC_LEAKY_NONE
+
+/**
+ * GstProxySrcLeaky:
+ * @GST_PROXY_SRC_LEAKY_NONE: Not leaky, block the proxysink when full
+ * @GST_PROXY_SRC_LEAKY_UPSTREAM: Drop new buffers when full
+ * @GST_PROXY_SRC_LEAKY_DOWNSTREAM: Drop the oldest buffers when full
+ *
+ * Since: 1.24
+ */
+#define GST_TYPE_PROXY_SRC_LEAKY (gst_proxy_src_leaky_get_type ())
+static GType
+gst_proxy_src_leaky_get_type (void)
+{
+  static gsize leaky_type = 0;
+
+  if (g_once_init_enter (&leaky_type)) {
+    static const GEnumValue leaky[] = {
+      {GST_PROXY_SRC_LEAKY_NONE, "Not Leaky", "no"},
+      {GST_PROXY_SRC_LEAKY_UPSTREAM, "Leaky on upstream (new buffers)",
+          "upstream"},
+      {GST_PROXY_SRC_LEAKY_DOWNSTREAM, "Leaky on downstream (old buffers)",
+          "downstream"},
+      {0, NULL, NULL},
+    };
+    GType type = g_enum_register_static ("GstProxySrcLeaky", leaky);
+
+    g_once_init_leave (&leaky_type, type);
+  }
+
+  return leaky_type;
+}
+
 /* We're not subclassing from basesrc because we don't want any of the special
  * handling it has for events/queries/etc. We just pass-through everything. */
 
@@ -125,6 +173,21 @@ gst_proxy_src_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_PROXYSINK:
       g_value_take_object (value, g_weak_ref_get (&self->proxysink));
       break;
+    case PROP_MAX_SIZE_BUFFERS:
+    case PROP_MAX_SIZE_BYTES:
+    case PROP_MAX_SIZE_TIME:
+    case PROP_CURRENT_LEVEL_BUFFERS:
+    case PROP_CURRENT_LEVEL_BYTES:
+    case PROP_CURRENT_LEVEL_TIME:
+      g_object_get_property (G_OBJECT (self->queue), spec->name, value);
+      break;
+    case PROP_LEAKY:{
+      gint leaky;
+
+      g_object_get (self->queue, "leaky", &leaky, NULL);
+      g_value_set_enum (value, leaky);
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, spec);
       break;
@@ -157,6 +220,14 @@ gst_proxy_src_set_property (GObject * object, guint prop_id,
         g_object_unref (sink);
       }
       break;
+    case PROP_MAX_SIZE_BUFFERS:
+    case PROP_MAX_SIZE_BYTES:
+    case PROP_MAX_SIZE_TIME:
+      g_object_set_property (G_OBJECT (self->queue), spec->name, value);
+      break;
+    case PROP_LEAKY:
+      g_object_set (self->queue, "leaky", g_value_get_enum (value), NULL);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, spec);
   }
@@ -179,12 +250,105 @@ gst_proxy_src_class_init (GstProxySrcClass * klass)
       g_param_spec_object ("proxysink", "Proxysink", "Matching proxysink",
           GST_TYPE_PROXY_SINK, G_PARAM_READWRITE));
 
+  /**
+   * GstProxySrc:max-size-buffers:
+   *
+   * Maximum number of buffers in the internal queue (0 = disable).
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_SIZE_BUFFERS,
+      g_param_spec_uint ("max-size-buffers", "Max. size (buffers)",
+          "Max. number of buffers in the queue (0=disable)", 0, G_MAXUINT,
+          DEFAULT_MAX_SIZE_BUFFERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstProxySrc:max-size-bytes:
+   *
+   * Maximum amount of data in the internal queue (0 = disable).
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_SIZE_BYTES,
+      g_param_spec_uint ("max-size-bytes", "Max. size (kB)",
+          "Max. amount of data in the queue (bytes, 0=disable)", 0, G_MAXUINT,
+          DEFAULT_MAX_SIZE_BYTES, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstProxySrc:max-size-time:
+   *
+   * Maximum amount of data in the internal queue, in nanoseconds
+   * (0 = disable).
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_SIZE_TIME,
+      g_param_spec_uint64 ("max-size-time", "Max. size (ns)",
+          "Max. amount of data in the queue (in ns, 0=disable)", 0,
+          G_MAXUINT64, DEFAULT_MAX_SIZE_TIME,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstProxySrc:leaky:
+   *
+   * What to do when the internal queue is full. By default the proxysink
+   * blocks, which applies backpressure to the upstream pipeline. When leaky,
+   * buffers are dropped instead and the upstream pipeline is never blocked
+   * by a slow downstream pipeline.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_LEAKY,
+      g_param_spec_enum ("leaky", "Leaky",
+          "Where the queue leaks, if at all", GST_TYPE_PROXY_SRC_LEAKY,
+          DEFAULT_LEAKY, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstProxySrc:current-level-buffers:
+   *
+   * Current number of buffers in the internal queue.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_CURRENT_LEVEL_BUFFERS,
+      g_param_spec_uint ("current-level-buffers", "Buffers",
+          "Current number of buffers in the queue", 0, G_MAXUINT, 0,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstProxySrc:current-level-bytes:
+   *
+   * Current amount of data in the internal queue.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_CURRENT_LEVEL_BYTES,
+      g_param_spec_uint ("current-level-bytes", "Bytes",
+          "Current amount of data in the queue (bytes)", 0, G_MAXUINT, 0,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstProxySrc:current-level-time:
+   *
+   * Current amount of data in the internal queue, in nanoseconds. This is
+   * the latency the queue currently adds between the two pipelines.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_CURRENT_LEVEL_TIME,
+      g_param_spec_uint64 ("current-level-time", "Time",
+          "Amount of data in the queue (in ns)", 0, G_MAXUINT64, 0,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state = gst_proxy_src_change_state;
   gstelement_class->send_event = gst_proxy_src_send_event;
   gstelement_class->query = gst_proxy_src_query;
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&src_template));
 
+  gst_type_mark_as_plugin_api (GST_TYPE_PROXY_SRC_LEAKY, 0);
+
   gst_element_class_set_static_metadata (gstelement_class, "Proxy source",
       "Source", "Proxy source for internal process communication",
       "Sebastian Dröge <sebastian@centricular.com>");
@@ -33,6 +33,12 @@ G_BEGIN_DECLS
 #define GST_IS_PROXY_SRC_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE((klass) , GST_TYPE_PROXY_SRC))
 #define GST_PROXY_SRC_GET_CLASS(obj)  (G_TYPE_INSTANCE_GET_CLASS((obj) , GST_TYPE_PROXY_SRC, GstProxySrcClass))
 
+typedef enum {
+  GST_PROXY_SRC_LEAKY_NONE,
+  GST_PROXY_SRC_LEAKY_UPSTREAM,
+  GST_PROXY_SRC_LEAKY_DOWNSTREAM
+} GstProxySrcLeaky;
+
 typedef struct _GstProxySrc GstProxySrc;
 typedef struct _GstProxySrcClass GstProxySrcClass;
 typedef struct _GstProxySrcPrivate GstProxySrcPrivate;
@@ -244,63 +244,55 @@ select_chunk_type (GstRtmpChunkStream * cstream, GstBuffer * buffer)
   return CHUNK_TYPE_3;
 }
 
-static GstBuffer *
-serialize_next (GstRtmpChunkStream * cstream, guint32 chunk_size,
-    ChunkType type)
+static gsize
+chunk_header_size (GstRtmpChunkStream * cstream, ChunkType type)
 {
-  GstRtmpMeta *meta = cstream->meta;
-  guint8 small_stream_id;
-  gsize header_size = chunk_header_sizes[type], offset;
-  gboolean ext_ts;
-  GstBuffer *ret;
-  GstMapInfo map;
-
-  GST_TRACE ("Serializing a chunk of type %d, offset %" G_GUINT32_FORMAT,
-      type, cstream->offset);
+  gsize header_size = chunk_header_sizes[type];
 
   if (cstream->id < CHUNK_STREAM_MIN_TWOBYTE) {
-    small_stream_id = cstream->id;
     header_size += 1;
   } else if (cstream->id < CHUNK_STREAM_MIN_THREEBYTE) {
-    small_stream_id = CHUNK_BYTE_TWOBYTE;
     header_size += 2;
   } else {
-    small_stream_id = CHUNK_BYTE_THREEBYTE;
     header_size += 3;
   }
 
-  ext_ts = needs_ext_ts (meta);
-  if (ext_ts) {
+  if (needs_ext_ts (cstream->meta)) {
     header_size += 4;
   }
 
-  GST_TRACE ("Allocating buffer, header size %" G_GSIZE_FORMAT, header_size);
+  return header_size;
+}
 
-  ret = gst_buffer_new_allocate (NULL, header_size, NULL);
-  if (!ret) {
-    GST_ERROR ("Failed to allocate chunk buffer");
-    return NULL;
-  }
+static gsize
+write_chunk_header (GstRtmpChunkStream * cstream, ChunkType type,
+    guint8 * data)
+{
+  GstRtmpMeta *meta = cstream->meta;
+  guint8 small_stream_id;
+  gsize offset;
+  gboolean ext_ts = needs_ext_ts (meta);
 
-  if (!gst_buffer_map (ret, &map, GST_MAP_WRITE)) {
-    GST_ERROR ("Failed to map %" GST_PTR_FORMAT, ret);
-    gst_buffer_unref (ret);
-    return NULL;
+  if (cstream->id < CHUNK_STREAM_MIN_TWOBYTE) {
+    small_stream_id = cstream->id;
+  } else if (cstream->id < CHUNK_STREAM_MIN_THREEBYTE) {
+    small_stream_id = CHUNK_BYTE_TWOBYTE;
+  } else {
+    small_stream_id = CHUNK_BYTE_THREEBYTE;
   }
 
   /* Chunk Basic Header */
-  GST_WRITE_UINT8 (map.data, (type << 6) | small_stream_id);
+  GST_WRITE_UINT8 (data, (type << 6) | small_stream_id);
   offset = 1;
 
   switch (small_stream_id) {
     case CHUNK_BYTE_TWOBYTE:
-      GST_WRITE_UINT8 (map.data + 1, cstream->id - CHUNK_STREAM_MIN_TWOBYTE);
+      GST_WRITE_UINT8 (data + 1, cstream->id - CHUNK_STREAM_MIN_TWOBYTE);
       offset += 1;
       break;
 
     case CHUNK_BYTE_THREEBYTE:
-      GST_WRITE_UINT16_LE (map.data + 1,
-          cstream->id - CHUNK_STREAM_MIN_TWOBYTE);
+      GST_WRITE_UINT16_LE (data + 1, cstream->id - CHUNK_STREAM_MIN_TWOBYTE);
       offset += 2;
       break;
   }
@@ -308,50 +300,97 @@ serialize_next (GstRtmpChunkStream * cstream, guint32 chunk_size,
   switch (type) {
     case CHUNK_TYPE_0:
       /* SRSLY:  "Message stream ID is stored in little-endian format." */
-      GST_WRITE_UINT32_LE (map.data + offset + 7, meta->mstream);
+      GST_WRITE_UINT32_LE (data + offset + 7, meta->mstream);
       /* no break */
     case CHUNK_TYPE_1:
-      GST_WRITE_UINT24_BE (map.data + offset + 3, meta->size);
-      GST_WRITE_UINT8 (map.data + offset + 6, meta->type);
+      GST_WRITE_UINT24_BE (data + offset + 3, meta->size);
+      GST_WRITE_UINT8 (data + offset + 6, meta->type);
       /* no break */
     case CHUNK_TYPE_2:
-      GST_WRITE_UINT24_BE (map.data + offset,
-          ext_ts ? 0xffffff : meta->ts_delta);
+      GST_WRITE_UINT24_BE (data + offset, ext_ts ? 0xffffff : meta->ts_delta);
       /* no break */
     case CHUNK_TYPE_3:
       offset += chunk_header_sizes[type];
 
       if (ext_ts) {
-        GST_WRITE_UINT32_BE (map.data + offset, meta->ts_delta);
+        GST_WRITE_UINT32_BE (data + offset, meta->ts_delta);
         offset += 4;
       }
   }
 
-  g_assert (offset == header_size);
-  GST_MEMDUMP (">>> chunk header", map.data, offset);
+  g_assert (offset == chunk_header_size (cstream, type));
+  GST_MEMDUMP (">>> chunk header", data, offset);
 
-  gst_buffer_unmap (ret, &map);
+  return offset;
+}
+
+/* Appends the next chunk's payload to @chunk as memory shared with the
+ * message buffer; no payload bytes are copied. */
+static void
+append_next_payload (GstRtmpChunkStream * cstream, guint32 chunk_size,
+    GstBuffer * chunk)
+{
+  guint32 payload_size;
+
+  if (cstream->meta->size == 0) {
+    GST_TRACE ("Chunk has no payload");
+    return;
+  }
 
-  GST_BUFFER_OFFSET (ret) = GST_BUFFER_OFFSET_IS_VALID (cstream->buffer) ?
+  payload_size = chunk_stream_next_size (cstream, chunk_size);
+
+  GST_TRACE ("Appending %" G_GUINT32_FORMAT " bytes of payload",
+      payload_size);
+
+  gst_buffer_copy_into (chunk, cstream->buffer, GST_BUFFER_COPY_MEMORY,
+      cstream->offset, payload_size);
+
+  GST_BUFFER_OFFSET_END (chunk) += payload_size;
+  cstream->offset += payload_size;
+  cstream->bytes += payload_size;
+}
+
+static guint64
+chunk_stream_out_offset (GstRtmpChunkStream * cstream)
+{
+  return GST_BUFFER_OFFSET_IS_VALID (cstream->buffer) ?
       GST_BUFFER_OFFSET (cstream->buffer) + cstream->offset : cstream->bytes;
-  GST_BUFFER_OFFSET_END (ret) = GST_BUFFER_OFFSET (ret);
+}
+
+static GstBuffer *
+serialize_next (GstRtmpChunkStream * cstream, guint32 chunk_size,
+    ChunkType type)
+{
+  gsize header_size = chunk_header_size (cstream, type);
+  GstBuffer *ret;
+  GstMapInfo map;
 
-  if (meta->size > 0) {
-    guint32 payload_size = chunk_stream_next_size (cstream, chunk_size);
+  GST_TRACE ("Serializing a chunk of type %d, offset %" G_GUINT32_FORMAT,
+      type, cstream->offset);
 
-    GST_TRACE ("Appending %" G_GUINT32_FORMAT " bytes of payload",
-        payload_size);
+  GST_TRACE ("Allocating buffer, header size %" G_GSIZE_FORMAT, header_size);
 
-    gst_buffer_copy_into (ret, cstream->buffer, GST_BUFFER_COPY_MEMORY,
-        cstream->offset, payload_size);
+  ret = gst_buffer_new_allocate (NULL, header_size, NULL);
+  if (!ret) {
+    GST_ERROR ("Failed to allocate chunk buffer");
+    return NULL;
+  }
 
-    GST_BUFFER_OFFSET_END (ret) += payload_size;
-    cstream->offset += payload_size;
-    cstream->bytes += payload_size;
-  } else {
-    GST_TRACE ("Chunk has no payload");
+  if (!gst_buffer_map (ret, &map, GST_MAP_WRITE)) {
+    GST_ERROR ("Failed to map %" GST_PTR_FORMAT, ret);
+    gst_buffer_unref (ret);
+    return NULL;
   }
 
+  write_chunk_header (cstream, type, map.data);
+
+  gst_buffer_unmap (ret, &map);
+
+  GST_BUFFER_OFFSET (ret) = chunk_stream_out_offset (cstream);
+  GST_BUFFER_OFFSET_END (ret) = GST_BUFFER_OFFSET (ret);
+
+  append_next_payload (cstream, chunk_size, ret);
+
   gst_rtmp_buffer_dump (ret, ">>> chunk");
 
   return ret;
@@ -666,21 +705,91 @@ gst_rtmp_chunk_stream_serialize_next (GstRtmpChunkStream * cstream,
   return serialize_next (cstream, chunk_size, CHUNK_TYPE_3);
 }
 
-GstBuffer *
+/* Serializes the whole message at once, one buffer per chunk. All chunk
+ * headers are written into a single small memory that is shared into each
+ * chunk buffer in front of its payload, which is itself shared with
+ * @buffer. Keeping the chunks apart bounds the number of memories per
+ * buffer, so none of them gets merged before the vectored write. */
+GstBufferList *
 gst_rtmp_chunk_stream_serialize_all (GstRtmpChunkStream * cstream,
     GstBuffer * buffer, guint32 chunk_size)
 {
-  GstBuffer *outbuf, *nextbuf;
+  GstMemory *headers;
+  GstMapInfo map;
+  GstBufferList *ret;
+  ChunkType type;
+  gsize first_size, next_size, headers_size, offset;
+  guint32 num_chunks, i;
 
-  outbuf = gst_rtmp_chunk_stream_serialize_start (cstream, buffer, chunk_size);
-  nextbuf = gst_rtmp_chunk_stream_serialize_next (cstream, chunk_size);
+  g_return_val_if_fail (cstream, NULL);
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), NULL);
+  g_return_val_if_fail (chunk_size, NULL);
 
-  while (nextbuf) {
-    outbuf = gst_buffer_append (outbuf, nextbuf);
-    nextbuf = gst_rtmp_chunk_stream_serialize_next (cstream, chunk_size);
+  type = select_chunk_type (cstream, buffer);
+  g_return_val_if_fail (type >= 0, NULL);
+
+  GST_TRACE ("Serializing message %" GST_PTR_FORMAT " into stream %"
+      G_GUINT32_FORMAT, buffer, cstream->id);
+
+  gst_rtmp_buffer_dump (buffer, ">>> message");
+
+  chunk_stream_clear (cstream);
+  chunk_stream_take_buffer (cstream, gst_buffer_ref (buffer));
+
+  num_chunks = cstream->meta->size > 0 ?
+      (cstream->meta->size - 1) / chunk_size + 1 : 1;
+  first_size = chunk_header_size (cstream, type);
+  next_size = chunk_header_size (cstream, CHUNK_TYPE_3);
+  headers_size = first_size + (num_chunks - 1) * next_size;
+
+  GST_TRACE ("Allocating %" G_GUINT32_FORMAT " chunk headers, %"
+      G_GSIZE_FORMAT " bytes", num_chunks, headers_size);
+
+  headers = gst_allocator_alloc (NULL, headers_size, NULL);
+  if (!headers) {
+    GST_ERROR ("Failed to allocate chunk headers");
+    return NULL;
+  }
+
+  if (!gst_memory_map (headers, &map, GST_MAP_WRITE)) {
+    GST_ERROR ("Failed to map chunk headers");
+    gst_memory_unref (headers);
+    return NULL;
   }
 
-  return outbuf;
+  offset = write_chunk_header (cstream, type, map.data);
+  for (i = 1; i < num_chunks; i++) {
+    offset += write_chunk_header (cstream, CHUNK_TYPE_3, map.data + offset);
+  }
+
+  g_assert (offset == headers_size);
+  gst_memory_unmap (headers, &map);
+
+  ret = gst_buffer_list_new_sized (num_chunks);
+
+  offset = 0;
+  for (i = 0; i < num_chunks; i++) {
+    gsize header_size = i == 0 ? first_size : next_size;
+    GstBuffer *chunk = gst_buffer_new ();
+
+    GST_BUFFER_OFFSET (chunk) = chunk_stream_out_offset (cstream);
+    GST_BUFFER_OFFSET_END (chunk) = GST_BUFFER_OFFSET (chunk);
+
+    gst_buffer_append_memory (chunk,
+        gst_memory_share (headers, offset, header_size));
+    offset += header_size;
+
+    append_next_payload (cstream, chunk_size, chunk);
+
+    gst_rtmp_buffer_dump (chunk, ">>> chunk");
+    gst_buffer_list_add (ret, chunk);
+  }
+
+  gst_memory_unref (headers);
+
+  g_assert (chunk_stream_next_size (cstream, chunk_size) == 0);
+
+  return ret;
 }
 
 GstRtmpChunkStreams *
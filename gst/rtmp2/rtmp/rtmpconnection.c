@@ -519,7 +519,8 @@ static void
 gst_rtmp_connection_start_write (GstRtmpConnection * self)
 {
   GOutputStream *os;
-  GstBuffer *message, *chunks;
+  GstBuffer *message;
+  GstBufferList *chunks;
   GstRtmpMeta *meta;
   GstRtmpChunkStream *cstream;
 
@@ -566,11 +567,11 @@ gst_rtmp_connection_start_write (GstRtmpConnection * self)
   }
 
   os = g_io_stream_get_output_stream (G_IO_STREAM (self->connection));
-  gst_rtmp_output_stream_write_all_buffer_async (os, chunks, G_PRIORITY_DEFAULT,
-      self->cancellable, gst_rtmp_connection_write_buffer_done,
-      g_object_ref (self));
+  gst_rtmp_output_stream_write_all_buffer_list_async (os, chunks,
+      G_PRIORITY_DEFAULT, self->cancellable,
+      gst_rtmp_connection_write_buffer_done, g_object_ref (self));
 
-  gst_buffer_unref (chunks);
+  gst_buffer_list_unref (chunks);
 
 out:
   gst_buffer_unref (message);
@@ -600,7 +601,7 @@ gst_rtmp_connection_write_buffer_done (GObject * obj,
 
   self->writing = FALSE;
 
-  res = gst_rtmp_output_stream_write_all_buffer_finish (os, result,
+  res = gst_rtmp_output_stream_write_all_buffer_list_finish (os, result,
       &bytes_written, &error);
 
   g_mutex_lock (&self->stats_lock);
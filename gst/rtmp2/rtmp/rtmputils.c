@@ -158,60 +158,125 @@ gst_rtmp_output_stream_write_all_bytes_finish (GOutputStream * stream,
 
 typedef struct
 {
-  GstBuffer *buffer;
-  GstMapInfo map;
-  gboolean mapped;
+  GstBufferList *list;
+  GstMapInfo *maps;
+  GOutputVector *vectors;
+  guint n_vectors;
+  guint n_mapped;
   gsize bytes_written;
 } WriteAllBufferData;
 
 static WriteAllBufferData *
-write_all_buffer_data_new (GstBuffer * buffer)
+write_all_buffer_data_new (GstBufferList * list)
 {
   WriteAllBufferData *data = g_slice_new0 (WriteAllBufferData);
-  data->buffer = gst_buffer_ref (buffer);
+  guint i, len = gst_buffer_list_length (list);
+
+  for (i = 0; i < len; i++) {
+    data->n_vectors += gst_buffer_n_memory (gst_buffer_list_get (list, i));
+  }
+
+  data->list = list;
+  data->maps = g_new0 (GstMapInfo, data->n_vectors);
+  data->vectors = g_new0 (GOutputVector, data->n_vectors);
   return data;
 }
 
+static void
+write_all_buffer_data_unmap (WriteAllBufferData * data)
+{
+  guint i;
+
+  for (i = 0; i < data->n_mapped; i++) {
+    gst_memory_unmap (data->maps[i].memory, &data->maps[i]);
+  }
+
+  data->n_mapped = 0;
+}
+
 static void
 write_all_buffer_data_free (gpointer ptr)
 {
   WriteAllBufferData *data = ptr;
-  if (data->mapped) {
-    gst_buffer_unmap (data->buffer, &data->map);
-  }
-  g_clear_pointer (&data->buffer, gst_buffer_unref);
+  write_all_buffer_data_unmap (data);
+  g_clear_pointer (&data->maps, g_free);
+  g_clear_pointer (&data->vectors, g_free);
+  g_clear_pointer (&data->list, gst_buffer_list_unref);
   g_slice_free (WriteAllBufferData, data);
 }
 
-void
-gst_rtmp_output_stream_write_all_buffer_async (GOutputStream * stream,
-    GstBuffer * buffer, int io_priority, GCancellable * cancellable,
+/* Writes all memories of @list with a single vectored write instead of
+ * mapping (and thereby merging) each buffer, so chunk payloads that share
+ * memory with the original message are never copied. */
+static void
+write_all_buffer_list (GOutputStream * stream, GstBufferList * list,
+    int io_priority, GCancellable * cancellable,
     GAsyncReadyCallback callback, gpointer user_data)
 {
   GTask *task;
   WriteAllBufferData *data;
-
-  g_return_if_fail (G_IS_OUTPUT_STREAM (stream));
-  g_return_if_fail (GST_IS_BUFFER (buffer));
+  guint i, j, len;
 
   task = g_task_new (stream, cancellable, callback, user_data);
 
-  data = write_all_buffer_data_new (buffer);
+  data = write_all_buffer_data_new (list);
   g_task_set_task_data (task, data, write_all_buffer_data_free);
 
-  if (!gst_buffer_map (buffer, &data->map, GST_MAP_READ)) {
-    g_task_return_new_error (task, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_READ,
-        "Failed to map buffer for reading");
-    g_object_unref (task);
-    return;
-  }
+  len = gst_buffer_list_length (list);
+  for (i = 0; i < len; i++) {
+    GstBuffer *buffer = gst_buffer_list_get (list, i);
+    guint n_memory = gst_buffer_n_memory (buffer);
+
+    for (j = 0; j < n_memory; j++) {
+      GstMemory *mem = gst_buffer_peek_memory (buffer, j);
+      GstMapInfo *map = &data->maps[data->n_mapped];
 
-  data->mapped = TRUE;
+      if (!gst_memory_map (mem, map, GST_MAP_READ)) {
+        g_task_return_new_error (task, GST_RESOURCE_ERROR,
+            GST_RESOURCE_ERROR_READ, "Failed to map memory for reading");
+        g_object_unref (task);
+        return;
+      }
+
+      data->vectors[data->n_mapped].buffer = map->data;
+      data->vectors[data->n_mapped].size = map->size;
+      data->n_mapped++;
+    }
+  }
 
-  g_output_stream_write_all_async (stream, data->map.data, data->map.size,
+  g_output_stream_writev_all_async (stream, data->vectors, data->n_vectors,
       io_priority, cancellable, write_all_buffer_done, task);
 }
 
+void
+gst_rtmp_output_stream_write_all_buffer_async (GOutputStream * stream,
+    GstBuffer * buffer, int io_priority, GCancellable * cancellable,
+    GAsyncReadyCallback callback, gpointer user_data)
+{
+  GstBufferList *list;
+
+  g_return_if_fail (G_IS_OUTPUT_STREAM (stream));
+  g_return_if_fail (GST_IS_BUFFER (buffer));
+
+  list = gst_buffer_list_new_sized (1);
+  gst_buffer_list_add (list, gst_buffer_ref (buffer));
+
+  write_all_buffer_list (stream, list, io_priority, cancellable, callback,
+      user_data);
+}
+
+void
+gst_rtmp_output_stream_write_all_buffer_list_async (GOutputStream * stream,
+    GstBufferList * list, int io_priority, GCancellable * cancellable,
+    GAsyncReadyCallback callback, gpointer user_data)
+{
+  g_return_if_fail (G_IS_OUTPUT_STREAM (stream));
+  g_return_if_fail (GST_IS_BUFFER_LIST (list));
+
+  write_all_buffer_list (stream, gst_buffer_list_ref (list), io_priority,
+      cancellable, callback, user_data);
+}
+
 static void
 write_all_buffer_done (GObject * source, GAsyncResult * result,
     gpointer user_data)
@@ -222,11 +287,10 @@ write_all_buffer_done (GObject * source, GAsyncResult * result,
   GError *error = NULL;
   gboolean res;
 
-  res = g_output_stream_write_all_finish (os, result, &data->bytes_written,
+  res = g_output_stream_writev_all_finish (os, result, &data->bytes_written,
       &error);
 
-  gst_buffer_unmap (data->buffer, &data->map);
-  data->mapped = FALSE;
+  write_all_buffer_data_unmap (data);
 
   if (!res) {
     g_task_return_error (task, error);
@@ -257,6 +321,14 @@ gst_rtmp_output_stream_write_all_buffer_finish (GOutputStream * stream,
   return g_task_propagate_boolean (task, error);
 }
 
+gboolean
+gst_rtmp_output_stream_write_all_buffer_list_finish (GOutputStream * stream,
+    GAsyncResult * result, gsize * bytes_written, GError ** error)
+{
+  return gst_rtmp_output_stream_write_all_buffer_finish (stream, result,
+      bytes_written, error);
+}
+
 static const gchar ascii_table[128] = {
   0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
   0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
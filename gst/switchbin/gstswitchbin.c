@@ -35,6 +35,15 @@
  * is TRUE, path \#0 is picked. Otherwise, path \#1's caps are looked at etc.
  * If no path matches, an error is reported.
  *
+ * By default, the element of a path that stops being the current one is
+ * shut down to the NULL state, so switching back to it later has to
+ * initialize it again. With #GstSwitchBin:standby-state set to READY or
+ * PAUSED, the most recently used paths (up to
+ * #GstSwitchBin:max-standby-paths of them) are instead kept in that state
+ * while they are not current, and switching to one of them only has to
+ * link it and bring it to the switchbin's state. Paths that have not been
+ * used yet are kept in standby in path order.
+ *
  * <refsect2>
  * <title>Example launch line</title>
  *
@@ -71,10 +80,14 @@ enum
   PROP_0,
   PROP_NUM_PATHS,
   PROP_CURRENT_PATH,
+  PROP_STANDBY_STATE,
+  PROP_MAX_STANDBY_PATHS,
   PROP_LAST
 };
 
 #define DEFAULT_NUM_PATHS 0
+#define DEFAULT_STANDBY_STATE GST_STATE_NULL
+#define DEFAULT_MAX_STANDBY_PATHS G_MAXUINT
 GParamSpec *switchbin_props[PROP_LAST];
 
 #define PATH_LOCK(obj) g_mutex_lock(&(GST_SWITCH_BIN_CAST (obj)->path_mutex))
@@ -122,6 +135,8 @@ static void gst_switch_bin_set_property (GObject * object, guint prop_id,
     GValue const *value, GParamSpec * pspec);
 static void gst_switch_bin_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
+static GstStateChangeReturn gst_switch_bin_change_state (GstElement * element,
+    GstStateChange transition);
 
 static gboolean gst_switch_bin_sink_event (GstPad * pad,
     GstObject * parent, GstEvent * event);
@@ -138,6 +153,10 @@ static gboolean gst_switch_bin_switch_to_path (GstSwitchBin * switch_bin,
     GstSwitchBinPath * switch_bin_path);
 static GstSwitchBinPath *gst_switch_bin_find_matching_path (GstSwitchBin *
     switch_bin, GstCaps const *caps);
+static void gst_switch_bin_flush_path_element (GstSwitchBin * switch_bin,
+    GstElement * element);
+static void gst_switch_bin_update_standby_paths (GstSwitchBin * switch_bin,
+    GstState max_state);
 
 static void gst_switch_bin_set_sinkpad_block (GstSwitchBin * switch_bin,
     gboolean do_block);
@@ -230,6 +249,8 @@ gst_switch_bin_class_init (GstSwitchBinClass * klass)
   object_class->set_property = GST_DEBUG_FUNCPTR (gst_switch_bin_set_property);
   object_class->get_property = GST_DEBUG_FUNCPTR (gst_switch_bin_get_property);
 
+  element_class->change_state = GST_DEBUG_FUNCPTR (gst_switch_bin_change_state);
+
   /**
    * GstSwitchBin:num-paths
    *
@@ -257,6 +278,43 @@ gst_switch_bin_class_init (GstSwitchBinClass * klass)
   g_object_class_install_property (object_class,
       PROP_CURRENT_PATH, switchbin_props[PROP_CURRENT_PATH]);
 
+  /**
+   * GstSwitchBin:standby-state
+   *
+   * State in which the elements of paths that are not the current one are
+   * kept. With NULL, a path element is shut down when its path stops being
+   * the current one. With READY or PAUSED, path elements stay initialized,
+   * which makes switching to their path cheaper. Higher states than PAUSED
+   * are not allowed. The standby state never exceeds the switchbin's own
+   * state.
+   *
+   * Since: 1.24
+   */
+  switchbin_props[PROP_STANDBY_STATE] =
+      g_param_spec_enum ("standby-state", "Standby State",
+      "State of the elements of paths that are not current", GST_TYPE_STATE,
+      DEFAULT_STANDBY_STATE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+  g_object_class_install_property (object_class,
+      PROP_STANDBY_STATE, switchbin_props[PROP_STANDBY_STATE]);
+
+  /**
+   * GstSwitchBin:max-standby-paths
+   *
+   * Maximum number of non-current paths whose elements are kept in the
+   * #GstSwitchBin:standby-state. The most recently used paths are picked
+   * first, then paths that have not been used yet in path order. The
+   * elements of all other paths are shut down to the NULL state.
+   *
+   * Since: 1.24
+   */
+  switchbin_props[PROP_MAX_STANDBY_PATHS] =
+      g_param_spec_uint ("max-standby-paths", "Max Standby Paths",
+      "Maximum number of non-current paths kept in the standby state",
+      0, G_MAXUINT, DEFAULT_MAX_STANDBY_PATHS,
+      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+  g_object_class_install_property (object_class,
+      PROP_MAX_STANDBY_PATHS, switchbin_props[PROP_MAX_STANDBY_PATHS]);
+
   gst_element_class_set_static_metadata (element_class,
       "switchbin",
       "Generic/Bin",
@@ -277,6 +335,9 @@ gst_switch_bin_init (GstSwitchBin * switch_bin)
   switch_bin->blocking_probe_id = 0;
   switch_bin->drop_probe_id = 0;
   switch_bin->last_caps = NULL;
+  switch_bin->standby_state = DEFAULT_STANDBY_STATE;
+  switch_bin->max_standby_paths = DEFAULT_MAX_STANDBY_PATHS;
+  switch_bin->path_use_counter = 0;
 
   switch_bin->sinkpad = gst_ghost_pad_new_no_target_from_template ("sink",
       gst_element_class_get_pad_template (GST_ELEMENT_GET_CLASS (switch_bin),
@@ -353,6 +414,30 @@ gst_switch_bin_set_property (GObject * object, guint prop_id,
       PATH_UNLOCK_AND_CHECK (switch_bin);
       break;
 
+    case PROP_STANDBY_STATE:
+    {
+      GstState standby_state = g_value_get_enum (value);
+
+      if (standby_state > GST_STATE_PAUSED) {
+        GST_WARNING_OBJECT (switch_bin, "standby state %s is not allowed, "
+            "using PAUSED", gst_element_state_get_name (standby_state));
+        standby_state = GST_STATE_PAUSED;
+      }
+
+      PATH_LOCK (switch_bin);
+      switch_bin->standby_state = standby_state;
+      gst_switch_bin_update_standby_paths (switch_bin, GST_STATE (switch_bin));
+      PATH_UNLOCK (switch_bin);
+      break;
+    }
+
+    case PROP_MAX_STANDBY_PATHS:
+      PATH_LOCK (switch_bin);
+      switch_bin->max_standby_paths = g_value_get_uint (value);
+      gst_switch_bin_update_standby_paths (switch_bin, GST_STATE (switch_bin));
+      PATH_UNLOCK (switch_bin);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -387,6 +472,16 @@ gst_switch_bin_get_property (GObject * object, guint prop_id, GValue * value,
       }
       PATH_UNLOCK (switch_bin);
       break;
+    case PROP_STANDBY_STATE:
+      PATH_LOCK (switch_bin);
+      g_value_set_enum (value, switch_bin->standby_state);
+      PATH_UNLOCK (switch_bin);
+      break;
+    case PROP_MAX_STANDBY_PATHS:
+      PATH_LOCK (switch_bin);
+      g_value_set_uint (value, switch_bin->max_standby_paths);
+      PATH_UNLOCK (switch_bin);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -394,6 +489,49 @@ gst_switch_bin_get_property (GObject * object, guint prop_id, GValue * value,
 }
 
 
+static GstStateChangeReturn
+gst_switch_bin_change_state (GstElement * element, GstStateChange transition)
+{
+  GstSwitchBin *switch_bin = GST_SWITCH_BIN (element);
+  GstStateChangeReturn ret;
+
+  /* Path elements that are not current have a locked state, so the bin
+   * does not change their state. Bring standby elements down before the
+   * switchbin goes down, and up once it went up. */
+  switch (transition) {
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+    case GST_STATE_CHANGE_READY_TO_NULL:
+      PATH_LOCK (switch_bin);
+      gst_switch_bin_update_standby_paths (switch_bin,
+          GST_STATE_TRANSITION_NEXT (transition));
+      PATH_UNLOCK (switch_bin);
+      break;
+    default:
+      break;
+  }
+
+  ret =
+      GST_ELEMENT_CLASS (gst_switch_bin_parent_class)->change_state (element,
+      transition);
+  if (ret == GST_STATE_CHANGE_FAILURE)
+    return ret;
+
+  switch (transition) {
+    case GST_STATE_CHANGE_NULL_TO_READY:
+    case GST_STATE_CHANGE_READY_TO_PAUSED:
+      PATH_LOCK (switch_bin);
+      gst_switch_bin_update_standby_paths (switch_bin,
+          GST_STATE_TRANSITION_NEXT (transition));
+      PATH_UNLOCK (switch_bin);
+      break;
+    default:
+      break;
+  }
+
+  return ret;
+}
+
+
 static gboolean
 gst_switch_bin_sink_event (GstPad * pad, GstObject * parent, GstEvent * event)
 {
@@ -701,12 +839,27 @@ gst_switch_bin_switch_to_path (GstSwitchBin * switch_bin,
   if (switch_bin->current_path != NULL) {
     GstSwitchBinPath *cur_path = switch_bin->current_path;
 
+    /* Detach the element from the srcpad first, so that flushing it below
+     * does not reach downstream */
+    gst_ghost_pad_set_target (GST_GHOST_PAD (switch_bin->srcpad), NULL);
+
     if (cur_path->element != NULL) {
-      gst_element_set_state (cur_path->element, GST_STATE_NULL);
+      GstState standby_state = GST_STATE_NULL;
+
+      /* The path was just used, so it is the first to be kept in standby */
+      if (switch_bin->max_standby_paths > 0)
+        standby_state = MIN (switch_bin->standby_state,
+            GST_STATE (switch_bin));
+
+      gst_element_set_locked_state (cur_path->element, TRUE);
+      gst_element_set_state (cur_path->element, standby_state);
       gst_element_unlink (switch_bin->input_identity, cur_path->element);
-    }
 
-    gst_ghost_pad_set_target (GST_GHOST_PAD (switch_bin->srcpad), NULL);
+      /* Discard any data the element still holds, so it does not come out
+       * once the path is current again */
+      if (standby_state == GST_STATE_PAUSED)
+        gst_switch_bin_flush_path_element (switch_bin, cur_path->element);
+    }
 
     switch_bin->current_path = NULL;
     switch_bin->path_changed = TRUE;
@@ -789,6 +942,10 @@ gst_switch_bin_switch_to_path (GstSwitchBin * switch_bin,
   switch_bin->current_path = switch_bin_path;
   switch_bin->path_changed = TRUE;
 
+  if (switch_bin_path != NULL)
+    switch_bin_path->last_used = ++switch_bin->path_use_counter;
+  gst_switch_bin_update_standby_paths (switch_bin, GST_STATE (switch_bin));
+
   /* If there is a new path to use, unblock the input */
   if (switch_bin_path != NULL)
     gst_switch_bin_set_sinkpad_block (switch_bin, FALSE);
@@ -816,6 +973,92 @@ gst_switch_bin_find_matching_path (GstSwitchBin * switch_bin,
 }
 
 
+static void
+gst_switch_bin_flush_path_element (GstSwitchBin * switch_bin,
+    GstElement * element)
+{
+  GstPad *pad;
+
+  pad = gst_element_get_static_pad (element, "sink");
+  if (pad == NULL)
+    return;
+
+  GST_DEBUG_OBJECT (switch_bin, "flushing standby path element %"
+      GST_PTR_FORMAT, (gpointer) element);
+
+  gst_pad_send_event (pad, gst_event_new_flush_start ());
+  gst_pad_send_event (pad, gst_event_new_flush_stop (TRUE));
+
+  gst_object_unref (GST_OBJECT (pad));
+}
+
+
+static gint
+gst_switch_bin_compare_standby_paths (gconstpointer a, gconstpointer b,
+    gpointer user_data)
+{
+  GstSwitchBin *switch_bin = user_data;
+  guint index_a = *((guint const *) a);
+  guint index_b = *((guint const *) b);
+  guint64 last_used_a = switch_bin->paths[index_a]->last_used;
+  guint64 last_used_b = switch_bin->paths[index_b]->last_used;
+
+  /* Most recently used paths first, then unused paths in path order */
+  if (last_used_a != last_used_b)
+    return (last_used_a > last_used_b) ? -1 : 1;
+
+  return (index_a < index_b) ? -1 : ((index_a > index_b) ? 1 : 0);
+}
+
+
+static void
+gst_switch_bin_update_standby_paths (GstSwitchBin * switch_bin,
+    GstState max_state)
+{
+  /* must be called with path lock held */
+
+  guint i, num_standby;
+  guint *order;
+  GstState standby_state;
+
+  if (switch_bin->num_paths == 0)
+    return;
+
+  standby_state = MIN (switch_bin->standby_state, max_state);
+
+  order = g_new (guint, switch_bin->num_paths);
+  for (i = 0; i < switch_bin->num_paths; ++i)
+    order[i] = i;
+  g_qsort_with_data (order, switch_bin->num_paths, sizeof (guint),
+      gst_switch_bin_compare_standby_paths, switch_bin);
+
+  num_standby = 0;
+  for (i = 0; i < switch_bin->num_paths; ++i) {
+    GstSwitchBinPath *path = switch_bin->paths[order[i]];
+    GstState state;
+
+    if (path == switch_bin->current_path || path->element == NULL)
+      continue;
+
+    if (num_standby < switch_bin->max_standby_paths) {
+      state = standby_state;
+      num_standby++;
+    } else {
+      state = GST_STATE_NULL;
+    }
+
+    if (GST_STATE (path->element) != state
+        || GST_STATE_PENDING (path->element) != GST_STATE_VOID_PENDING) {
+      GST_DEBUG_OBJECT (switch_bin, "setting element of path \"%s\" to %s",
+          GST_OBJECT_NAME (path), gst_element_state_get_name (state));
+      gst_element_set_state (path->element, state);
+    }
+  }
+
+  g_free (order);
+}
+
+
 static GstCaps *
 gst_switch_bin_get_allowed_caps (GstSwitchBin * switch_bin,
     GstPad * switch_bin_pad, gchar const *pad_name, GstCaps * filter)
@@ -1172,6 +1415,10 @@ gst_switch_bin_path_use_new_element (GstSwitchBinPath * switch_bin_path,
     gst_element_set_locked_state (new_element, TRUE);
   }
 
+  if (!is_current_path)
+    gst_switch_bin_update_standby_paths (switch_bin_path->bin,
+        GST_STATE (switch_bin_path->bin));
+
   /* We are done. Switch back to the path if it is the current one,
    * since we switched away from it earlier. */
   if (is_current_path)
@@ -60,6 +60,10 @@ struct _GstSwitchBin
 	gulong blocking_probe_id, drop_probe_id;
 
 	GstCaps *last_caps;
+
+	GstState standby_state;
+	guint max_standby_paths;
+	guint64 path_use_counter;
 };
 
 
@@ -76,6 +80,7 @@ struct _GstSwitchBinPath
 	GstElement *element;
 	GstCaps *caps;
 	GstSwitchBin *bin;
+	guint64 last_used;
 };
 
 
@@ -115,6 +115,8 @@ struct _GstAV1Parse
   GstAV1ParseAligment align;
 
   GstAV1Parser *parser;
+  /* GstAV1OBUIndexEntry of the buffer being split */
+  GArray *obu_index;
   GstAdapter *cache_out;
   guint last_parsed_offset;
   GstAdapter *frame_cache;
@@ -335,6 +337,8 @@ gst_av1_parse_init (GstAV1Parse * self)
 
   self->cache_out = gst_adapter_new ();
   self->frame_cache = gst_adapter_new ();
+  self->obu_index = g_array_sized_new (FALSE, FALSE,
+      sizeof (GstAV1OBUIndexEntry), 8);
 }
 
 static void
@@ -345,6 +349,7 @@ gst_av1_parse_finalize (GObject * object)
   gst_av1_parse_reset (self);
   g_object_unref (self->cache_out);
   g_object_unref (self->frame_cache);
+  g_array_unref (self->obu_index);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -1166,7 +1171,7 @@ gst_av1_parse_convert_from_annexb (GstAV1Parse * self, GstBuffer * buffer,
 
 static void
 gst_av1_parse_cache_one_obu (GstAV1Parse * self, GstBuffer * buffer,
-    GstAV1OBU * obu, guint8 * data, guint32 size, gboolean frame_complete)
+    GstAV1OBU * obu, guint32 offset, guint32 size, gboolean frame_complete)
 {
   gboolean need_convert = FALSE;
   GstBuffer *buf;
@@ -1186,7 +1191,9 @@ gst_av1_parse_cache_one_obu (GstAV1Parse * self, GstBuffer * buffer,
     g_assert (self->in_align == GST_AV1_PARSE_ALIGN_TEMPORAL_UNIT_ANNEX_B);
     gst_av1_parse_convert_to_annexb (self, buffer, obu, frame_complete);
   } else {
-    buf = gst_buffer_new_memdup (data, size);
+    /* Share the memory of the input buffer, no need to copy the OBU */
+    buf = gst_buffer_copy_region (buffer, GST_BUFFER_COPY_MEMORY, offset,
+        size);
     GST_BUFFER_PTS (buf) = GST_BUFFER_PTS (buffer);
     GST_BUFFER_DTS (buf) = GST_BUFFER_DTS (buffer);
     GST_BUFFER_DURATION (buf) = GST_BUFFER_DURATION (buffer);
@@ -1208,6 +1215,10 @@ gst_av1_parse_handle_sequence_obu (GstAV1Parse * self, GstAV1OBU * obu)
   if (res != GST_AV1_PARSER_OK)
     return res;
 
+  /* a repeated identical sequence header can't change the caps */
+  if (!gst_av1_parser_last_sequence_header_changed (self->parser))
+    goto done;
+
   if (self->width != seq_header.max_frame_width_minus_1 + 1) {
     self->width = seq_header.max_frame_width_minus_1 + 1;
     self->update_caps = TRUE;
@@ -1270,6 +1281,7 @@ gst_av1_parse_handle_sequence_obu (GstAV1Parse * self, GstAV1OBU * obu)
     self->update_caps = TRUE;
   }
 
+done:
   val = (self->parser->state.operating_point_idc >> 8) & 0x0f;
   for (i = 0; i < (1 << GST_AV1_MAX_SPATIAL_LAYERS); i++) {
     if (val & (1 << i))
@@ -1598,13 +1610,13 @@ gst_av1_parse_handle_to_small_and_equal_align (GstBaseParse * parse,
 {
   GstAV1Parse *self = GST_AV1_PARSE (parse);
   GstMapInfo map_info;
-  GstAV1OBU obu;
   GstFlowReturn ret = GST_FLOW_OK;
   GstAV1ParserResult res = GST_AV1_PARSER_INVALID_OPERATION;
   GstBuffer *buffer = gst_buffer_ref (frame->buffer);
   guint32 offset, consumed_before_push, consumed;
   gboolean frame_complete;
   GstBaseParseFrame subframe;
+  guint i;
 
   if (!gst_buffer_map (buffer, &map_info, GST_MAP_READ)) {
     GST_ERROR_OBJECT (parse, "Couldn't map incoming buffer");
@@ -1620,59 +1632,81 @@ gst_av1_parse_handle_to_small_and_equal_align (GstBaseParse * parse,
   frame_complete = FALSE;
 again:
   while (offset < map_info.size) {
-    GST_BUFFER_OFFSET (buffer) = offset;
+    /* Identify all the OBUs up to the next sequence header at once, the
+       buffer is then split at the indexed OBU boundaries. */
+    res = gst_av1_parser_identify_obus (self->parser,
+        map_info.data + offset, map_info.size - offset, self->obu_index,
+        &consumed);
+
+    for (i = 0; i < self->obu_index->len; i++) {
+      GstAV1OBUIndexEntry *entry =
+          &g_array_index (self->obu_index, GstAV1OBUIndexEntry, i);
+      GstAV1ParserResult obu_res = GST_AV1_PARSER_DROP;
+
+      GST_BUFFER_OFFSET (buffer) = offset + entry->offset;
+
+      if (!entry->dropped)
+        obu_res = gst_av1_parse_handle_one_obu (self, &entry->obu,
+            &frame_complete, NULL);
+
+      if (obu_res == GST_AV1_PARSER_DROP) {
+        GST_DEBUG_OBJECT (parse, "Drop %d data", entry->size);
+        gst_av1_parse_reset_obu_data_state (self);
+        continue;
+      } else if (obu_res != GST_AV1_PARSER_OK) {
+        res = obu_res;
+        goto done;
+      }
 
-    res = gst_av1_parser_identify_one_obu (self->parser,
-        map_info.data + offset, map_info.size - offset, &obu, &consumed);
-    if (res == GST_AV1_PARSER_OK)
-      res = gst_av1_parse_handle_one_obu (self, &obu, &frame_complete, NULL);
-    if (res != GST_AV1_PARSER_OK)
-      break;
+      if (entry->obu.obu_type == GST_AV1_OBU_TEMPORAL_DELIMITER
+          && consumed_before_push > 0) {
+        GST_DEBUG_OBJECT (self, "Encounter TD inside one %s aligned"
+            " buffer, should not happen normally.",
+            gst_av1_parse_alignment_to_string (self->in_align));
+
+        if (self->in_align == GST_AV1_PARSE_ALIGN_TEMPORAL_UNIT_ANNEX_B)
+          gst_av1_parser_reset_annex_b (self->parser);
+
+        /* Not include this TD obu, it should belong to the next TU or frame,
+           we push all the data we already got. */
+        gst_av1_parse_create_subframe (frame, &subframe, buffer);
+        ret = gst_av1_parse_push_data (self, &subframe,
+            consumed_before_push, TRUE);
+        if (ret != GST_FLOW_OK)
+          goto out;
+
+        /* Begin to find the next, starting again from this TD. */
+        frame_complete = FALSE;
+        consumed_before_push = 0;
+        offset += entry->offset;
+        goto again;
+      }
 
-    if (obu.obu_type == GST_AV1_OBU_TEMPORAL_DELIMITER
-        && consumed_before_push > 0) {
-      GST_DEBUG_OBJECT (self, "Encounter TD inside one %s aligned"
-          " buffer, should not happen normally.",
-          gst_av1_parse_alignment_to_string (self->in_align));
+      gst_av1_parse_cache_one_obu (self, buffer, &entry->obu,
+          offset + entry->offset, entry->size, frame_complete);
 
-      if (self->in_align == GST_AV1_PARSE_ALIGN_TEMPORAL_UNIT_ANNEX_B)
-        gst_av1_parser_reset_annex_b (self->parser);
+      consumed_before_push += entry->size;
 
-      /* Not include this TD obu, it should belong to the next TU or frame,
-         we push all the data we already got. */
-      gst_av1_parse_create_subframe (frame, &subframe, buffer);
-      ret = gst_av1_parse_push_data (self, &subframe,
-          consumed_before_push, TRUE);
-      if (ret != GST_FLOW_OK)
-        goto out;
+      if ((self->align == GST_AV1_PARSE_ALIGN_OBU) ||
+          (self->align == GST_AV1_PARSE_ALIGN_FRAME && frame_complete)) {
+        gst_av1_parse_create_subframe (frame, &subframe, buffer);
+        ret = gst_av1_parse_push_data (self, &subframe,
+            consumed_before_push, frame_complete);
+        if (ret != GST_FLOW_OK)
+          goto out;
 
-      /* Begin to find the next. */
-      frame_complete = FALSE;
-      consumed_before_push = 0;
-      continue;
+        /* Begin to find the next. */
+        frame_complete = FALSE;
+        consumed_before_push = 0;
+      }
     }
 
-    gst_av1_parse_cache_one_obu (self, buffer, &obu,
-        map_info.data + offset, consumed, frame_complete);
-
     offset += consumed;
-    consumed_before_push += consumed;
-
-    if ((self->align == GST_AV1_PARSE_ALIGN_OBU) ||
-        (self->align == GST_AV1_PARSE_ALIGN_FRAME && frame_complete)) {
-      gst_av1_parse_create_subframe (frame, &subframe, buffer);
-      ret = gst_av1_parse_push_data (self, &subframe,
-          consumed_before_push, frame_complete);
-      if (ret != GST_FLOW_OK)
-        goto out;
-
-      /* Begin to find the next. */
-      frame_complete = FALSE;
-      consumed_before_push = 0;
-      continue;
-    }
+    if (res != GST_AV1_PARSER_OK)
+      break;
   }
 
+done:
   if (res == GST_AV1_PARSER_BITSTREAM_ERROR ||
       res == GST_AV1_PARSER_MISSING_OBU_REFERENCE) {
     /* Discard the whole frame */
@@ -1694,12 +1728,6 @@ again:
     gst_av1_parse_reset_obu_data_state (self);
     ret = GST_FLOW_OK;
     goto out;
-  } else if (res == GST_AV1_PARSER_DROP) {
-    GST_DEBUG_OBJECT (parse, "Drop %d data", consumed);
-    offset += consumed;
-    gst_av1_parse_reset_obu_data_state (self);
-    res = GST_AV1_PARSER_OK;
-    goto again;
   } else if (res != GST_AV1_PARSER_OK) {
     GST_ERROR_OBJECT (parse, "Parse obu get unexpect error %d", res);
     *skipsize = 0;
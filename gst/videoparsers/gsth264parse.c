@@ -39,12 +39,14 @@ GST_DEBUG_CATEGORY (h264_parse_debug);
 
 #define DEFAULT_CONFIG_INTERVAL      (0)
 #define DEFAULT_UPDATE_TIMECODE       FALSE
+#define DEFAULT_PARTIAL_SLICE_PARSING FALSE
 
 enum
 {
   PROP_0,
   PROP_CONFIG_INTERVAL,
   PROP_UPDATE_TIMECODE,
+  PROP_PARTIAL_SLICE_PARSING,
 };
 
 enum
@@ -173,6 +175,25 @@ gst_h264_parse_class_init (GstH264ParseClass * klass)
           "VUI and pic_struct_present_flag of VUI must be non-zero",
           DEFAULT_UPDATE_TIMECODE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstH264Parse:partial-slice-parsing:
+   *
+   * Only parse the beginning of slice headers, which is all that is needed
+   * to find frame boundaries, frame types and field pictures. This makes
+   * parsing streams with many slices per frame much cheaper when the parser
+   * is only used to fix timestamps, insert AUDs or extract SEI. The rest of
+   * the slice headers is not validated in this mode.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_PARTIAL_SLICE_PARSING,
+      g_param_spec_boolean ("partial-slice-parsing",
+          "Partial Slice Parsing",
+          "Only parse the part of the slice headers needed to detect frame "
+          "boundaries and frame types",
+          DEFAULT_PARTIAL_SLICE_PARSING,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /* Override BaseParse vfuncs */
   parse_class->start = GST_DEBUG_FUNCPTR (gst_h264_parse_start);
   parse_class->stop = GST_DEBUG_FUNCPTR (gst_h264_parse_stop);
@@ -205,6 +226,7 @@ gst_h264_parse_init (GstH264Parse * h264parse)
   h264parse->aud_needed = TRUE;
   h264parse->aud_insert = TRUE;
   h264parse->update_timecode = DEFAULT_UPDATE_TIMECODE;
+  h264parse->partial_slice_parsing = DEFAULT_PARTIAL_SLICE_PARSING;
 }
 
 static void
@@ -476,31 +498,39 @@ gst_h264_parse_negotiate (GstH264Parse * h264parse, gint in_format,
     gst_caps_unref (caps);
 }
 
+static const guint8 byte_stream_start_code[] = { 0x00, 0x00, 0x00, 0x01 };
+
+/* Returns a buffer holding the NAL found at @offset in @src, prefixed by a
+ * start code or a NAL length as required by @format. The NAL payload memory
+ * is shared with @src, only the prefix is newly allocated. */
 static GstBuffer *
-gst_h264_parse_wrap_nal (GstH264Parse * h264parse, guint format, guint8 * data,
-    guint size)
+gst_h264_parse_wrap_nal (GstH264Parse * h264parse, guint format,
+    GstBuffer * src, guint offset, guint size)
 {
   GstBuffer *buf;
+  GstMemory *prefix;
   guint nl = h264parse->nal_length_size;
-  guint32 tmp;
 
   GST_DEBUG_OBJECT (h264parse, "nal length %d", size);
 
-  buf = gst_buffer_new_allocate (NULL, 4 + size, NULL);
   if (format == GST_H264_PARSE_FORMAT_AVC
       || format == GST_H264_PARSE_FORMAT_AVC3) {
-    tmp = GUINT32_TO_BE (size << (32 - 8 * nl));
+    guint8 *data = g_malloc (nl);
+    guint i;
+
+    for (i = 0; i < nl; i++)
+      data[i] = (size >> (8 * (nl - 1 - i))) & 0xff;
+    prefix = gst_memory_new_wrapped (0, data, nl, 0, nl, data, g_free);
   } else {
-    /* HACK: nl should always be 4 here, otherwise this won't work.
-     * There are legit cases where nl in avc stream is 2, but byte-stream
-     * SC is still always 4 bytes. */
-    nl = 4;
-    tmp = GUINT32_TO_BE (1);
+    /* byte-stream SC is always 4 bytes, even if nl in an avc stream is less */
+    prefix = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+        (gpointer) byte_stream_start_code, sizeof (byte_stream_start_code), 0,
+        sizeof (byte_stream_start_code), NULL, NULL);
   }
 
-  gst_buffer_fill (buf, 0, &tmp, sizeof (guint32));
-  gst_buffer_fill (buf, nl, data, size);
-  gst_buffer_set_size (buf, size + nl);
+  buf = gst_buffer_new ();
+  gst_buffer_append_memory (buf, prefix);
+  gst_buffer_copy_into (buf, src, GST_BUFFER_COPY_MEMORY, offset, size);
 
   return buf;
 }
@@ -949,12 +979,14 @@ gst_h264_parse_process_sei (GstH264Parse * h264parse, GstH264NalUnit * nalu)
 
 /* caller guarantees 2 bytes of nal payload */
 static gboolean
-gst_h264_parse_process_nal (GstH264Parse * h264parse, GstH264NalUnit * nalu)
+gst_h264_parse_process_nal (GstH264Parse * h264parse, GstH264NalUnit * nalu,
+    GstBuffer * buffer)
 {
   guint nal_type;
   GstH264PPS pps = { 0, };
   GstH264SPS sps = { 0, };
   GstH264NalParser *nalparser = h264parse->nalparser;
+  GstH264SPS *active_sps = nalparser->last_sps;
   GstH264ParserResult pres;
   GstH264SliceHdr slice;
 
@@ -991,8 +1023,14 @@ gst_h264_parse_process_nal (GstH264Parse * h264parse, GstH264NalUnit * nalu)
         return FALSE;
       }
 
-      GST_DEBUG_OBJECT (h264parse, "triggering src caps check");
-      h264parse->update_caps = TRUE;
+      /* a repeated identical SPS can't change the caps, unless it makes
+       * another stored SPS the active one */
+      if (gst_h264_parser_last_parameter_set_changed (nalparser)
+          || !h264parse->sps_nals[sps.id] || !active_sps
+          || active_sps->id != sps.id) {
+        GST_DEBUG_OBJECT (h264parse, "triggering src caps check");
+        h264parse->update_caps = TRUE;
+      }
       h264parse->have_sps = TRUE;
       h264parse->have_sps_in_frame = TRUE;
       if (h264parse->push_codec && h264parse->have_pps) {
@@ -1089,8 +1127,12 @@ gst_h264_parse_process_nal (GstH264Parse * h264parse, GstH264NalUnit * nalu)
       if (nal_type == GST_H264_NAL_SLICE_EXT && !GST_H264_IS_MVC_NALU (nalu))
         break;
 
-      pres = gst_h264_parser_parse_slice_hdr (nalparser, nalu, &slice,
-          FALSE, FALSE);
+      if (h264parse->partial_slice_parsing)
+        pres = gst_h264_parser_parse_slice_hdr_partial (nalparser, nalu,
+            &slice);
+      else
+        pres = gst_h264_parser_parse_slice_hdr (nalparser, nalu, &slice,
+            FALSE, FALSE);
       GST_DEBUG_OBJECT (h264parse,
           "parse result %d, first MB: %u, slice type: %u",
           pres, slice.first_mb_in_slice, slice.type);
@@ -1172,7 +1214,7 @@ gst_h264_parse_process_nal (GstH264Parse * h264parse, GstH264NalUnit * nalu)
 
     GST_LOG_OBJECT (h264parse, "collecting NAL in AVC frame");
     buf = gst_h264_parse_wrap_nal (h264parse, h264parse->format,
-        nalu->data + nalu->offset, nalu->size);
+        buffer, nalu->offset, nalu->size);
     gst_adapter_push (h264parse->frame_out, buf);
   }
   return TRUE;
@@ -1263,7 +1305,7 @@ gst_h264_parse_handle_frame_packetized (GstBaseParse * parse,
     GST_DEBUG_OBJECT (h264parse, "AVC nal offset %d", nalu.offset + nalu.size);
 
     /* either way, have a look at it */
-    gst_h264_parse_process_nal (h264parse, &nalu);
+    gst_h264_parse_process_nal (h264parse, &nalu, buffer);
 
     /* dispatch per NALU if needed */
     if (h264parse->split_packetized) {
@@ -1518,7 +1560,7 @@ gst_h264_parse_handle_frame (GstBaseParse * parse,
       }
     }
 
-    if (!gst_h264_parse_process_nal (h264parse, &nalu)) {
+    if (!gst_h264_parse_process_nal (h264parse, &nalu, buffer)) {
       GST_WARNING_OBJECT (h264parse,
           "broken/invalid nal Type: %d %s, Size: %u will be dropped",
           nalu.type, _nal_name (nalu.type), nalu.size);
@@ -2725,7 +2767,8 @@ gst_h264_parse_parse_frame (GstBaseParse * parse, GstBaseParseFrame * frame)
   if (av) {
     GstBuffer *buf;
 
-    buf = gst_adapter_take_buffer (h264parse->frame_out, av);
+    /* keep the wrapped NALs as separate memories instead of merging them */
+    buf = gst_adapter_take_buffer_fast (h264parse->frame_out, av);
     gst_buffer_copy_into (buf, buffer, GST_BUFFER_COPY_METADATA, 0, -1);
     gst_buffer_replace (&frame->out_buffer, buf);
     gst_buffer_unref (buf);
@@ -2747,13 +2790,10 @@ static GstFlowReturn
 gst_h264_parse_push_codec_buffer (GstH264Parse * h264parse,
     GstBuffer * nal, GstBuffer * buffer)
 {
-  GstMapInfo map;
   GstBuffer *wrapped_nal;
 
-  gst_buffer_map (nal, &map, GST_MAP_READ);
   wrapped_nal = gst_h264_parse_wrap_nal (h264parse, h264parse->format,
-      map.data, map.size);
-  gst_buffer_unmap (nal, &map);
+      nal, 0, gst_buffer_get_size (nal));
 
   GST_BUFFER_PTS (wrapped_nal) = GST_BUFFER_PTS (buffer);
   GST_BUFFER_DTS (wrapped_nal) = GST_BUFFER_DTS (buffer);
@@ -2888,60 +2928,42 @@ gst_h264_parse_handle_sps_pps_nals (GstH264Parse * h264parse,
       }
     }
   } else {
-    /* insert config NALs into AU */
-    GstByteWriter bw;
+    /* insert config NALs into AU, sharing the memory of the original AU and
+     * of the stored config NALs rather than copying them */
     GstBuffer *new_buf;
-    const gboolean bs = h264parse->format == GST_H264_PARSE_FORMAT_BYTE;
-    const gint nls = 4 - h264parse->nal_length_size;
-    gboolean ok;
 
-    gst_byte_writer_init_with_size (&bw, gst_buffer_get_size (buffer), FALSE);
-    ok = gst_byte_writer_put_buffer (&bw, buffer, 0, h264parse->idr_pos);
+    new_buf = gst_buffer_new ();
+    if (h264parse->idr_pos > 0)
+      gst_buffer_copy_into (new_buf, buffer, GST_BUFFER_COPY_MEMORY, 0,
+          h264parse->idr_pos);
     GST_DEBUG_OBJECT (h264parse, "- inserting SPS/PPS");
     for (i = 0; i < GST_H264_MAX_SPS_COUNT; i++) {
       if ((codec_nal = h264parse->sps_nals[i])) {
-        gsize nal_size = gst_buffer_get_size (codec_nal);
         GST_DEBUG_OBJECT (h264parse, "inserting SPS nal");
-        if (bs) {
-          ok &= gst_byte_writer_put_uint32_be (&bw, 1);
-        } else {
-          ok &= gst_byte_writer_put_uint32_be (&bw, (nal_size << (nls * 8)));
-          ok &= gst_byte_writer_set_pos (&bw,
-              gst_byte_writer_get_pos (&bw) - nls);
-        }
-
-        ok &= gst_byte_writer_put_buffer (&bw, codec_nal, 0, nal_size);
+        new_buf = gst_buffer_append (new_buf,
+            gst_h264_parse_wrap_nal (h264parse, h264parse->format, codec_nal,
+                0, gst_buffer_get_size (codec_nal)));
         send_done = TRUE;
       }
     }
     for (i = 0; i < GST_H264_MAX_PPS_COUNT; i++) {
       if ((codec_nal = h264parse->pps_nals[i])) {
-        gsize nal_size = gst_buffer_get_size (codec_nal);
         GST_DEBUG_OBJECT (h264parse, "inserting PPS nal");
-        if (bs) {
-          ok &= gst_byte_writer_put_uint32_be (&bw, 1);
-        } else {
-          ok &= gst_byte_writer_put_uint32_be (&bw, (nal_size << (nls * 8)));
-          ok &= gst_byte_writer_set_pos (&bw,
-              gst_byte_writer_get_pos (&bw) - nls);
-        }
-        ok &= gst_byte_writer_put_buffer (&bw, codec_nal, 0, nal_size);
+        new_buf = gst_buffer_append (new_buf,
+            gst_h264_parse_wrap_nal (h264parse, h264parse->format, codec_nal,
+                0, gst_buffer_get_size (codec_nal)));
         send_done = TRUE;
       }
     }
-    ok &= gst_byte_writer_put_buffer (&bw, buffer, h264parse->idr_pos, -1);
+    gst_buffer_copy_into (new_buf, buffer, GST_BUFFER_COPY_MEMORY,
+        h264parse->idr_pos, -1);
     /* collect result and push */
-    new_buf = gst_byte_writer_reset_and_get_buffer (&bw);
     gst_buffer_copy_into (new_buf, buffer, GST_BUFFER_COPY_METADATA, 0, -1);
     /* should already be keyframe/IDR, but it may not have been,
      * so mark it as such to avoid being discarded by picky decoder */
     GST_BUFFER_FLAG_UNSET (new_buf, GST_BUFFER_FLAG_DELTA_UNIT);
     gst_buffer_replace (&frame->out_buffer, new_buf);
     gst_buffer_unref (new_buf);
-    /* some result checking seems to make some compilers happy */
-    if (G_UNLIKELY (!ok)) {
-      GST_ERROR_OBJECT (h264parse, "failed to insert SPS/PPS");
-    }
   }
 
   return send_done;
@@ -3489,12 +3511,12 @@ gst_h264_parse_set_caps (GstBaseParse * parse, GstCaps * caps)
 
     for (i = 0; i < config->sps->len; i++) {
       nalu = &g_array_index (config->sps, GstH264NalUnit, i);
-      gst_h264_parse_process_nal (h264parse, nalu);
+      gst_h264_parse_process_nal (h264parse, nalu, codec_data);
     }
 
     for (i = 0; i < config->pps->len; i++) {
       nalu = &g_array_index (config->pps, GstH264NalUnit, i);
-      gst_h264_parse_process_nal (h264parse, nalu);
+      gst_h264_parse_process_nal (h264parse, nalu, codec_data);
     }
 
     gst_h264_decoder_config_record_free (config);
@@ -3772,6 +3794,9 @@ gst_h264_parse_set_property (GObject * object, guint prop_id,
     case PROP_UPDATE_TIMECODE:
       parse->update_timecode = g_value_get_boolean (value);
       break;
+    case PROP_PARTIAL_SLICE_PARSING:
+      parse->partial_slice_parsing = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -3793,6 +3818,9 @@ gst_h264_parse_get_property (GObject * object, guint prop_id,
     case PROP_UPDATE_TIMECODE:
       g_value_set_boolean (value, parse->update_timecode);
       break;
+    case PROP_PARTIAL_SLICE_PARSING:
+      g_value_set_boolean (value, parse->partial_slice_parsing);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
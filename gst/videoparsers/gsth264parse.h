@@ -147,6 +147,7 @@ struct _GstH264Parse
   /* props */
   gint interval;
   gboolean update_timecode;
+  gboolean partial_slice_parsing;
 
   GstClockTime pending_key_unit_ts;
   GstEvent *force_key_unit_event;
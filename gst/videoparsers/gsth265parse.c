@@ -33,11 +33,13 @@ GST_DEBUG_CATEGORY (h265_parse_debug);
 #define GST_CAT_DEFAULT h265_parse_debug
 
 #define DEFAULT_CONFIG_INTERVAL      (0)
+#define DEFAULT_PARTIAL_SLICE_PARSING FALSE
 
 enum
 {
   PROP_0,
-  PROP_CONFIG_INTERVAL
+  PROP_CONFIG_INTERVAL,
+  PROP_PARTIAL_SLICE_PARSING,
 };
 
 enum
@@ -143,6 +145,26 @@ gst_h265_parse_class_init (GstH265ParseClass * klass)
           "(0 = disabled, -1 = send with every IDR frame)",
           -1, 3600, DEFAULT_CONFIG_INTERVAL,
           G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstH265Parse:partial-slice-parsing:
+   *
+   * Only parse the beginning of slice segment headers, which is all that is
+   * needed to find frame boundaries and frame types. This makes parsing
+   * streams with many slices per frame much cheaper when the parser is only
+   * used to fix timestamps, insert AUDs or extract SEI. The rest of the slice
+   * segment headers is not validated in this mode.
+   *
+   * Since: 1.24
+   */
+  g_object_class_install_property (gobject_class, PROP_PARTIAL_SLICE_PARSING,
+      g_param_spec_boolean ("partial-slice-parsing",
+          "Partial Slice Parsing",
+          "Only parse the part of the slice segment headers needed to detect "
+          "frame boundaries and frame types",
+          DEFAULT_PARTIAL_SLICE_PARSING,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /* Override BaseParse vfuncs */
   parse_class->start = GST_DEBUG_FUNCPTR (gst_h265_parse_start);
   parse_class->stop = GST_DEBUG_FUNCPTR (gst_h265_parse_stop);
@@ -167,6 +189,7 @@ static void
 gst_h265_parse_init (GstH265Parse * h265parse)
 {
   h265parse->frame_out = gst_adapter_new ();
+  h265parse->partial_slice_parsing = DEFAULT_PARTIAL_SLICE_PARSING;
   gst_base_parse_set_pts_interpolation (GST_BASE_PARSE (h265parse), FALSE);
   gst_base_parse_set_infer_ts (GST_BASE_PARSE (h265parse), FALSE);
   GST_PAD_SET_ACCEPT_INTERSECT (GST_BASE_PARSE_SINK_PAD (h265parse));
@@ -421,31 +444,39 @@ gst_h265_parse_negotiate (GstH265Parse * h265parse, gint in_format,
     gst_caps_unref (caps);
 }
 
+static const guint8 byte_stream_start_code[] = { 0x00, 0x00, 0x00, 0x01 };
+
+/* Returns a buffer holding the NAL found at @offset in @src, prefixed by a
+ * start code or a NAL length as required by @format. The NAL payload memory
+ * is shared with @src, only the prefix is newly allocated. */
 static GstBuffer *
-gst_h265_parse_wrap_nal (GstH265Parse * h265parse, guint format, guint8 * data,
-    guint size)
+gst_h265_parse_wrap_nal (GstH265Parse * h265parse, guint format,
+    GstBuffer * src, guint offset, guint size)
 {
   GstBuffer *buf;
+  GstMemory *prefix;
   guint nl = h265parse->nal_length_size;
-  guint32 tmp;
 
   GST_DEBUG_OBJECT (h265parse, "nal length %d", size);
 
-  buf = gst_buffer_new_allocate (NULL, 4 + size, NULL);
   if (format == GST_H265_PARSE_FORMAT_HVC1
       || format == GST_H265_PARSE_FORMAT_HEV1) {
-    tmp = GUINT32_TO_BE (size << (32 - 8 * nl));
+    guint8 *data = g_malloc (nl);
+    guint i;
+
+    for (i = 0; i < nl; i++)
+      data[i] = (size >> (8 * (nl - 1 - i))) & 0xff;
+    prefix = gst_memory_new_wrapped (0, data, nl, 0, nl, data, g_free);
   } else {
-    /* HACK: nl should always be 4 here, otherwise this won't work.
-     * There are legit cases where nl in hevc stream is 2, but byte-stream
-     * SC is still always 4 bytes. */
-    nl = 4;
-    tmp = GUINT32_TO_BE (1);
+    /* byte-stream SC is always 4 bytes, even if nl in a hevc stream is less */
+    prefix = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+        (gpointer) byte_stream_start_code, sizeof (byte_stream_start_code), 0,
+        sizeof (byte_stream_start_code), NULL, NULL);
   }
 
-  gst_buffer_fill (buf, 0, &tmp, sizeof (guint32));
-  gst_buffer_fill (buf, nl, data, size);
-  gst_buffer_set_size (buf, size + nl);
+  buf = gst_buffer_new ();
+  gst_buffer_append_memory (buf, prefix);
+  gst_buffer_copy_into (buf, src, GST_BUFFER_COPY_MEMORY, offset, size);
 
   return buf;
 }
@@ -711,13 +742,16 @@ gst_h265_parse_process_sei_user_data (GstH265Parse * h265parse,
 
 /* caller guarantees 2 bytes of nal payload */
 static gboolean
-gst_h265_parse_process_nal (GstH265Parse * h265parse, GstH265NalUnit * nalu)
+gst_h265_parse_process_nal (GstH265Parse * h265parse, GstH265NalUnit * nalu,
+    GstBuffer * buffer)
 {
   GstH265PPS pps = { 0, };
   GstH265SPS sps = { 0, };
   GstH265VPS vps = { 0, };
   guint nal_type;
   GstH265Parser *nalparser = h265parse->nalparser;
+  GstH265VPS *active_vps = nalparser->last_vps;
+  GstH265SPS *active_sps = nalparser->last_sps;
   GstH265ParserResult pres = GST_H265_PARSER_ERROR;
 
   /* nothing to do for broken input */
@@ -741,8 +775,14 @@ gst_h265_parse_process_nal (GstH265Parse * h265parse, GstH265NalUnit * nalu)
         return FALSE;
       }
 
-      GST_DEBUG_OBJECT (h265parse, "triggering src caps check");
-      h265parse->update_caps = TRUE;
+      /* a repeated identical VPS can't change the caps, unless it makes
+       * another stored VPS the active one */
+      if (gst_h265_parser_last_parameter_set_changed (nalparser)
+          || !h265parse->vps_nals[vps.id] || !active_vps
+          || active_vps->id != vps.id) {
+        GST_DEBUG_OBJECT (h265parse, "triggering src caps check");
+        h265parse->update_caps = TRUE;
+      }
       h265parse->have_vps = TRUE;
       h265parse->have_vps_in_frame = TRUE;
       if (h265parse->push_codec && h265parse->have_pps) {
@@ -779,8 +819,14 @@ gst_h265_parse_process_nal (GstH265Parse * h265parse, GstH265NalUnit * nalu)
             "failed to parse VUI of SPS, ignore VUI");
       }
 
-      GST_DEBUG_OBJECT (h265parse, "triggering src caps check");
-      h265parse->update_caps = TRUE;
+      /* a repeated identical SPS can't change the caps, unless it makes
+       * another stored SPS the active one */
+      if (gst_h265_parser_last_parameter_set_changed (nalparser)
+          || !h265parse->sps_nals[sps.id] || !active_sps
+          || active_sps->id != sps.id) {
+        GST_DEBUG_OBJECT (h265parse, "triggering src caps check");
+        h265parse->update_caps = TRUE;
+      }
       h265parse->have_sps = TRUE;
       h265parse->have_sps_in_frame = TRUE;
       if (h265parse->push_codec && h265parse->have_pps) {
@@ -878,7 +924,11 @@ gst_h265_parse_process_nal (GstH265Parse * h265parse, GstH265NalUnit * nalu)
        * AU is complete. This is used to keep track of AU */
       h265parse->picture_start = TRUE;
 
-      pres = gst_h265_parser_parse_slice_hdr (nalparser, nalu, &slice);
+      if (h265parse->partial_slice_parsing)
+        pres = gst_h265_parser_parse_slice_hdr_partial (nalparser, nalu,
+            &slice);
+      else
+        pres = gst_h265_parser_parse_slice_hdr (nalparser, nalu, &slice);
 
       if (pres == GST_H265_PARSER_OK) {
         if (GST_H265_IS_I_SLICE (&slice))
@@ -969,7 +1019,7 @@ gst_h265_parse_process_nal (GstH265Parse * h265parse, GstH265NalUnit * nalu)
 
     GST_LOG_OBJECT (h265parse, "collecting NAL in HEVC frame");
     buf = gst_h265_parse_wrap_nal (h265parse, h265parse->format,
-        nalu->data + nalu->offset, nalu->size);
+        buffer, nalu->offset, nalu->size);
     gst_adapter_push (h265parse->frame_out, buf);
   }
 
@@ -1049,7 +1099,7 @@ gst_h265_parse_handle_frame_packetized (GstBaseParse * parse,
     GST_DEBUG_OBJECT (h265parse, "HEVC nal offset %d", nalu.offset + nalu.size);
 
     /* either way, have a look at it */
-    gst_h265_parse_process_nal (h265parse, &nalu);
+    gst_h265_parse_process_nal (h265parse, &nalu, buffer);
 
     /* dispatch per NALU if needed */
     if (h265parse->split_packetized) {
@@ -1301,7 +1351,7 @@ gst_h265_parse_handle_frame (GstBaseParse * parse,
       }
     }
 
-    if (!gst_h265_parse_process_nal (h265parse, &nalu)) {
+    if (!gst_h265_parse_process_nal (h265parse, &nalu, buffer)) {
       GST_WARNING_OBJECT (h265parse,
           "broken/invalid nal Type: %d %s, Size: %u will be dropped",
           nalu.type, _nal_name (nalu.type), nalu.size);
@@ -2566,7 +2616,8 @@ gst_h265_parse_parse_frame (GstBaseParse * parse, GstBaseParseFrame * frame)
   if (av) {
     GstBuffer *buf;
 
-    buf = gst_adapter_take_buffer (h265parse->frame_out, av);
+    /* keep the wrapped NALs as separate memories instead of merging them */
+    buf = gst_adapter_take_buffer_fast (h265parse->frame_out, av);
     gst_buffer_copy_into (buf, buffer, GST_BUFFER_COPY_METADATA, 0, -1);
     gst_buffer_replace (&frame->out_buffer, buf);
     gst_buffer_unref (buf);
@@ -2589,12 +2640,8 @@ static GstFlowReturn
 gst_h265_parse_push_codec_buffer (GstH265Parse * h265parse, GstBuffer * nal,
     GstBuffer * buffer)
 {
-  GstMapInfo map;
-
-  gst_buffer_map (nal, &map, GST_MAP_READ);
   nal = gst_h265_parse_wrap_nal (h265parse, h265parse->format,
-      map.data, map.size);
-  gst_buffer_unmap (nal, &map);
+      nal, 0, gst_buffer_get_size (nal));
 
   if (h265parse->discont) {
     GST_BUFFER_FLAG_SET (nal, GST_BUFFER_FLAG_DISCONT);
@@ -2748,76 +2795,51 @@ gst_h265_parse_handle_vps_sps_pps_nals (GstH265Parse * h265parse,
       }
     }
   } else {
-    /* insert config NALs into AU */
-    GstByteWriter bw;
+    /* insert config NALs into AU, sharing the memory of the original AU and
+     * of the stored config NALs rather than copying them */
     GstBuffer *new_buf;
-    const gboolean bs = h265parse->format == GST_H265_PARSE_FORMAT_BYTE;
-    const gint nls = 4 - h265parse->nal_length_size;
-    gboolean ok;
 
-    gst_byte_writer_init_with_size (&bw, gst_buffer_get_size (buffer), FALSE);
-    ok = gst_byte_writer_put_buffer (&bw, buffer, 0, h265parse->idr_pos);
+    new_buf = gst_buffer_new ();
+    if (h265parse->idr_pos > 0)
+      gst_buffer_copy_into (new_buf, buffer, GST_BUFFER_COPY_MEMORY, 0,
+          h265parse->idr_pos);
     GST_DEBUG_OBJECT (h265parse, "- inserting VPS/SPS/PPS");
     for (i = 0; i < GST_H265_MAX_VPS_COUNT; i++) {
       if ((codec_nal = h265parse->vps_nals[i])) {
-        gsize nal_size = gst_buffer_get_size (codec_nal);
         GST_DEBUG_OBJECT (h265parse, "inserting VPS nal");
-        if (bs) {
-          ok &= gst_byte_writer_put_uint32_be (&bw, 1);
-        } else {
-          ok &= gst_byte_writer_put_uint32_be (&bw, (nal_size << (nls * 8)));
-          ok &= gst_byte_writer_set_pos (&bw,
-              gst_byte_writer_get_pos (&bw) - nls);
-        }
-
-        ok &= gst_byte_writer_put_buffer (&bw, codec_nal, 0, nal_size);
+        new_buf = gst_buffer_append (new_buf,
+            gst_h265_parse_wrap_nal (h265parse, h265parse->format, codec_nal,
+                0, gst_buffer_get_size (codec_nal)));
         send_done = TRUE;
       }
     }
     for (i = 0; i < GST_H265_MAX_SPS_COUNT; i++) {
       if ((codec_nal = h265parse->sps_nals[i])) {
-        gsize nal_size = gst_buffer_get_size (codec_nal);
         GST_DEBUG_OBJECT (h265parse, "inserting SPS nal");
-        if (bs) {
-          ok &= gst_byte_writer_put_uint32_be (&bw, 1);
-        } else {
-          ok &= gst_byte_writer_put_uint32_be (&bw, (nal_size << (nls * 8)));
-          ok &= gst_byte_writer_set_pos (&bw,
-              gst_byte_writer_get_pos (&bw) - nls);
-        }
-
-        ok &= gst_byte_writer_put_buffer (&bw, codec_nal, 0, nal_size);
+        new_buf = gst_buffer_append (new_buf,
+            gst_h265_parse_wrap_nal (h265parse, h265parse->format, codec_nal,
+                0, gst_buffer_get_size (codec_nal)));
         send_done = TRUE;
       }
     }
     for (i = 0; i < GST_H265_MAX_PPS_COUNT; i++) {
       if ((codec_nal = h265parse->pps_nals[i])) {
-        gsize nal_size = gst_buffer_get_size (codec_nal);
         GST_DEBUG_OBJECT (h265parse, "inserting PPS nal");
-        if (bs) {
-          ok &= gst_byte_writer_put_uint32_be (&bw, 1);
-        } else {
-          ok &= gst_byte_writer_put_uint32_be (&bw, (nal_size << (nls * 8)));
-          ok &= gst_byte_writer_set_pos (&bw,
-              gst_byte_writer_get_pos (&bw) - nls);
-        }
-        ok &= gst_byte_writer_put_buffer (&bw, codec_nal, 0, nal_size);
+        new_buf = gst_buffer_append (new_buf,
+            gst_h265_parse_wrap_nal (h265parse, h265parse->format, codec_nal,
+                0, gst_buffer_get_size (codec_nal)));
         send_done = TRUE;
       }
     }
-    ok &= gst_byte_writer_put_buffer (&bw, buffer, h265parse->idr_pos, -1);
+    gst_buffer_copy_into (new_buf, buffer, GST_BUFFER_COPY_MEMORY,
+        h265parse->idr_pos, -1);
     /* collect result and push */
-    new_buf = gst_byte_writer_reset_and_get_buffer (&bw);
     gst_buffer_copy_into (new_buf, buffer, GST_BUFFER_COPY_METADATA, 0, -1);
     /* should already be keyframe/IDR, but it may not have been,
      * so mark it as such to avoid being discarded by picky decoder */
     GST_BUFFER_FLAG_UNSET (new_buf, GST_BUFFER_FLAG_DELTA_UNIT);
     gst_buffer_replace (&frame->out_buffer, new_buf);
     gst_buffer_unref (new_buf);
-    /* some result checking seems to make some compilers happy */
-    if (G_UNLIKELY (!ok)) {
-      GST_ERROR_OBJECT (h265parse, "failed to insert SPS/PPS");
-    }
   }
 
   return send_done;
@@ -3139,7 +3161,7 @@ gst_h265_parse_set_caps (GstBaseParse * parse, GstCaps * caps)
           goto hvcc_too_small;
         }
 
-        gst_h265_parse_process_nal (h265parse, &nalu);
+        gst_h265_parse_process_nal (h265parse, &nalu, codec_data);
         off = nalu.offset + nalu.size;
       }
     }
@@ -3406,6 +3428,9 @@ gst_h265_parse_set_property (GObject * object, guint prop_id,
     case PROP_CONFIG_INTERVAL:
       parse->interval = g_value_get_int (value);
       break;
+    case PROP_PARTIAL_SLICE_PARSING:
+      parse->partial_slice_parsing = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -3423,6 +3448,9 @@ gst_h265_parse_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_CONFIG_INTERVAL:
       g_value_set_int (value, parse->interval);
       break;
+    case PROP_PARTIAL_SLICE_PARSING:
+      g_value_set_boolean (value, parse->partial_slice_parsing);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -118,6 +118,7 @@ struct _GstH265Parse
 
   /* props */
   gint interval;
+  gboolean partial_slice_parsing;
 
   GstClockTime pending_key_unit_ts;
   GstEvent *force_key_unit_event;
@@ -296,6 +296,9 @@ gst_vc1_parse_reset (GstVC1Parse * vc1parse)
 
   vc1parse->seq_layer_sent = FALSE;
   vc1parse->frame_layer_first_frame_sent = FALSE;
+
+  vc1parse->bdu_offset = 0;
+  vc1parse->bdu_end_scan_offset = 0;
 }
 
 static gboolean
@@ -1233,47 +1236,84 @@ gst_vc1_parse_handle_frame (GstBaseParse * parse, GstBaseParseFrame * frame,
     GstVC1BDU bdu;
 
     g_assert (size >= 4);
+
+    /* avoid stale cached parsing state */
+    if (frame->flags & GST_BASE_PARSE_FRAME_FLAG_NEW_FRAME)
+      vc1parse->bdu_end_scan_offset = 0;
+
     memset (&bdu, 0, sizeof (bdu));
     GST_DEBUG_OBJECT (vc1parse,
         "Handling buffer of size %" G_GSIZE_FORMAT " at offset %"
         G_GUINT64_FORMAT, size, GST_BUFFER_OFFSET (buffer));
-    /* XXX: when a buffer contains multiple BDUs, does the first one start with
-     * a startcode?
-     */
-    pres = gst_vc1_identify_next_bdu (data, size, &bdu);
-    switch (pres) {
-      case GST_VC1_PARSER_OK:
+
+    if (vc1parse->bdu_end_scan_offset > 0) {
+      guint scan_offset = vc1parse->bdu_end_scan_offset;
+
+      /* The start of this BDU was found already, only look for its end in
+       * the data that was not scanned yet */
+      pres = gst_vc1_identify_next_bdu (data + scan_offset, size - scan_offset,
+          &bdu);
+      if (pres == GST_VC1_PARSER_OK || pres == GST_VC1_PARSER_NO_BDU_END) {
         GST_DEBUG_OBJECT (vc1parse, "Have complete BDU");
-        if (bdu.sc_offset > 4) {
-          *skipsize = bdu.sc_offset;
-        } else {
-          framesize = bdu.offset + bdu.size;
-        }
-        break;
-      case GST_VC1_PARSER_BROKEN_DATA:
-        GST_ERROR_OBJECT (vc1parse, "Broken data");
-        *skipsize = 1;
-        break;
-      case GST_VC1_PARSER_NO_BDU:
-        GST_DEBUG_OBJECT (vc1parse, "Found no BDU startcode");
-        *skipsize = size - 3;
-        break;
-      case GST_VC1_PARSER_NO_BDU_END:
+        framesize = scan_offset + bdu.sc_offset;
+        if (framesize > vc1parse->bdu_offset && data[framesize - 1] == 0x00)
+          framesize--;
+      } else if (G_UNLIKELY (GST_BASE_PARSE_DRAINING (vc1parse))) {
+        GST_DEBUG_OBJECT (vc1parse, "Draining - assuming complete frame");
+        framesize = size;
+      } else {
         GST_DEBUG_OBJECT (vc1parse, "Found no BDU end");
-        if (G_UNLIKELY (GST_BASE_PARSE_DRAINING (vc1parse))) {
-          GST_DEBUG_OBJECT (vc1parse, "Draining - assuming complete frame");
-          framesize = size;
-        } else {
-          /* Need more data */
-          *skipsize = 0;
-        }
-        break;
-      case GST_VC1_PARSER_ERROR:
-        GST_ERROR_OBJECT (vc1parse, "Parsing error");
-        break;
-      default:
-        g_assert_not_reached ();
-        break;
+        vc1parse->bdu_end_scan_offset = MAX (size - 3, vc1parse->bdu_offset);
+      }
+    } else {
+      /* XXX: when a buffer contains multiple BDUs, does the first one start
+       * with a startcode?
+       */
+      pres = gst_vc1_identify_next_bdu (data, size, &bdu);
+      switch (pres) {
+        case GST_VC1_PARSER_OK:
+          GST_DEBUG_OBJECT (vc1parse, "Have complete BDU");
+          if (bdu.sc_offset > 4) {
+            *skipsize = bdu.sc_offset;
+          } else {
+            framesize = bdu.offset + bdu.size;
+          }
+          break;
+        case GST_VC1_PARSER_BROKEN_DATA:
+          GST_ERROR_OBJECT (vc1parse, "Broken data");
+          *skipsize = 1;
+          break;
+        case GST_VC1_PARSER_NO_BDU:
+          GST_DEBUG_OBJECT (vc1parse, "Found no BDU startcode");
+          *skipsize = size - 3;
+          break;
+        case GST_VC1_PARSER_NO_BDU_END:
+          GST_DEBUG_OBJECT (vc1parse, "Found no BDU end");
+          if (G_UNLIKELY (GST_BASE_PARSE_DRAINING (vc1parse))) {
+            GST_DEBUG_OBJECT (vc1parse, "Draining - assuming complete frame");
+            framesize = size;
+          } else if (bdu.sc_offset > 4) {
+            /* Drop the leading garbage first, so it doesn't end up in the
+             * BDU once its end is found */
+            *skipsize = bdu.sc_offset;
+          } else {
+            /* Need more data */
+            *skipsize = 0;
+            /* The BDU starts at the beginning of the data, resume looking for
+             * its end from here */
+            if (bdu.sc_offset == 0) {
+              vc1parse->bdu_offset = bdu.offset;
+              vc1parse->bdu_end_scan_offset = MAX (size - 3, bdu.offset);
+            }
+          }
+          break;
+        case GST_VC1_PARSER_ERROR:
+          GST_ERROR_OBJECT (vc1parse, "Parsing error");
+          break;
+        default:
+          g_assert_not_reached ();
+          break;
+      }
     }
   } else if (vc1parse->input_stream_format == VC1_STREAM_FORMAT_ASF ||
       (vc1parse->seq_layer_buffer
@@ -108,6 +108,11 @@ struct _GstVC1Parse
    * GST_BASE_PARSE_FRAME_FLAG_PARSING flag */
   GstVC1StartCode startcode;
 
+  /* Payload offset of the BDU whose end wasn't found yet, and the offset
+   * from which to resume looking for it once more data is available */
+  guint bdu_offset;
+  guint bdu_end_scan_offset;
+
   /* TRUE if we have already sent the sequence-layer,
    * use for stream-format conversion */
   gboolean seq_layer_sent;
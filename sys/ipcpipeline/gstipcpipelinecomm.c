@@ -38,6 +38,10 @@
 #include <gst/gstprotection.h>
 #include "gstipcpipelinecomm.h"
 
+#ifdef G_OS_UNIX
+#  include <sys/uio.h>
+#endif
+
 GST_DEBUG_CATEGORY_STATIC (gst_ipc_pipeline_comm_debug);
 #define GST_CAT_DEFAULT gst_ipc_pipeline_comm_debug
 
@@ -262,6 +266,65 @@ done:
   return ret;
 }
 
+typedef struct
+{
+  const guint8 *data;
+  gsize size;
+} CommVector;
+
+/* Writes all vectors, with a single writev() call where possible */
+static gboolean
+write_vectors_to_fd_raw (GstIpcPipelineComm * comm, CommVector * vectors,
+    guint n_vectors)
+{
+#ifdef G_OS_UNIX
+  struct iovec *iov = g_newa (struct iovec, n_vectors);
+  guint i, n = 0;
+
+  for (i = 0; i < n_vectors; i++) {
+    if (vectors[i].size == 0)
+      continue;
+    iov[n].iov_base = (void *) vectors[i].data;
+    iov[n].iov_len = vectors[i].size;
+    n++;
+  }
+
+  i = 0;
+  while (i < n) {
+    ssize_t written = writev (comm->fdout, iov + i, n - i);
+
+    if (written < 0) {
+      if (errno == EAGAIN || errno == EINTR)
+        continue;
+      GST_ERROR_OBJECT (comm->element, "Failed to write to fd: %s",
+          strerror (errno));
+      return FALSE;
+    }
+    GST_TRACE_OBJECT (comm->element, "Wrote %" G_GSSIZE_FORMAT
+        " bytes to fdout", written);
+
+    /* skip what was written and continue with a partially written vector */
+    while (i < n && (gsize) written >= iov[i].iov_len)
+      written -= iov[i++].iov_len;
+    if (i < n) {
+      iov[i].iov_base = (guint8 *) iov[i].iov_base + written;
+      iov[i].iov_len -= written;
+    }
+  }
+
+  return TRUE;
+#else
+  guint i;
+
+  for (i = 0; i < n_vectors; i++) {
+    if (!write_to_fd_raw (comm, vectors[i].data, vectors[i].size))
+      return FALSE;
+  }
+
+  return TRUE;
+#endif
+}
+
 static gboolean
 write_byte_writer_to_fd (GstIpcPipelineComm * comm, GstByteWriter * bw)
 {
@@ -524,13 +587,16 @@ gst_ipc_pipeline_comm_write_buffer_to_fd (GstIpcPipelineComm * comm,
     GstBuffer * buffer)
 {
   const unsigned char payload_type = GST_IPC_PIPELINE_COMM_DATA_TYPE_BUFFER;
-  GstMapInfo map;
+  GstMapInfo *maps = NULL;
+  CommVector *vectors;
+  guint n_mapped = 0, n_mem;
   guint32 ret32 = GST_FLOW_OK;
   guint32 size, n;
   CommBufferMetadata meta;
   GstFlowReturn ret;
   MetaListRepresentation repr = { comm, 0, 4, NULL };   /* starts a 4 for n_meta */
-  GstByteWriter bw;
+  GstByteWriter bw, meta_bw;
+  gboolean written;
 
   g_mutex_lock (&comm->mutex);
   ++comm->send_id;
@@ -539,6 +605,7 @@ gst_ipc_pipeline_comm_write_buffer_to_fd (GstIpcPipelineComm * comm,
       comm->send_id, buffer);
 
   gst_byte_writer_init (&bw);
+  gst_byte_writer_init (&meta_bw);
 
   meta.pts = GST_BUFFER_PTS (buffer);
   meta.dts = GST_BUFFER_DTS (buffer);
@@ -564,51 +631,64 @@ gst_ipc_pipeline_comm_write_buffer_to_fd (GstIpcPipelineComm * comm,
   size = gst_buffer_get_size (buffer);
   if (!gst_byte_writer_put_uint32_le (&bw, size))
     goto write_failed;
-  if (!write_byte_writer_to_fd (comm, &bw))
-    goto write_failed;
-
-  if (!gst_buffer_map (buffer, &map, GST_MAP_READ))
-    goto map_failed;
-  ret = write_to_fd_raw (comm, map.data, map.size);
-  gst_buffer_unmap (buffer, &map);
-  if (!ret)
-    goto write_failed;
 
   /* meta */
-  gst_byte_writer_init (&bw);
-  if (!gst_byte_writer_put_uint32_le (&bw, repr.n_meta))
+  if (!gst_byte_writer_put_uint32_le (&meta_bw, repr.n_meta))
     goto write_failed;
   for (n = 0; n < repr.n_meta; ++n) {
     const MetaBuildInfo *info = repr.info + n;
     guint32 len;
     const char *s;
 
-    if (!gst_byte_writer_put_uint32_le (&bw, info->bytes))
+    if (!gst_byte_writer_put_uint32_le (&meta_bw, info->bytes))
       goto write_failed;
 
-    if (!gst_byte_writer_put_uint32_le (&bw, info->flags))
+    if (!gst_byte_writer_put_uint32_le (&meta_bw, info->flags))
       goto write_failed;
 
     s = g_type_name (info->api);
     len = strlen (s) + 1;
-    if (!gst_byte_writer_put_uint32_le (&bw, len))
+    if (!gst_byte_writer_put_uint32_le (&meta_bw, len))
       goto write_failed;
-    if (!gst_byte_writer_put_data (&bw, (const guint8 *) s, len))
+    if (!gst_byte_writer_put_data (&meta_bw, (const guint8 *) s, len))
       goto write_failed;
 
-    if (!gst_byte_writer_put_uint64_le (&bw, info->size))
+    if (!gst_byte_writer_put_uint64_le (&meta_bw, info->size))
       goto write_failed;
 
     s = info->str;
     len = s ? (strlen (s) + 1) : 0;
-    if (!gst_byte_writer_put_uint32_le (&bw, len))
+    if (!gst_byte_writer_put_uint32_le (&meta_bw, len))
       goto write_failed;
     if (len)
-      if (!gst_byte_writer_put_data (&bw, (const guint8 *) s, len))
+      if (!gst_byte_writer_put_data (&meta_bw, (const guint8 *) s, len))
         goto write_failed;
   }
 
-  if (!write_byte_writer_to_fd (comm, &bw))
+  /* Header, the memories of the buffer and the metas are written in one go.
+   * Every memory is mapped on its own, which avoids merging multi-memory
+   * buffers into a temporary copy. */
+  n_mem = gst_buffer_n_memory (buffer);
+  maps = g_newa (GstMapInfo, n_mem);
+  vectors = g_newa (CommVector, n_mem + 2);
+  vectors[0].data = bw.parent.data;
+  vectors[0].size = gst_byte_writer_get_size (&bw);
+  for (n_mapped = 0; n_mapped < n_mem; n_mapped++) {
+    GstMemory *mem = gst_buffer_peek_memory (buffer, n_mapped);
+
+    if (!gst_memory_map (mem, &maps[n_mapped], GST_MAP_READ))
+      goto map_failed;
+    vectors[n_mapped + 1].data = maps[n_mapped].data;
+    vectors[n_mapped + 1].size = maps[n_mapped].size;
+  }
+  vectors[n_mem + 1].data = meta_bw.parent.data;
+  vectors[n_mem + 1].size = gst_byte_writer_get_size (&meta_bw);
+
+  written = write_vectors_to_fd_raw (comm, vectors, n_mem + 2);
+  for (n = 0; n < n_mapped; n++)
+    gst_memory_unmap (maps[n].memory, &maps[n]);
+  n_mapped = 0;
+  if (!written)
     goto write_failed;
 
   if (!gst_ipc_pipeline_comm_sync_fd (comm, comm->send_id, NULL, &ret32,
@@ -619,6 +699,7 @@ gst_ipc_pipeline_comm_write_buffer_to_fd (GstIpcPipelineComm * comm,
 done:
   g_mutex_unlock (&comm->mutex);
   gst_byte_writer_reset (&bw);
+  gst_byte_writer_reset (&meta_bw);
   for (n = 0; n < repr.n_meta; ++n)
     g_free (repr.info[n].str);
   g_free (repr.info);
@@ -637,6 +718,8 @@ wait_failed:
   goto done;
 
 map_failed:
+  for (n = 0; n < n_mapped; n++)
+    gst_memory_unmap (maps[n].memory, &maps[n]);
   GST_ELEMENT_ERROR (comm->element, RESOURCE, READ, (NULL),
       ("Failed to map buffer"));
   ret = GST_FLOW_ERROR;
@@ -670,7 +753,8 @@ gst_ipc_pipeline_comm_read_buffer (GstIpcPipelineComm * comm, guint32 size)
   if (buffer_data_size == 0) {
     buffer = gst_buffer_new ();
   } else {
-    buffer = gst_adapter_get_buffer (comm->adapter, buffer_data_size);
+    /* keep the data in the memories it was read into */
+    buffer = gst_adapter_get_buffer_fast (comm->adapter, buffer_data_size);
     gst_adapter_flush (comm->adapter, buffer_data_size);
   }
   size -= buffer_data_size;
@@ -1637,6 +1721,8 @@ gst_ipc_pipeline_comm_clear (GstIpcPipelineComm * comm)
 {
   g_hash_table_destroy (comm->waiting_ids);
   gst_object_unref (comm->adapter);
+  if (comm->payload_mem)
+    gst_memory_unref (comm->payload_mem);
   gst_poll_free (comm->poll);
   g_mutex_clear (&comm->mutex);
 }
@@ -1764,12 +1850,35 @@ again:
   /* read from fdin if possible and push data to our adapter */
   if (comm->pollFDin.fd >= 0
       && gst_poll_fd_can_read (comm->poll, &comm->pollFDin)) {
-    if (!mem)
-      mem = gst_allocator_alloc (NULL, comm->read_chunk_size, NULL);
+    gsize offset = 0, mem_size;
+    gboolean fill = FALSE;
+
+    if (comm->payload_mem) {
+      /* continue filling the payload memory of a previous short read */
+      mem = comm->payload_mem;
+      offset = comm->payload_mem_filled;
+      comm->payload_mem = NULL;
+      fill = TRUE;
+    } else {
+      gsize chunk_size = comm->read_chunk_size;
+
+      /* read the remainder of a large buffer payload into a single memory,
+       * which is only handed to the adapter once it is full */
+      if (comm->state == GST_IPC_PIPELINE_COMM_DATA_TYPE_BUFFER) {
+        gsize available = gst_adapter_available (comm->adapter);
+
+        if (comm->payload_length > available
+            && comm->payload_length - available > chunk_size) {
+          chunk_size = comm->payload_length - available;
+          fill = TRUE;
+        }
+      }
+      mem = gst_allocator_alloc (NULL, chunk_size, NULL);
+    }
 
     gst_memory_map (mem, &map, GST_MAP_WRITE);
 #ifdef _MSC_VER
-    sz = recv (comm->pollFDin.fd, map.data, map.size, 0);
+    sz = recv (comm->pollFDin.fd, map.data + offset, map.size - offset, 0);
     if (sz < 0) {
       int last_error = WSAGetLastError ();
       if (last_error == WSAEWOULDBLOCK) {
@@ -1779,22 +1888,39 @@ again:
       }
     }
 #else
-    sz = read (comm->pollFDin.fd, map.data, map.size);
+    sz = read (comm->pollFDin.fd, map.data + offset, map.size - offset);
 #endif
+    mem_size = map.size;
     gst_memory_unmap (mem, &map);
 
+    if (sz > 0) {
+      GST_TRACE_OBJECT (comm->element, "Read %u bytes from fd", (unsigned) sz);
+      offset += sz;
+    }
+
+    if (fill && offset > 0 && offset < mem_size) {
+      /* keep the partially filled memory for the next read */
+      comm->payload_mem = mem;
+      comm->payload_mem_filled = offset;
+      mem = NULL;
+    }
+
     if (sz <= 0) {
-      if (errno == EAGAIN)
+      if (errno == EAGAIN) {
+        if (mem) {
+          gst_memory_unref (mem);
+          mem = NULL;
+        }
         goto again;
+      }
       /* error out, unless interrupted */
       if (errno != EINTR)
         ret = 1;
-    } else {
-      gst_memory_resize (mem, 0, sz);
+    } else if (mem) {
+      gst_memory_resize (mem, 0, offset);
       buf = gst_buffer_new ();
       gst_buffer_append_memory (buf, mem);
       mem = NULL;
-      GST_TRACE_OBJECT (comm->element, "Read %u bytes from fd", (unsigned) sz);
       gst_adapter_push (comm->adapter, buf);
     }
   }
@@ -67,6 +67,9 @@ typedef struct
   GstPollFD pollFDin;
 
   GstAdapter *adapter;
+  /* remainder of a large buffer payload, filled by several reads */
+  GstMemory *payload_mem;
+  gsize payload_mem_filled;
   guint8 state;
   guint32 send_id;
 
@@ -39,8 +39,12 @@ struct _ShmAllocSpace
   /* The total size of this space */
   size_t size;
 
-  /* chained list of the blocks contained in this space */
+  /* chained list of the blocks contained in this space, sorted by offset */
   ShmAllocBlock *blocks;
+
+  /* The most recently allocated block, NULL if the next allocation should
+   * start at the beginning of the space */
+  ShmAllocBlock *last;
 };
 
 /* A single block of data */
@@ -56,7 +60,8 @@ struct _ShmAllocBlock
   /* The size of the block */
   unsigned long size;
 
-  /* Pointer to the next block in the chain */
+  /* Pointers to the previous and next blocks in the chain */
+  ShmAllocBlock *prev;
   ShmAllocBlock *next;
 };
 
@@ -80,51 +85,80 @@ shm_alloc_space_free (ShmAllocSpace * self)
   spalloc_free (ShmAllocSpace, self);
 }
 
-
-ShmAllocBlock *
-shm_alloc_space_alloc_block (ShmAllocSpace * self, unsigned long size)
+/* Size of the free space that follows @prev_item, or the start of the space
+ * if @prev_item is NULL */
+static unsigned long
+shm_alloc_space_gap_after (ShmAllocSpace * self, ShmAllocBlock * prev_item)
 {
-  ShmAllocBlock *block;
-  ShmAllocBlock *item = NULL;
-  ShmAllocBlock *prev_item = NULL;
-  unsigned long prev_end_offset = 0;
-
-
-  for (item = self->blocks; item; item = item->next) {
-    unsigned long max_size = 0;
+  unsigned long start = 0;
+  unsigned long end = self->size;
+  ShmAllocBlock *next = self->blocks;
 
-    max_size = item->offset - prev_end_offset;
+  if (prev_item) {
+    start = prev_item->offset + prev_item->size;
+    next = prev_item->next;
+  }
 
-    if (max_size >= size)
-      break;
+  if (next)
+    end = next->offset;
 
-    prev_end_offset = item->offset + item->size;
-    prev_item = item;
-  }
+  assert (start <= end);
+  return end - start;
+}
 
-  /* Return NULL if there is no big enough space, otherwise, there is space
-   * at the end */
-  assert (prev_end_offset <= self->size);
-  if (!item && self->size - prev_end_offset < size)
-    return NULL;
+static ShmAllocBlock *
+shm_alloc_space_insert_block (ShmAllocSpace * self, ShmAllocBlock * prev_item,
+    unsigned long size)
+{
+  ShmAllocBlock *block;
 
   block = spalloc_new (ShmAllocBlock);
   memset (block, 0, sizeof (ShmAllocBlock));
-  block->offset = prev_end_offset;
+  block->offset = prev_item ? prev_item->offset + prev_item->size : 0;
   block->size = size;
   block->use_count = 1;
   block->space = self;
 
-  if (prev_item)
+  block->prev = prev_item;
+  if (prev_item) {
+    block->next = prev_item->next;
     prev_item->next = block;
-  else
+  } else {
+    block->next = self->blocks;
     self->blocks = block;
+  }
+  if (block->next)
+    block->next->prev = block;
 
-  block->next = item;
+  self->last = block;
 
   return block;
 }
 
+/* Blocks are usually released in the order they were allocated, so the space
+ * is used as a ring: the block is placed right after the previous allocation
+ * or, when that does not fit, at the start of the space. This is O(1) in the
+ * common case, the first-fit walk is only a fallback for fragmented spaces. */
+ShmAllocBlock *
+shm_alloc_space_alloc_block (ShmAllocSpace * self, unsigned long size)
+{
+  ShmAllocBlock *item = NULL;
+
+  if (shm_alloc_space_gap_after (self, self->last) >= size)
+    return shm_alloc_space_insert_block (self, self->last, size);
+
+  if (self->last && shm_alloc_space_gap_after (self, NULL) >= size)
+    return shm_alloc_space_insert_block (self, NULL, size);
+
+  for (item = self->blocks; item; item = item->next) {
+    if (shm_alloc_space_gap_after (self, item) >= size)
+      return shm_alloc_space_insert_block (self, item, size);
+  }
+
+  /* There is no big enough space */
+  return NULL;
+}
+
 unsigned long
 shm_alloc_space_alloc_block_get_offset (ShmAllocBlock * block)
 {
@@ -134,20 +168,18 @@ shm_alloc_space_alloc_block_get_offset (ShmAllocBlock * block)
 static void
 shm_alloc_space_free_block (ShmAllocBlock * block)
 {
-  ShmAllocBlock *item = NULL;
-  ShmAllocBlock *prev_item = NULL;
   ShmAllocSpace *self = block->space;
 
-  for (item = self->blocks; item; item = item->next) {
-    if (item == block) {
-      if (prev_item)
-        prev_item->next = item->next;
-      else
-        self->blocks = item->next;
-      break;
-    }
-    prev_item = item;
-  }
+  if (block->prev)
+    block->prev->next = block->next;
+  else
+    self->blocks = block->next;
+
+  if (block->next)
+    block->next->prev = block->prev;
+
+  if (self->last == block)
+    self->last = block->prev;
 
   spalloc_free (ShmAllocBlock, block);
 }
@@ -157,6 +189,12 @@ shm_alloc_space_block_get (ShmAllocSpace * self, unsigned long offset)
 {
   ShmAllocBlock *block = NULL;
 
+  /* Recently allocated blocks are the most likely to be looked up */
+  block = self->last;
+  if (block && block->offset <= offset
+      && (block->offset + block->size) > offset)
+    return block;
+
   for (block = self->blocks; block; block = block->next) {
     if (block->offset <= offset && (block->offset + block->size) > offset)
       return block;
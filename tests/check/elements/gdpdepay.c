@@ -277,6 +277,71 @@ GST_START_TEST (test_audio_in_one_buffer)
 
 GST_END_TEST;
 
+/* payloads contained in one input buffer are passed on without copying */
+GST_START_TEST (test_payload_shared)
+{
+  GstCaps *caps;
+  GstElement *gdpdepay;
+  GstBuffer *buffer, *outbuffer;
+  GstBuffer *streamstart_buf, *caps_buf, *segment_buf, *data_buf;
+  GstMemory *mem;
+  GstEvent *event;
+  GstSegment segment;
+
+  gdpdepay = setup_gdpdepay ();
+
+  fail_unless (gst_element_set_state (gdpdepay,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  caps = gst_caps_new_empty_simple ("application/x-gdp");
+  gst_check_setup_events (mysrcpad, gdpdepay, caps, GST_FORMAT_BYTES);
+  gst_caps_unref (caps);
+
+  event = gst_event_new_stream_start ("s-s-id-1234");
+  streamstart_buf = gst_dp_payload_event (event, 0);
+  gst_event_unref (event);
+
+  caps = gst_caps_from_string (AUDIO_CAPS_STRING);
+  caps_buf = gst_dp_payload_caps (caps, 0);
+  gst_caps_unref (caps);
+
+  gst_segment_init (&segment, GST_FORMAT_TIME);
+  event = gst_event_new_segment (&segment);
+  segment_buf = gst_dp_payload_event (event, 0);
+  gst_event_unref (event);
+
+  fail_unless (gst_pad_push (mysrcpad, streamstart_buf) == GST_FLOW_OK);
+  fail_unless (gst_pad_push (mysrcpad, caps_buf) == GST_FLOW_OK);
+  fail_unless (gst_pad_push (mysrcpad, segment_buf) == GST_FLOW_OK);
+
+  buffer = gst_buffer_new_and_alloc (4);
+  gst_buffer_fill (buffer, 0, "f00d", 4);
+  GST_BUFFER_PTS (buffer) = GST_SECOND;
+  mem = gst_memory_ref (gst_buffer_peek_memory (buffer, 0));
+  data_buf = gst_dp_payload_buffer (buffer, 0);
+  gst_buffer_unref (buffer);
+
+  fail_unless (gst_pad_push (mysrcpad, data_buf) == GST_FLOW_OK);
+  fail_unless_equals_int (g_list_length (buffers), 1);
+
+  outbuffer = GST_BUFFER (buffers->data);
+  fail_unless_equals_int (gst_buffer_n_memory (outbuffer), 1);
+  fail_unless (gst_buffer_peek_memory (outbuffer, 0) == mem);
+  fail_unless_equals_uint64 (GST_BUFFER_PTS (outbuffer), GST_SECOND);
+  fail_unless (gst_buffer_memcmp (outbuffer, 0, "f00d", 4) == 0);
+  gst_memory_unref (mem);
+
+  fail_unless (gst_element_set_state (gdpdepay,
+          GST_STATE_NULL) == GST_STATE_CHANGE_SUCCESS, "could not set to null");
+
+  gst_check_drop_buffers ();
+  ASSERT_OBJECT_REFCOUNT (gdpdepay, "gdpdepay", 1);
+  cleanup_gdpdepay (gdpdepay);
+}
+
+GST_END_TEST;
+
 static GstStaticPadTemplate shsinktemplate = GST_STATIC_PAD_TEMPLATE ("sink",
     GST_PAD_SINK,
     GST_PAD_ALWAYS,
@@ -409,6 +474,7 @@ gdpdepay_suite (void)
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_audio_per_byte);
   tcase_add_test (tc_chain, test_audio_in_one_buffer);
+  tcase_add_test (tc_chain, test_payload_shared);
   tcase_add_test (tc_chain, test_streamheader);
 
   return s;
@@ -1107,6 +1107,52 @@ GST_START_TEST (test_parse_sliced_nal_au)
 
 GST_END_TEST;
 
+GST_START_TEST (test_parse_sliced_partial_slice_parsing)
+{
+  GstHarness *h;
+  GstBuffer *buf;
+
+  h = gst_harness_new_parse ("h264parse partial-slice-parsing=true");
+
+  gst_harness_set_caps_str (h,
+      "video/x-h264,stream-format=byte-stream,alignment=nal,parsed=false,framerate=30/1",
+      "video/x-h264,stream-format=byte-stream,alignment=au,parsed=true");
+
+  buf = composite_buffer (100, 0, 4,
+      h264_slicing_sps, sizeof (h264_slicing_sps),
+      h264_slicing_pps, sizeof (h264_slicing_pps),
+      h264_idr_slice_1, sizeof (h264_idr_slice_1),
+      h264_idr_slice_2, sizeof (h264_idr_slice_2));
+  fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+
+  /* AU boundaries are still found from the start of the slice headers */
+  buf = composite_buffer (200, 0, 2,
+      h264_slice_1, sizeof (h264_slice_1),
+      h264_slice_2, sizeof (h264_slice_2));
+  fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 1);
+
+  buf = gst_harness_pull (h);
+  fail_unless_equals_clocktime (GST_BUFFER_PTS (buf), 100);
+  fail_if (GST_BUFFER_FLAG_IS_SET (buf, GST_BUFFER_FLAG_DELTA_UNIT));
+  fail_unless_equals_int (gst_buffer_get_size (buf), sizeof (h264_aud) +
+      sizeof (h264_slicing_sps) + sizeof (h264_slicing_pps) +
+      sizeof (h264_idr_slice_1) + sizeof (h264_idr_slice_2));
+  gst_buffer_unref (buf);
+
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 1);
+
+  buf = gst_harness_pull (h);
+  fail_unless_equals_clocktime (GST_BUFFER_PTS (buf), 200);
+  fail_unless (GST_BUFFER_FLAG_IS_SET (buf, GST_BUFFER_FLAG_DELTA_UNIT));
+  gst_buffer_unref (buf);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_parse_sliced_sps_pps_sps)
 {
   GstHarness *h = gst_harness_new ("h264parse");
@@ -1187,6 +1233,7 @@ h264parse_sliced_suite (void)
   tcase_add_test (tc_chain, test_parse_sliced_nal_nal);
   tcase_add_test (tc_chain, test_parse_sliced_au_nal);
   tcase_add_test (tc_chain, test_parse_sliced_nal_au);
+  tcase_add_test (tc_chain, test_parse_sliced_partial_slice_parsing);
   tcase_add_test (tc_chain, test_parse_sliced_sps_pps_sps);
 
   return s;
@@ -1282,6 +1329,105 @@ GST_START_TEST (test_parse_skip_to_4bytes_sc)
 
 GST_END_TEST;
 
+static gboolean
+memory_is_shared_with (GstMemory * mem, GstBuffer * buffer)
+{
+  guint i;
+
+  for (i = 0; i < gst_buffer_n_memory (buffer); i++) {
+    GstMemory *other = gst_buffer_peek_memory (buffer, i);
+
+    if (mem == other || mem->parent == other)
+      return TRUE;
+  }
+
+  return FALSE;
+}
+
+/* returns the number of bytes in @out which do not come from @in */
+static gsize
+count_copied_bytes (GstBuffer * out, GstBuffer * in)
+{
+  gsize copied = 0;
+  guint i;
+
+  for (i = 0; i < gst_buffer_n_memory (out); i++) {
+    GstMemory *mem = gst_buffer_peek_memory (out, i);
+
+    if (!memory_is_shared_with (mem, in))
+      copied += mem->size;
+  }
+
+  return copied;
+}
+
+GST_START_TEST (test_parse_convert_no_copy)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+
+  h = gst_harness_new ("h264parse");
+
+  gst_harness_set_caps_str (h,
+      "video/x-h264, stream-format=byte-stream, alignment=au",
+      "video/x-h264, stream-format=avc, alignment=au");
+
+  in_buf = composite_buffer (0, 0, 3, h264_sps, sizeof (h264_sps),
+      h264_pps, sizeof (h264_pps), h264_idrframe, sizeof (h264_idrframe));
+
+  out_buf = gst_harness_push_and_pull (h, gst_buffer_ref (in_buf));
+  fail_unless (out_buf != NULL);
+  fail_unless_equals_int (gst_buffer_get_size (out_buf),
+      gst_buffer_get_size (in_buf));
+
+  /* only the three NAL length prefixes may be written, the NAL payloads
+   * must be shared with the input */
+  fail_unless_equals_int (count_copied_bytes (out_buf, in_buf), 3 * 4);
+
+  gst_buffer_unref (out_buf);
+  gst_buffer_unref (in_buf);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_parse_insert_config_no_copy)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  gsize idr_payload_size = sizeof (h264_idrframe) - 4;
+
+  h = gst_harness_new_parse ("h264parse config-interval=-1");
+
+  gst_harness_set_caps_str (h,
+      "video/x-h264, stream-format=byte-stream, alignment=au",
+      "video/x-h264, stream-format=byte-stream, alignment=au");
+
+  /* feed the parameter sets once so they get stored */
+  in_buf = composite_buffer (0, 0, 3, h264_sps, sizeof (h264_sps),
+      h264_pps, sizeof (h264_pps), h264_idrframe, sizeof (h264_idrframe));
+  out_buf = gst_harness_push_and_pull (h, in_buf);
+  fail_unless (out_buf != NULL);
+  gst_buffer_unref (out_buf);
+
+  /* a lone IDR gets SPS/PPS inserted in front of it */
+  in_buf = wrap_buffer (h264_idrframe, sizeof (h264_idrframe), 40, 0);
+  out_buf = gst_harness_push_and_pull (h, gst_buffer_ref (in_buf));
+  fail_unless (out_buf != NULL);
+  fail_unless (gst_buffer_get_size (out_buf) > sizeof (h264_idrframe));
+
+  /* only the inserted parameter sets and start codes are new, the IDR
+   * payload is shared with the input */
+  fail_unless (count_copied_bytes (out_buf, in_buf) <=
+      gst_buffer_get_size (out_buf) - idr_payload_size);
+
+  gst_buffer_unref (out_buf);
+  gst_buffer_unref (in_buf);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 typedef enum
 {
   PACKETIZED_AU = 0,
@@ -1627,6 +1773,8 @@ main (int argc, char **argv)
     tcase_add_test (tc_chain, test_parse_sei_closedcaptions);
     tcase_add_test (tc_chain, test_parse_compatible_caps);
     tcase_add_test (tc_chain, test_parse_skip_to_4bytes_sc);
+    tcase_add_test (tc_chain, test_parse_convert_no_copy);
+    tcase_add_test (tc_chain, test_parse_insert_config_no_copy);
     tcase_add_test (tc_chain, test_parse_aud_insert);
     tcase_add_test (tc_chain, test_parse_sei_userdefinedunregistered);
     nf += gst_check_run_suite (s, "h264parse", __FILE__);
@@ -924,6 +924,51 @@ GST_START_TEST (test_sliced_nal_au)
 
 GST_END_TEST;
 
+GST_START_TEST (test_sliced_partial_slice_parsing)
+{
+  GstHarness *h;
+  GstBuffer *buf;
+
+  h = gst_harness_new_parse ("h265parse partial-slice-parsing=true");
+
+  bytestream_set_caps (h, "nal", "au");
+  bytestream_push_first_au_inalign_nal (h, TRUE);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 0);
+
+  /* AU boundaries are still found from the start of the slice headers */
+  buf = wrap_buffer (h265_128x128_slice_1_idr_n_lp,
+      sizeof (h265_128x128_slice_1_idr_n_lp), 100, 0);
+  fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 1);
+  pull_and_check_composite (h, 10, 0, 5,
+      h265_128x128_sliced_vps, sizeof (h265_128x128_sliced_vps),
+      h265_128x128_sliced_sps, sizeof (h265_128x128_sliced_sps),
+      h265_128x128_sliced_pps, sizeof (h265_128x128_sliced_pps),
+      h265_128x128_slice_1_idr_n_lp, sizeof (h265_128x128_slice_1_idr_n_lp),
+      h265_128x128_slice_2_idr_n_lp, sizeof (h265_128x128_slice_2_idr_n_lp));
+
+  buf = wrap_buffer (h265_128x128_slice_2_idr_n_lp,
+      sizeof (h265_128x128_slice_2_idr_n_lp), 100, 0);
+  fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 0);
+
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 1);
+
+  buf = gst_harness_pull (h);
+  fail_unless_equals_clocktime (GST_BUFFER_PTS (buf), 100);
+  fail_if (GST_BUFFER_FLAG_IS_SET (buf, GST_BUFFER_FLAG_DELTA_UNIT));
+  fail_unless_equals_int (gst_buffer_get_size (buf),
+      sizeof (h265_128x128_slice_1_idr_n_lp) +
+      sizeof (h265_128x128_slice_2_idr_n_lp));
+  gst_buffer_unref (buf);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_sliced_au_au)
 {
   GstHarness *h = gst_harness_new ("h265parse");
@@ -1031,6 +1076,139 @@ GST_END_TEST;
 
 
 
+static GstMemory *
+root_memory (GstMemory * mem)
+{
+  return mem->parent ? mem->parent : mem;
+}
+
+static gboolean
+memory_is_shared_with (GstMemory * mem, GstBuffer * buffer)
+{
+  guint i;
+
+  for (i = 0; i < gst_buffer_n_memory (buffer); i++) {
+    GstMemory *other = gst_buffer_peek_memory (buffer, i);
+
+    if (root_memory (mem) == root_memory (other))
+      return TRUE;
+  }
+
+  return FALSE;
+}
+
+/* returns the number of bytes in @out which do not come from @in */
+static gsize
+count_copied_bytes (GstBuffer * out, GstBuffer * in)
+{
+  gsize copied = 0;
+  guint i;
+
+  for (i = 0; i < gst_buffer_n_memory (out); i++) {
+    GstMemory *mem = gst_buffer_peek_memory (out, i);
+
+    if (!memory_is_shared_with (mem, in))
+      copied += mem->size;
+  }
+
+  return copied;
+}
+
+GST_START_TEST (test_parse_convert_no_copy)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *hvc1_buf, *out_buf;
+  GstCaps *caps;
+  gsize idr_payload_size = sizeof (h265_idr) - 4;
+
+  /* byte-stream to hvc1 */
+  h = gst_harness_new ("h265parse");
+
+  gst_harness_set_caps_str (h,
+      "video/x-h265, stream-format=byte-stream, alignment=au",
+      "video/x-h265, stream-format=hvc1, alignment=au");
+
+  in_buf = composite_buffer (0, 0, 4, h265_vps, sizeof (h265_vps),
+      h265_sps, sizeof (h265_sps), h265_pps, sizeof (h265_pps),
+      h265_idr, sizeof (h265_idr));
+
+  hvc1_buf = gst_harness_push_and_pull (h, gst_buffer_ref (in_buf));
+  fail_unless (hvc1_buf != NULL);
+  fail_unless_equals_int (gst_buffer_get_size (hvc1_buf),
+      gst_buffer_get_size (in_buf));
+
+  /* only the four NAL length prefixes may be written, the NAL payloads
+   * must be shared with the input */
+  fail_unless_equals_int (count_copied_bytes (hvc1_buf, in_buf), 4 * 4);
+
+  caps = gst_pad_get_current_caps (h->sinkpad);
+  fail_unless (caps != NULL);
+  fail_unless (gst_structure_has_field (gst_caps_get_structure (caps, 0),
+          "codec_data"));
+  gst_buffer_unref (in_buf);
+  gst_harness_teardown (h);
+
+  /* and back to byte-stream */
+  h = gst_harness_new ("h265parse");
+
+  gst_harness_set_src_caps (h, caps);
+  gst_harness_set_sink_caps_str (h,
+      "video/x-h265, stream-format=byte-stream, alignment=au");
+
+  out_buf = gst_harness_push_and_pull (h, gst_buffer_ref (hvc1_buf));
+  fail_unless (out_buf != NULL);
+  fail_unless (gst_buffer_get_size (out_buf) >= sizeof (h265_idr));
+
+  /* start codes and parameter sets from the codec_data may be new, the IDR
+   * payload is shared with the input */
+  fail_unless (count_copied_bytes (out_buf, hvc1_buf) <=
+      gst_buffer_get_size (out_buf) - idr_payload_size);
+
+  gst_buffer_unref (out_buf);
+  gst_buffer_unref (hvc1_buf);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_parse_insert_config_no_copy)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  gsize idr_payload_size = sizeof (h265_idr) - 4;
+
+  h = gst_harness_new_parse ("h265parse config-interval=-1");
+
+  gst_harness_set_caps_str (h,
+      "video/x-h265, stream-format=byte-stream, alignment=au",
+      "video/x-h265, stream-format=byte-stream, alignment=au");
+
+  /* feed the parameter sets once so they get stored */
+  in_buf = composite_buffer (0, 0, 4, h265_vps, sizeof (h265_vps),
+      h265_sps, sizeof (h265_sps), h265_pps, sizeof (h265_pps),
+      h265_idr, sizeof (h265_idr));
+  out_buf = gst_harness_push_and_pull (h, in_buf);
+  fail_unless (out_buf != NULL);
+  gst_buffer_unref (out_buf);
+
+  /* a lone IDR gets VPS/SPS/PPS inserted in front of it */
+  in_buf = wrap_buffer (h265_idr, sizeof (h265_idr), 40, 0);
+  out_buf = gst_harness_push_and_pull (h, gst_buffer_ref (in_buf));
+  fail_unless (out_buf != NULL);
+  fail_unless (gst_buffer_get_size (out_buf) > sizeof (h265_idr));
+
+  /* only the inserted parameter sets and start codes are new, the IDR
+   * payload is shared with the input */
+  fail_unless (count_copied_bytes (out_buf, in_buf) <=
+      gst_buffer_get_size (out_buf) - idr_payload_size);
+
+  gst_buffer_unref (out_buf);
+  gst_buffer_unref (in_buf);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 /* nal->au has latency, but EOS should force the last AU out */
 GST_START_TEST (test_drain)
 {
@@ -1080,10 +1258,13 @@ h265parse_harnessed_suite (void)
   tcase_add_test (tc_chain, test_sliced_nal_nal);
   tcase_add_test (tc_chain, test_sliced_au_nal);
   tcase_add_test (tc_chain, test_sliced_nal_au);
+  tcase_add_test (tc_chain, test_sliced_partial_slice_parsing);
   tcase_add_test (tc_chain, test_sliced_au_au);
 
   tcase_add_test (tc_chain, test_parse_skip_to_4bytes_sc);
   tcase_add_test (tc_chain, test_parse_sc_with_half_header);
+  tcase_add_test (tc_chain, test_parse_convert_no_copy);
+  tcase_add_test (tc_chain, test_parse_insert_config_no_copy);
 
   tcase_add_test (tc_chain, test_drain);
 
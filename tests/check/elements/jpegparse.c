@@ -39,6 +39,14 @@ static guint8 test_data_entropy[] = { 0xff, 0xd8, 0xff, 0xda, 0x00, 0x04, 0x22,
 };
 static guint8 test_data_ff[] = { 0xff, 0xff };
 
+/* two scans with restart markers, stuffed and fill bytes in the entropy-coded
+ * data, and a table segment in between */
+static guint8 test_data_restart[] = { 0xff, 0xd8, 0xff, 0xda, 0x00, 0x04, 0x22,
+  0x33, 0x44, 0xff, 0x00, 0x55, 0xff, 0xd0, 0x66, 0xff, 0x00, 0xff, 0xd1, 0x77,
+  0xff, 0xff, 0xd2, 0x88, 0xff, 0xc4, 0x00, 0x03, 0x99, 0xff, 0xda, 0x00, 0x04,
+  0x22, 0x33, 0xaa, 0xff, 0xd3, 0xbb, 0xff, 0xd9
+};
+
 static guint8 test_data_extra_ff[] = { 0xff, 0xd8, 0xff, 0xff, 0xff, 0x12, 0x00,
   0x03, 0x33, 0xff, 0xff, 0xff, 0xd9
 };
@@ -277,6 +285,47 @@ GST_START_TEST (test_parse_all_in_one_buf)
 
 GST_END_TEST;
 
+GST_START_TEST (test_parse_restart_markers)
+{
+  GList *buffer_in = NULL, *buffer_out = NULL;
+  GstBuffer *buffer;
+  GstCaps *caps_in, *caps_out;
+
+  caps_in = gst_caps_new_simple ("image/jpeg", "parsed", G_TYPE_BOOLEAN, FALSE,
+      NULL);
+  caps_out = gst_caps_new_simple ("image/jpeg", "parsed", G_TYPE_BOOLEAN, TRUE,
+      "framerate", GST_TYPE_FRACTION, 0, 1, NULL);
+
+  /* byte by byte, so the entropy-coded data scan resumes on every buffer */
+  buffer_in = make_buffers_in (buffer_in, test_data_restart);
+  buffer_in = make_buffers_in (buffer_in, test_data_short_frame);
+
+  buffer_out = make_buffers_out (buffer_out, test_data_restart);
+  buffer_out = make_buffers_out (buffer_out, test_data_short_frame);
+  gst_check_element_push_buffer_list ("jpegparse", buffer_in, caps_in,
+      buffer_out, caps_out, GST_FLOW_OK);
+
+  /* and all in one buffer */
+  buffer_in = NULL;
+  buffer_out = NULL;
+  buffer = gst_buffer_new_and_alloc (sizeof (test_data_restart) +
+      sizeof (test_data_short_frame));
+  gst_buffer_fill (buffer, 0, test_data_restart, sizeof (test_data_restart));
+  gst_buffer_fill (buffer, sizeof (test_data_restart), test_data_short_frame,
+      sizeof (test_data_short_frame));
+  buffer_in = g_list_append (buffer_in, buffer);
+
+  buffer_out = make_buffers_out (buffer_out, test_data_restart);
+  buffer_out = make_buffers_out (buffer_out, test_data_short_frame);
+  gst_check_element_push_buffer_list ("jpegparse", buffer_in, caps_in,
+      buffer_out, caps_out, GST_FLOW_OK);
+
+  gst_caps_unref (caps_in);
+  gst_caps_unref (caps_out);
+}
+
+GST_END_TEST;
+
 static inline GstBuffer *
 make_my_input_buffer (guint8 * test_data_header, gsize test_data_size)
 {
@@ -378,6 +427,7 @@ jpegparse_suite (void)
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_parse_single_byte);
   tcase_add_test (tc_chain, test_parse_all_in_one_buf);
+  tcase_add_test (tc_chain, test_parse_restart_markers);
   tcase_add_test (tc_chain, test_parse_app1_exif);
   tcase_add_test (tc_chain, test_parse_comment);
 
@@ -0,0 +1,107 @@
+/* GStreamer
+ *
+ * unit test for latencymeter
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+
+GST_START_TEST (test_latency_meter_report)
+{
+  GstHarness *h;
+  GstBus *bus;
+  GstMessage *msg;
+  const GstStructure *s;
+  guint64 count, min, max, p50, p999;
+  gint i;
+
+  h = gst_harness_new_parse ("latencymeter mode=entry ! "
+      "latencymeter mode=exit interval=0");
+  bus = gst_bus_new ();
+  gst_element_set_bus (h->element, bus);
+
+  gst_harness_set_src_caps_str (h, "application/x-test");
+
+  for (i = 0; i < 10; i++) {
+    GstBuffer *buf = gst_harness_push_and_pull (h,
+        gst_buffer_new_allocate (NULL, 16, NULL));
+
+    fail_unless (buf != NULL);
+    fail_unless (gst_buffer_get_reference_timestamp_meta (buf, NULL) != NULL);
+    gst_buffer_unref (buf);
+  }
+
+  /* no statistics before EOS with an interval of 0 */
+  fail_unless (gst_bus_pop_filtered (bus, GST_MESSAGE_ELEMENT) == NULL);
+
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+
+  msg = gst_bus_pop_filtered (bus, GST_MESSAGE_ELEMENT);
+  fail_unless (msg != NULL);
+  s = gst_message_get_structure (msg);
+  fail_unless (gst_structure_has_name (s, "latencymeter"));
+  fail_unless_equals_string (gst_structure_get_string (s, "channel"),
+      "default");
+  fail_unless (gst_structure_get (s, "count", G_TYPE_UINT64, &count,
+          "min", G_TYPE_UINT64, &min, "max", G_TYPE_UINT64, &max,
+          "p50", G_TYPE_UINT64, &p50, "p999", G_TYPE_UINT64, &p999, NULL));
+  fail_unless_equals_uint64 (count, 10);
+  fail_unless (min <= p50);
+  fail_unless (p50 <= p999);
+  fail_unless (p999 <= max);
+  gst_message_unref (msg);
+
+  gst_element_set_bus (h->element, NULL);
+  gst_object_unref (bus);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_latency_meter_disabled)
+{
+  GstHarness *h;
+  GstBuffer *buf;
+
+  h = gst_harness_new_parse ("latencymeter mode=entry enabled=false");
+  gst_harness_set_src_caps_str (h, "application/x-test");
+
+  buf = gst_harness_push_and_pull (h, gst_buffer_new_allocate (NULL, 16,
+          NULL));
+  fail_unless (gst_buffer_get_reference_timestamp_meta (buf, NULL) == NULL);
+  gst_buffer_unref (buf);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+static Suite *
+latencymeter_suite (void)
+{
+  Suite *s = suite_create ("latencymeter");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_latency_meter_report);
+  tcase_add_test (tc_chain, test_latency_meter_disabled);
+
+  return s;
+}
+
+GST_CHECK_MAIN (latencymeter);
@@ -1,6 +1,8 @@
 #include <gst/check/gstharness.h>
 #include <gst/check/gstcheck.h>
 
+#include <glib/gstdio.h>
+
 GST_START_TEST (netsim_stress)
 {
   GstHarness *h = gst_harness_new ("netsim");
@@ -51,6 +53,64 @@ GST_START_TEST (netsim_stress_delayed)
 
 GST_END_TEST;
 
+GST_START_TEST (netsim_burst_loss)
+{
+  GstHarness *h = gst_harness_new_parse
+      ("netsim burst-enter-probability=1.0 burst-exit-probability=1.0");
+  guint i;
+
+  gst_harness_set_src_caps_str (h, "mycaps");
+
+  /* every packet toggles the state, so every other packet is lost */
+  for (i = 0; i < 10; i++)
+    fail_unless_equals_int (gst_harness_push (h,
+            gst_harness_create_buffer (h, 100)), GST_FLOW_OK);
+
+  fail_unless_equals_int (gst_harness_buffers_received (h), 5);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (netsim_trace)
+{
+  GstHarness *h;
+  GError *err = NULL;
+  gchar *filename, *launch;
+  gint64 start_time;
+  gint fd;
+  guint i;
+
+  /* one delivery opportunity per millisecond */
+  fd = g_file_open_tmp ("netsim-trace-XXXXXX", &filename, &err);
+  fail_unless (fd != -1);
+  g_close (fd, NULL);
+  fail_unless (g_file_set_contents (filename, "1\n", -1, &err));
+
+  launch = g_strdup_printf ("netsim trace-file=\"%s\"", filename);
+  h = gst_harness_new_parse (launch);
+  g_free (launch);
+  gst_harness_set_src_caps_str (h, "mycaps");
+
+  start_time = g_get_monotonic_time ();
+  for (i = 0; i < 3; i++)
+    fail_unless_equals_int (gst_harness_push (h,
+            gst_harness_create_buffer (h, 1500)), GST_FLOW_OK);
+
+  for (i = 0; i < 3; i++)
+    gst_buffer_unref (gst_harness_pull (h));
+
+  /* the last packet can only leave at the third opportunity */
+  fail_unless (g_get_monotonic_time () - start_time >= 3000);
+
+  gst_harness_teardown (h);
+  g_unlink (filename);
+  g_free (filename);
+}
+
+GST_END_TEST;
+
 static Suite *
 netsim_suite (void)
 {
@@ -60,6 +120,8 @@ netsim_suite (void)
   suite_add_tcase (s, (tc_chain = tcase_create ("general")));
   tcase_add_test (tc_chain, netsim_stress);
   tcase_add_test (tc_chain, netsim_stress_delayed);
+  tcase_add_test (tc_chain, netsim_burst_loss);
+  tcase_add_test (tc_chain, netsim_trace);
 
   return s;
 }
@@ -0,0 +1,383 @@
+/* GStreamer
+ *
+ * unit test for the nulldec plugin
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/check/check.h>
+
+static guint8 h264_sps[] = {
+  0x00, 0x00, 0x00, 0x01, 0x67, 0x4d, 0x40, 0x15,
+  0xec, 0xa4, 0xbf, 0x2e, 0x02, 0x20, 0x00, 0x00,
+  0x03, 0x00, 0x2e, 0xe6, 0xb2, 0x80, 0x01, 0xe2,
+  0xc5, 0xb2, 0xc0
+};
+
+/* same without VUI, so max_num_reorder_frames isn't signalled */
+static guint8 h264_sps_no_vui[] = {
+  0x00, 0x00, 0x00, 0x01, 0x67, 0x4d, 0x40, 0x15,
+  0xec, 0xa4, 0xbf, 0x2a
+};
+
+static guint8 h264_pps[] = {
+  0x00, 0x00, 0x00, 0x01, 0x68, 0xeb, 0xec, 0xb2
+};
+
+static guint8 h264_idrframe[] = {
+  0x00, 0x00, 0x00, 0x01, 0x65, 0x88, 0x84, 0x00,
+  0x10, 0xff, 0xfe, 0xf6, 0xf0, 0xfe, 0x05, 0x36,
+  0x56, 0x04, 0x50, 0x96, 0x7b, 0x3f, 0x53, 0xe1
+};
+
+/* non-IDR P picture with POC 4 and non-reference B picture with POC 2, for
+ * the pictures following h264_idrframe */
+static guint8 h264_pframe[] = {
+  0x00, 0x00, 0x00, 0x01, 0x41, 0x9a, 0x22, 0x6c,
+  0x6b, 0x12, 0x34, 0x56, 0x78
+};
+
+static guint8 h264_bframe[] = {
+  0x00, 0x00, 0x00, 0x01, 0x01, 0x9e, 0x41, 0x79,
+  0xaf, 0x12, 0x34, 0x56, 0x78
+};
+
+/* 128x128 VPS, SPS, PPS and IDR slice from the h265parse test */
+static guint8 h265_keyframe[] = {
+  0x00, 0x00, 0x00, 0x01, 0x40, 0x01, 0x0c, 0x01,
+  0xff, 0xff, 0x01, 0x60, 0x00, 0x00, 0x03, 0x00,
+  0x90, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00,
+  0x3f, 0x95, 0x98, 0x09,
+  0x00, 0x00, 0x00, 0x01, 0x42, 0x01, 0x01, 0x01,
+  0x60, 0x00, 0x00, 0x03, 0x00, 0x90, 0x00, 0x00,
+  0x03, 0x00, 0x00, 0x03, 0x00, 0x3f, 0xa0, 0x10,
+  0x20, 0x20, 0x59, 0x65, 0x66, 0x92, 0x4c, 0xaf,
+  0xff, 0x00, 0x01, 0x00, 0x01, 0x01, 0x00, 0x00,
+  0x03, 0x00, 0x01, 0x00, 0x00, 0x03, 0x00, 0x1e,
+  0x08,
+  0x00, 0x00, 0x00, 0x01, 0x44, 0x01, 0xc1, 0x72,
+  0xb4, 0x22, 0x40,
+  0x00, 0x00, 0x00, 0x01, 0x28, 0x01, 0xaf, 0x0e,
+  0xe0, 0x34, 0x82, 0x15, 0x84, 0xf4, 0x70, 0x4f,
+  0xff, 0xed, 0x41, 0x3f, 0xff, 0xe4, 0xcd, 0xc4,
+  0x7c, 0x03, 0x0c, 0xc2, 0xbb, 0xb0, 0x74, 0xe5,
+  0xef, 0x4f, 0xe1, 0xa3, 0xd4, 0x00, 0x02, 0xc2
+};
+
+/* 32x24 sequence header, sequence extension, GOP and I picture */
+static guint8 mpeg2_keyframe[] = {
+  0x00, 0x00, 0x01, 0xb3, 0x02, 0x00, 0x18, 0x15,
+  0xff, 0xff, 0xe0, 0x28, 0x00, 0x00, 0x01, 0xb5,
+  0x14, 0x8a, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+  0x01, 0xb8, 0x00, 0x08, 0x00, 0x00,
+  0x00, 0x00, 0x01, 0x00, 0x00, 0x0f, 0xff, 0xf8,
+  0x00, 0x00, 0x01, 0xb5, 0x8f, 0xff, 0xf3, 0x41,
+  0x80, 0x00, 0x00, 0x01, 0x01, 0x23, 0xf8, 0x7d,
+  0x29, 0x48, 0x8b, 0x94, 0xa5, 0x22, 0x20, 0x00,
+  0x00, 0x01, 0x02, 0x23, 0xf8, 0x7d, 0x29, 0x48,
+  0x8b, 0x94, 0xa5, 0x22, 0x20
+};
+
+/* uncompressed and compressed header of the first 256x144 frame of the
+ * vp9parse test stream, followed by the start of its tile data */
+static guint8 vp9_keyframe[] = {
+  0x82, 0x49, 0x83, 0x42, 0x00, 0x0f, 0xf0, 0x08,
+  0xf4, 0x18, 0x38, 0x24, 0x1c, 0x18, 0xee, 0x00,
+  0x02, 0x20, 0x7f, 0xd1, 0x5d, 0x32, 0xd6, 0x6f,
+  0x51, 0xe2, 0x8f, 0x24, 0xca, 0xed, 0xd1, 0x9b,
+  0x97, 0x35, 0x93, 0x88, 0xde, 0x8c, 0xc7, 0xa7,
+  0x75, 0x52, 0xb3, 0x63, 0xa2, 0xb8, 0xe9, 0x00,
+  0x17, 0xba, 0x18, 0x00, 0x7a, 0xa9, 0xff, 0xff,
+  0xd9, 0x9e, 0x97, 0xd4, 0x01, 0x93, 0x4c, 0xd3,
+  0xc5, 0x2f, 0xbd, 0xe0
+};
+/* temporal delimiter and sequence header of the av1parse test stream, then
+ * its first 400x300 single tile frame cut down to 64 bytes */
+static guint8 av1_keyframe[] = {
+  0x12, 0x00, 0x0a, 0x0b, 0x00, 0x00, 0x00, 0x04,
+  0x46, 0x3e, 0x56, 0xff, 0xfc, 0xc0, 0x20, 0x32,
+  0x40, 0x14, 0x00, 0xa6, 0x40, 0x10, 0xf3, 0x47,
+  0x52, 0x5f, 0xe1, 0xe0, 0x0e, 0x22, 0xf0, 0x95,
+  0xe2, 0x9c, 0x49, 0x32, 0xd9, 0x73, 0xfb, 0x89,
+  0x0e, 0x9f, 0xe2, 0xd2, 0x80, 0x2d, 0xaf, 0x80,
+  0x0d, 0xa6, 0xae, 0x2b, 0x72, 0x90, 0xcc, 0x79,
+  0x15, 0x18, 0x61, 0xda, 0x0a, 0xe3, 0xff, 0x5d,
+  0x14, 0x2b, 0x2f, 0x0e, 0x08, 0x0b, 0x08, 0x09,
+  0xb2, 0xa8, 0x72, 0x7a, 0x8d, 0x97, 0x14, 0x53,
+  0x7a
+};
+
+static GstBuffer *
+create_keyframe_with_sps_pps (const guint8 * sps, gsize sps_size)
+{
+  gsize size = sps_size + sizeof (h264_pps) + sizeof (h264_idrframe);
+  GstBuffer *buffer = gst_buffer_new_allocate (NULL, size, NULL);
+  gsize offset = 0;
+
+  gst_buffer_fill (buffer, offset, sps, sps_size);
+  offset += sps_size;
+  gst_buffer_fill (buffer, offset, h264_pps, sizeof (h264_pps));
+  offset += sizeof (h264_pps);
+  gst_buffer_fill (buffer, offset, h264_idrframe, sizeof (h264_idrframe));
+
+  return buffer;
+}
+
+GST_START_TEST (test_null_h264_dec_output)
+{
+  GstHarness *h = gst_harness_new ("nullh264dec");
+  GstCaps *caps;
+  GstStructure *s;
+  gint width, height;
+  guint i;
+
+  gst_harness_set_src_caps_str (h,
+      "video/x-h264, stream-format = (string) byte-stream, "
+      "alignment = (string) au, framerate = (fraction) 30/1");
+
+  for (i = 0; i < 3; i++) {
+    GstBuffer *buffer = create_keyframe_with_sps_pps (h264_sps,
+        sizeof (h264_sps));
+
+    GST_BUFFER_PTS (buffer) = GST_BUFFER_DTS (buffer) = i * 33 * GST_MSECOND;
+    fail_unless_equals_int (gst_harness_push (h, buffer), GST_FLOW_OK);
+  }
+
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 3);
+
+  caps = gst_pad_get_current_caps (h->sinkpad);
+  fail_unless (caps != NULL);
+  s = gst_caps_get_structure (caps, 0);
+  fail_unless (gst_structure_has_name (s, "video/x-null-decoded"));
+  fail_unless (gst_structure_get_int (s, "width", &width));
+  fail_unless (gst_structure_get_int (s, "height", &height));
+  fail_unless (width > 0 && height > 0);
+  gst_caps_unref (caps);
+
+  for (i = 0; i < 3; i++) {
+    GstBuffer *buffer = gst_harness_pull (h);
+    GstMapInfo map;
+
+    fail_unless (gst_buffer_map (buffer, &map, GST_MAP_READ));
+    fail_unless_equals_int (map.size, 8);
+    /* decode order, then picture order count of an IDR picture */
+    fail_unless_equals_int (GST_READ_UINT32_BE (map.data), i);
+    fail_unless_equals_int ((gint32) GST_READ_UINT32_BE (map.data + 4), 0);
+    gst_buffer_unmap (buffer, &map);
+
+    fail_unless_equals_uint64 (GST_BUFFER_PTS (buffer), i * 33 * GST_MSECOND);
+    gst_buffer_unref (buffer);
+  }
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+/* The SPS doesn't signal max_num_reorder_frames, so a live stream is first
+ * decoded with some delay until the decoder has seen that the stream doesn't
+ * reorder pictures, then every picture is output as soon as it is decoded */
+GST_START_TEST (test_null_h264_dec_live_inferred_reorder)
+{
+  GstHarness *h = gst_harness_new ("nullh264dec");
+  GstClockTime min_latency;
+  guint i;
+
+  gst_harness_set_src_caps_str (h,
+      "video/x-h264, stream-format = (string) byte-stream, "
+      "alignment = (string) au, framerate = (fraction) 30/1");
+
+  for (i = 0; i < 40; i++) {
+    GstBuffer *buffer = create_keyframe_with_sps_pps (h264_sps_no_vui,
+        sizeof (h264_sps_no_vui));
+
+    GST_BUFFER_PTS (buffer) = GST_BUFFER_DTS (buffer) = i * 33 * GST_MSECOND;
+    fail_unless_equals_int (gst_harness_push (h, buffer), GST_FLOW_OK);
+  }
+
+  /* the last picture was output without waiting for the next one */
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 40);
+
+  fail_unless (gst_pad_peer_query_latency (h->sinkpad, NULL, &min_latency,
+          NULL));
+  fail_unless_equals_clocktime (min_latency, 0);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+/* Same with B pictures, each of them is preceded by a P picture that
+ * follows it in output order. Once that is known the pictures are output
+ * with one frame of delay */
+GST_START_TEST (test_null_h264_dec_live_inferred_reorder_b_frames)
+{
+  GstHarness *h = gst_harness_new ("nullh264dec");
+  GstClockTime min_latency;
+  guint i;
+
+  gst_harness_set_src_caps_str (h,
+      "video/x-h264, stream-format = (string) byte-stream, "
+      "alignment = (string) au, framerate = (fraction) 30/1");
+
+  /* IDR (POC 0), P (POC 4), B (POC 2) */
+  for (i = 0; i < 42; i++) {
+    GstBuffer *buffer;
+    guint pts_idx = (i / 3) * 3;
+
+    switch (i % 3) {
+      case 0:
+        buffer = create_keyframe_with_sps_pps (h264_sps_no_vui,
+            sizeof (h264_sps_no_vui));
+        break;
+      case 1:
+        buffer = gst_buffer_new_memdup (h264_pframe, sizeof (h264_pframe));
+        pts_idx += 2;
+        break;
+      default:
+        buffer = gst_buffer_new_memdup (h264_bframe, sizeof (h264_bframe));
+        pts_idx += 1;
+        break;
+    }
+
+    GST_BUFFER_PTS (buffer) = pts_idx * 33 * GST_MSECOND;
+    GST_BUFFER_DTS (buffer) = i * 33 * GST_MSECOND;
+    fail_unless_equals_int (gst_harness_push (h, buffer), GST_FLOW_OK);
+  }
+
+  /* only the last P picture waits for the next one */
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 41);
+
+  fail_unless (gst_pad_peer_query_latency (h->sinkpad, NULL, &min_latency,
+          NULL));
+  fail_unless_equals_clocktime (min_latency,
+      gst_util_uint64_scale_int (GST_SECOND, 1, 30));
+
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 42);
+
+  for (i = 0; i < 42; i++) {
+    GstBuffer *buffer = gst_harness_pull (h);
+    GstMapInfo map;
+
+    fail_unless (gst_buffer_map (buffer, &map, GST_MAP_READ));
+    fail_unless_equals_int ((gint32) GST_READ_UINT32_BE (map.data + 4),
+        (i % 3) * 2);
+    gst_buffer_unmap (buffer, &map);
+
+    fail_unless_equals_uint64 (GST_BUFFER_PTS (buffer), i * 33 * GST_MSECOND);
+    gst_buffer_unref (buffer);
+  }
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+static void
+check_keyframe_decoded (const gchar * element, const gchar * caps_str,
+    guint8 * data, gsize size)
+{
+  GstHarness *h = gst_harness_new (element);
+  GstBuffer *buffer;
+  GstCaps *caps;
+  GstStructure *s;
+  gint width, height;
+
+  gst_harness_set_src_caps_str (h, caps_str);
+
+  buffer = gst_buffer_new_memdup (data, size);
+  GST_BUFFER_PTS (buffer) = GST_BUFFER_DTS (buffer) = 0;
+  fail_unless_equals_int (gst_harness_push (h, buffer), GST_FLOW_OK);
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 1);
+
+  caps = gst_pad_get_current_caps (h->sinkpad);
+  fail_unless (caps != NULL);
+  s = gst_caps_get_structure (caps, 0);
+  fail_unless (gst_structure_has_name (s, "video/x-null-decoded"));
+  fail_unless (gst_structure_get_int (s, "width", &width));
+  fail_unless (gst_structure_get_int (s, "height", &height));
+  fail_unless (width > 0 && height > 0);
+  gst_caps_unref (caps);
+
+  gst_harness_teardown (h);
+}
+
+GST_START_TEST (test_null_h265_dec_keyframe)
+{
+  check_keyframe_decoded ("nullh265dec",
+      "video/x-h265, stream-format = (string) byte-stream, "
+      "alignment = (string) au, framerate = (fraction) 30/1",
+      h265_keyframe, sizeof (h265_keyframe));
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_null_mpeg2_dec_keyframe)
+{
+  check_keyframe_decoded ("nullmpeg2dec",
+      "video/mpeg, mpegversion = (int) 2, systemstream = (boolean) false, "
+      "framerate = (fraction) 30/1",
+      mpeg2_keyframe, sizeof (mpeg2_keyframe));
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_null_vp9_dec_keyframe)
+{
+  check_keyframe_decoded ("nullvp9dec",
+      "video/x-vp9, alignment = (string) frame, framerate = (fraction) 30/1",
+      vp9_keyframe, sizeof (vp9_keyframe));
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_null_av1_dec_keyframe)
+{
+  check_keyframe_decoded ("nullav1dec",
+      "video/x-av1, stream-format = (string) obu-stream, "
+      "alignment = (string) frame, framerate = (fraction) 30/1",
+      av1_keyframe, sizeof (av1_keyframe));
+}
+
+GST_END_TEST;
+
+static Suite *
+nulldec_suite (void)
+{
+  Suite *s = suite_create ("nulldec");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_null_h264_dec_output);
+  tcase_add_test (tc_chain, test_null_h264_dec_live_inferred_reorder);
+  tcase_add_test (tc_chain,
+      test_null_h264_dec_live_inferred_reorder_b_frames);
+  tcase_add_test (tc_chain, test_null_h265_dec_keyframe);
+  tcase_add_test (tc_chain, test_null_mpeg2_dec_keyframe);
+  tcase_add_test (tc_chain, test_null_vp9_dec_keyframe);
+  tcase_add_test (tc_chain, test_null_av1_dec_keyframe);
+
+  return s;
+}
+
+GST_CHECK_MAIN (nulldec);
@@ -95,6 +95,67 @@ GST_START_TEST (test_flush_before_buffer)
 
 GST_END_TEST;
 
+static GstPadProbeReturn
+block_probe (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  return GST_PAD_PROBE_OK;
+}
+
+GST_START_TEST (test_leaky_queue)
+{
+  GstElement *sink, *src;
+  GstHarness *h_in;
+  GstHarness *h_out;
+  GstBuffer *buf;
+  GstPad *srcpad;
+  gulong probe_id;
+  guint level, received;
+  gint i;
+
+  sink = gst_element_factory_make ("proxysink", NULL);
+  src = gst_element_factory_make ("proxysrc", NULL);
+
+  g_object_set (src, "proxysink", sink, "max-size-buffers", 2,
+      "max-size-bytes", 0, "max-size-time", (guint64) 0, "leaky", 2, NULL);
+
+  h_in = gst_harness_new_with_element (sink, "sink", NULL);
+  h_out = gst_harness_new_with_element (src, NULL, "src");
+  gst_object_unref (sink);
+
+  /* Stall the consumer side, the producer must not block */
+  srcpad = gst_element_get_static_pad (src, "src");
+  probe_id = gst_pad_add_probe (srcpad, GST_PAD_PROBE_TYPE_BLOCK_DOWNSTREAM,
+      block_probe, NULL, NULL);
+
+  gst_harness_set_src_caps_str (h_in, "foo/bar");
+
+  for (i = 0; i < 10; i++) {
+    buf = gst_buffer_new_and_alloc (4);
+    GST_BUFFER_PTS (buf) = i * GST_MSECOND;
+    fail_unless_equals_int (gst_harness_push (h_in, buf), GST_FLOW_OK);
+  }
+
+  g_object_get (src, "current-level-buffers", &level, NULL);
+  fail_unless (level <= 2);
+
+  gst_pad_remove_probe (srcpad, probe_id);
+  gst_object_unref (srcpad);
+  gst_object_unref (src);
+
+  fail_unless (gst_harness_push_event (h_in, gst_event_new_eos ()));
+  fail_unless (gst_harness_pull_until_eos (h_out, &buf));
+  received = gst_buffer_get_size (buf) / 4;
+  gst_buffer_unref (buf);
+
+  /* the oldest buffers were dropped */
+  fail_unless (received < 10);
+
+  gst_harness_teardown (h_in);
+  gst_harness_teardown (h_out);
+}
+
+GST_END_TEST;
+
 static Suite *
 proxysink_suite (void)
 {
@@ -103,6 +164,7 @@ proxysink_suite (void)
 
   suite_add_tcase (s, tc_basic);
   tcase_add_test (tc_basic, test_flush_before_buffer);
+  tcase_add_test (tc_basic, test_leaky_queue);
 
   return s;
 }
@@ -30,6 +30,8 @@
 #include <gst/check/gstcheck.h>
 
 #include <gst/check/gstharness.h>
+#include <gst/rtp/gstrtpbuffer.h>
+#include <string.h>
 
 GST_START_TEST (test_create_and_unref)
 {
@@ -249,6 +251,109 @@ GST_START_TEST (test_roc)
 
 GST_END_TEST;
 
+#define LIST_TEST_SSRC 1356955624
+#define LIST_TEST_KEY "012345678901234567890123456789012345678901234567890123456789"
+#define LIST_TEST_PAYLOAD_LEN 160
+#define LIST_TEST_NUM_BUFFERS 64
+
+static GstBuffer *
+create_rtp_buffer (guint16 seqnum, gsize spare_room)
+{
+  guint size = gst_rtp_buffer_calc_packet_len (LIST_TEST_PAYLOAD_LEN, 0, 0);
+  GstBuffer *buf;
+  GstMapInfo map;
+
+  buf = gst_buffer_new_allocate (NULL, size + spare_room, NULL);
+  gst_buffer_set_size (buf, size);
+
+  fail_unless (gst_buffer_map (buf, &map, GST_MAP_WRITE));
+  memset (map.data, seqnum & 0xff, map.size);
+  GST_WRITE_UINT8 (map.data, 0x80);
+  GST_WRITE_UINT8 (map.data + 1, 8);
+  GST_WRITE_UINT16_BE (map.data + 2, seqnum);
+  GST_WRITE_UINT32_BE (map.data + 4, seqnum * LIST_TEST_PAYLOAD_LEN);
+  GST_WRITE_UINT32_BE (map.data + 8, LIST_TEST_SSRC);
+  gst_buffer_unmap (buf, &map);
+
+  return buf;
+}
+
+GST_START_TEST (test_buffer_list_in_place)
+{
+  GstHarness *enc, *dec;
+  GstBufferList *list;
+  GstMemory *mems[LIST_TEST_NUM_BUFFERS];
+  GstBuffer *buf, *expected;
+  gint64 start, elapsed;
+  guint i;
+
+  enc = gst_harness_new_with_padnames ("srtpenc", "rtp_sink_0", "rtp_src_0");
+  gst_util_set_object_arg (G_OBJECT (enc->element), "key", LIST_TEST_KEY);
+  gst_harness_set_src_caps_str (enc,
+      "application/x-rtp, payload=(int)8, ssrc=(uint)1356955624");
+
+  dec = gst_harness_new_with_padnames ("srtpdec", "rtp_sink", "rtp_src");
+  gst_harness_set_caps_str (dec,
+      "application/x-srtp, payload=(int)8, ssrc=(uint)1356955624, "
+      "srtp-key=(buffer)" LIST_TEST_KEY ", srtp-cipher=(string)aes-128-icm, "
+      "srtp-auth=(string)hmac-sha1-80, srtcp-cipher=(string)aes-128-icm, "
+      "srtcp-auth=(string)hmac-sha1-80", "application/x-rtp");
+
+  /* Buffers with spare room for the trailer are protected in place */
+  list = gst_buffer_list_new ();
+  for (i = 0; i < LIST_TEST_NUM_BUFFERS; i++) {
+    buf = create_rtp_buffer (i, 64);
+    mems[i] = gst_buffer_peek_memory (buf, 0);
+    gst_buffer_list_add (list, buf);
+  }
+
+  start = g_get_monotonic_time ();
+  fail_unless_equals_int (gst_pad_push_list (enc->srcpad, list), GST_FLOW_OK);
+  elapsed = g_get_monotonic_time () - start;
+  GST_INFO ("Protected %d packets in %" G_GINT64_FORMAT " us",
+      LIST_TEST_NUM_BUFFERS, elapsed);
+
+  list = gst_buffer_list_new ();
+  for (i = 0; i < LIST_TEST_NUM_BUFFERS; i++) {
+    buf = gst_harness_pull (enc);
+    fail_unless (buf);
+    fail_unless_equals_int (gst_buffer_n_memory (buf), 1);
+    fail_unless (gst_buffer_peek_memory (buf, 0) == mems[i]);
+    fail_unless_equals_int (gst_buffer_get_size (buf),
+        gst_rtp_buffer_calc_packet_len (LIST_TEST_PAYLOAD_LEN, 0, 0) + 10);
+    gst_buffer_list_add (list, buf);
+  }
+
+  /* And unprotected in place again */
+  start = g_get_monotonic_time ();
+  fail_unless_equals_int (gst_pad_push_list (dec->srcpad, list), GST_FLOW_OK);
+  elapsed = g_get_monotonic_time () - start;
+  GST_INFO ("Unprotected %d packets in %" G_GINT64_FORMAT " us",
+      LIST_TEST_NUM_BUFFERS, elapsed);
+
+  for (i = 0; i < LIST_TEST_NUM_BUFFERS; i++) {
+    GstMapInfo map;
+
+    buf = gst_harness_pull (dec);
+    fail_unless (buf);
+    fail_unless (gst_buffer_peek_memory (buf, 0) == mems[i]);
+
+    expected = create_rtp_buffer (i, 0);
+    fail_unless (gst_buffer_map (expected, &map, GST_MAP_READ));
+    fail_unless_equals_int (gst_buffer_get_size (buf), map.size);
+    fail_unless (gst_buffer_memcmp (buf, 0, map.data, map.size) == 0);
+    gst_buffer_unmap (expected, &map);
+
+    gst_buffer_unref (expected);
+    gst_buffer_unref (buf);
+  }
+
+  gst_harness_teardown (dec);
+  gst_harness_teardown (enc);
+}
+
+GST_END_TEST;
+
 #ifdef HAVE_SRTP2
 
 GST_START_TEST (test_simple_mki)
@@ -395,6 +500,7 @@ srtp_suite (void)
   tcase_add_test (tc_chain, test_play);
   tcase_add_test (tc_chain, test_roc);
   tcase_add_test (tc_chain, test_play_key_error);
+  tcase_add_test (tc_chain, test_buffer_list_in_place);
 #ifdef HAVE_SRTP2
   tcase_add_test (tc_chain, test_simple_mki);
   tcase_add_test (tc_chain, test_srtpdec_multiple_mki);
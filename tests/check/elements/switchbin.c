@@ -96,6 +96,86 @@ GST_START_TEST (test_switchbin_simple)
 
 GST_END_TEST;
 
+static void
+assert_no_flush_events (GstHarness * h)
+{
+  GstEvent *event;
+
+  while ((event = gst_harness_try_pull_event (h))) {
+    GST_DEBUG ("got event %" GST_PTR_FORMAT, event);
+    fail_if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_START);
+    fail_if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_STOP);
+    gst_event_unref (event);
+  }
+}
+
+GST_START_TEST (test_switchbin_standby)
+{
+  GstElement *switchbin, *e0, *e1, *e2;
+  GstCaps *c0, *c1, *c2;
+  GstHarness *h;
+  GstBuffer *in_buf;
+  GstBuffer *out_buf;
+  guint path_index;
+
+  switchbin = gst_element_factory_make ("switchbin", NULL);
+  fail_unless (switchbin != NULL);
+  g_object_set (switchbin, "num-paths", 3, "standby-state", GST_STATE_PAUSED,
+      "max-standby-paths", 1, NULL);
+  h = gst_harness_new_with_element (switchbin, "sink", "src");
+
+  e0 = gst_element_factory_make ("identity", NULL);
+  c0 = gst_caps_from_string ("audio/x-raw,format=S16LE,rate=48000,channels=2");
+  e1 = gst_element_factory_make ("identity", NULL);
+  c1 = gst_caps_from_string ("audio/x-raw,format=S16LE,rate=44100,channels=1");
+  e2 = gst_element_factory_make ("identity", NULL);
+  c2 = gst_caps_from_string ("audio/x-raw,format=S16LE,rate=32000,channels=1");
+
+  gst_child_proxy_set (GST_CHILD_PROXY (switchbin),
+      "path0::element", e0, "path0::caps", c0,
+      "path1::element", e1, "path1::caps", c1,
+      "path2::element", e2, "path2::caps", c2, NULL);
+  gst_caps_unref (c2);
+
+  /* Before any path was used, the first non-current path is kept warm */
+  gst_harness_set_src_caps (h, c0);
+  in_buf = gst_harness_create_buffer (h, 480);
+  gst_harness_push (h, in_buf);
+  out_buf = gst_harness_pull (h);
+  fail_unless (in_buf == out_buf);
+  gst_buffer_unref (out_buf);
+  g_object_get (switchbin, "current-path", &path_index, NULL);
+  fail_unless_equals_int (path_index, 0);
+  fail_unless_equals_int (GST_STATE (e0), GST_STATE_PLAYING);
+  fail_unless_equals_int (GST_STATE (e1), GST_STATE_PAUSED);
+  fail_unless_equals_int (GST_STATE (e2), GST_STATE_NULL);
+  assert_no_flush_events (h);
+
+  /* The previously current path is now the one in standby. It is flushed
+   * when it goes to standby, but that must not reach downstream */
+  gst_harness_set_src_caps (h, c1);
+  in_buf = gst_harness_create_buffer (h, 480);
+  gst_harness_push (h, in_buf);
+  out_buf = gst_harness_pull (h);
+  fail_unless (in_buf == out_buf);
+  gst_buffer_unref (out_buf);
+  g_object_get (switchbin, "current-path", &path_index, NULL);
+  fail_unless_equals_int (path_index, 1);
+  fail_unless_equals_int (GST_STATE (e0), GST_STATE_PAUSED);
+  fail_unless_equals_int (GST_STATE (e1), GST_STATE_PLAYING);
+  fail_unless_equals_int (GST_STATE (e2), GST_STATE_NULL);
+  assert_no_flush_events (h);
+
+  /* Standby elements follow the switchbin down */
+  gst_element_set_state (switchbin, GST_STATE_READY);
+  fail_unless_equals_int (GST_STATE (e0), GST_STATE_READY);
+
+  gst_harness_teardown (h);
+  gst_object_unref (switchbin);
+}
+
+GST_END_TEST;
+
 static Suite *
 switchbin_suite (void)
 {
@@ -104,6 +184,7 @@ switchbin_suite (void)
 
   suite_add_tcase (s, tc_basic);
   tcase_add_test (tc_basic, test_switchbin_simple);
+  tcase_add_test (tc_basic, test_switchbin_standby);
 
   return s;
 }
@@ -0,0 +1,119 @@
+/* GStreamer
+ *
+ * unit test for vc1parse
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+
+#define VC1_BDU_CAPS "video/x-wmv, wmvversion = (int) 3, " \
+    "format = (string) WVC1, stream-format = (string) bdu, " \
+    "header-format = (string) none"
+
+/* advanced profile sequence header and entrypoint from the vc1parser test */
+static const guint8 sequence_header[] = {
+  0x00, 0x00, 0x01, 0x0f, 0xca, 0x86, 0x13, 0xf0, 0xef, 0x88,
+  0x80
+};
+
+static const guint8 entrypoint[] = {
+  0x00, 0x00, 0x01, 0x0e, 0x48, 0x3f, 0x4f, 0xc3, 0xbc, 0x3f,
+  0x2b, 0x3f, 0x3c, 0x3f
+};
+
+static const guint8 frame[] = {
+  0x00, 0x00, 0x01, 0x0d, 0x3f, 0x0c, 0x14, 0x27, 0x3f, 0x68,
+  0x0c, 0x03, 0x3f, 0x3f, 0x55, 0x3f, 0x60, 0x71, 0x24, 0x38,
+  0x28, 0x1b, 0xda, 0xac, 0x01, 0x3f, 0x3f, 0x3f, 0x33, 0x3f
+};
+
+/* no start code in here */
+static const guint8 garbage[] = {
+  0xff, 0xfe, 0x3f, 0x12, 0x00, 0x34, 0x56, 0x78, 0x9a
+};
+
+static void
+push_data (GstHarness * h, const guint8 * data1, gsize size1,
+    const guint8 * data2, gsize size2)
+{
+  GstBuffer *buffer = gst_buffer_new_allocate (NULL, size1 + size2, NULL);
+
+  gst_buffer_fill (buffer, 0, data1, size1);
+  if (data2)
+    gst_buffer_fill (buffer, size1, data2, size2);
+
+  fail_unless_equals_int (gst_harness_push (h, buffer), GST_FLOW_OK);
+}
+
+static void
+check_bdu (GstHarness * h, const guint8 * data, gsize size)
+{
+  GstBuffer *buffer = gst_harness_pull (h);
+
+  fail_unless (buffer != NULL);
+  fail_unless_equals_int (gst_buffer_get_size (buffer), size);
+  fail_unless (gst_buffer_memcmp (buffer, 0, data, size) == 0);
+  gst_buffer_unref (buffer);
+}
+
+/* BDUs split across buffers must come out whole, and garbage in front of
+ * the first start code must not end up in the BDU that follows it */
+GST_START_TEST (test_vc1parse_split_bdu)
+{
+  GstHarness *h = gst_harness_new ("vc1parse");
+  gsize split = 6;
+
+  gst_harness_set_src_caps_str (h, VC1_BDU_CAPS);
+  gst_harness_set_sink_caps_str (h, VC1_BDU_CAPS);
+
+  push_data (h, garbage, sizeof (garbage), sequence_header, split);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 0);
+
+  push_data (h, sequence_header + split, sizeof (sequence_header) - split,
+      entrypoint, sizeof (entrypoint));
+  check_bdu (h, sequence_header, sizeof (sequence_header));
+
+  /* the end of the frame is only known at EOS, hand it over piece by piece */
+  push_data (h, frame, 10, NULL, 0);
+  check_bdu (h, entrypoint, sizeof (entrypoint));
+  push_data (h, frame + 10, 10, NULL, 0);
+  push_data (h, frame + 20, sizeof (frame) - 20, NULL, 0);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 0);
+
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+  check_bdu (h, frame, sizeof (frame));
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 0);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+static Suite *
+vc1parse_suite (void)
+{
+  Suite *s = suite_create ("vc1parse");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_vc1parse_split_bdu);
+
+  return s;
+}
+
+GST_CHECK_MAIN (vc1parse);
@@ -0,0 +1,193 @@
+/* GStreamer
+ *
+ * unit test for watchdog
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+
+static GstHarness *
+setup_watchdog (const gchar * launchline, GstBus ** bus)
+{
+  GstHarness *h;
+
+  h = gst_harness_new_parse (launchline);
+  *bus = gst_bus_new ();
+  gst_element_set_bus (h->element, *bus);
+  gst_harness_set_src_caps_str (h, "application/x-test");
+
+  return h;
+}
+
+static void
+teardown_watchdog (GstHarness * h, GstBus * bus)
+{
+  gst_element_set_bus (h->element, NULL);
+  gst_object_unref (bus);
+  gst_harness_teardown (h);
+}
+
+static void
+push_buffer (GstHarness * h)
+{
+  GstBuffer *buf;
+
+  buf = gst_harness_push_and_pull (h, gst_buffer_new_allocate (NULL, 16,
+          NULL));
+  fail_unless (buf != NULL);
+  gst_buffer_unref (buf);
+}
+
+/* Skips other element messages, as the stream may be reported as degraded
+ * and recovered on a loaded machine before the one we wait for */
+static GstMessage *
+wait_for_element_message (GstBus * bus, const gchar * name)
+{
+  GstMessage *msg;
+
+  while ((msg = gst_bus_timed_pop_filtered (bus, 5 * GST_SECOND,
+              GST_MESSAGE_ELEMENT))) {
+    if (gst_message_has_name (msg, name))
+      return msg;
+
+    GST_DEBUG ("skipping %" GST_PTR_FORMAT, msg);
+    gst_message_unref (msg);
+  }
+
+  return NULL;
+}
+
+static void
+check_intervals (GstMessage * msg)
+{
+  const GstStructure *s = gst_message_get_structure (msg);
+  guint64 expected_interval, elapsed;
+
+  fail_unless (gst_structure_get (s, "expected-interval", G_TYPE_UINT64,
+          &expected_interval, "elapsed", G_TYPE_UINT64, &elapsed, NULL));
+  fail_unless (GST_CLOCK_TIME_IS_VALID (expected_interval));
+  fail_unless (expected_interval > 0);
+  fail_unless (GST_CLOCK_TIME_IS_VALID (elapsed));
+}
+
+GST_START_TEST (test_watchdog_action_error)
+{
+  GstHarness *h;
+  GstBus *bus;
+  GstMessage *msg;
+
+  h = setup_watchdog ("watchdog timeout=100", &bus);
+
+  push_buffer (h);
+
+  msg = gst_bus_timed_pop_filtered (bus, 5 * GST_SECOND,
+      GST_MESSAGE_ERROR | GST_MESSAGE_ELEMENT);
+  fail_unless (msg != NULL);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_ERROR);
+  gst_message_unref (msg);
+
+  teardown_watchdog (h, bus);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_watchdog_action_message)
+{
+  GstHarness *h;
+  GstBus *bus;
+  GstMessage *msg;
+
+  h = setup_watchdog ("watchdog timeout=100 action=message", &bus);
+
+  push_buffer (h);
+  g_usleep (G_USEC_PER_SEC / 100);
+  push_buffer (h);
+
+  /* the timeout posts a message instead of an error */
+  msg = wait_for_element_message (bus, "watchdog-stalled");
+  fail_unless (msg != NULL);
+  check_intervals (msg);
+  gst_message_unref (msg);
+  fail_unless (gst_bus_pop_filtered (bus, GST_MESSAGE_ERROR) == NULL);
+
+  /* and the next buffer reports the stream as recovered */
+  push_buffer (h);
+  msg = wait_for_element_message (bus, "watchdog-recovered");
+  fail_unless (msg != NULL);
+  check_intervals (msg);
+  gst_message_unref (msg);
+
+  teardown_watchdog (h, bus);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_watchdog_degraded)
+{
+  GstHarness *h;
+  GstBus *bus;
+  GstMessage *msg;
+  const GstStructure *s;
+  guint64 expected_interval, elapsed;
+  gint i;
+
+  h = setup_watchdog ("watchdog timeout=10000 degradation-factor=4", &bus);
+
+  for (i = 0; i < 10; i++) {
+    push_buffer (h);
+    g_usleep (G_USEC_PER_SEC / 100);
+  }
+
+  msg = wait_for_element_message (bus, "watchdog-degraded");
+  fail_unless (msg != NULL);
+  check_intervals (msg);
+  s = gst_message_get_structure (msg);
+  fail_unless (gst_structure_get (s, "expected-interval", G_TYPE_UINT64,
+          &expected_interval, "elapsed", G_TYPE_UINT64, &elapsed, NULL));
+  fail_unless (elapsed >= expected_interval);
+  gst_message_unref (msg);
+
+  /* the hard timeout is far away */
+  fail_unless (gst_bus_pop_filtered (bus, GST_MESSAGE_ERROR) == NULL);
+
+  push_buffer (h);
+  msg = wait_for_element_message (bus, "watchdog-recovered");
+  fail_unless (msg != NULL);
+  check_intervals (msg);
+  gst_message_unref (msg);
+
+  teardown_watchdog (h, bus);
+}
+
+GST_END_TEST;
+
+static Suite *
+watchdog_suite (void)
+{
+  Suite *s = suite_create ("watchdog");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_watchdog_action_error);
+  tcase_add_test (tc_chain, test_watchdog_action_message);
+  tcase_add_test (tc_chain, test_watchdog_degraded);
+
+  return s;
+}
+
+GST_CHECK_MAIN (watchdog);
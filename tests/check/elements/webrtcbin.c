@@ -4567,6 +4567,107 @@ GST_START_TEST (test_codec_preferences_negotiation_srcpad)
 
 GST_END_TEST;
 
+static GstPadProbeReturn
+_store_buffer_probe (GstPad * pad, GstPadProbeInfo * info, GstBuffer ** buf)
+{
+  gst_buffer_replace (buf, GST_PAD_PROBE_INFO_BUFFER (info));
+
+  return GST_PAD_PROBE_OK;
+}
+
+GST_START_TEST (test_sink_pad_rewrite_rtp_header)
+{
+  struct test_webrtc *t = test_webrtc_new ();
+  const guint8 header[] = {
+    0x80, 0x80 | 100, 0x12, 0x34, 0x00, 0x01, 0x00, 0x00,
+    0xde, 0xad, 0xbe, 0xef
+  };
+  GstWebRTCRTPTransceiver *trans;
+  GstBuffer *buf, *rewritten = NULL;
+  GstMemory *header_mem, *payload_mem;
+  GstCaps *caps;
+  GstStructure *s;
+  GstHarness *h;
+  GstPad *pad;
+  guint8 data[12];
+  gint pt;
+  guint ssrc;
+
+  t->on_negotiation_needed = NULL;
+  t->on_ice_candidate = NULL;
+  t->on_pad_added = _pad_added_fakesink;
+
+  h = gst_harness_new_with_element (t->webrtc1, "sink_0", NULL);
+  t->harnesses = g_list_prepend (t->harnesses, h);
+
+  /* send opus with payload type 96 and the ssrc of OPUS_RTP_CAPS */
+  pad = gst_element_get_static_pad (t->webrtc1, "sink_0");
+  g_object_get (pad, "transceiver", &trans, NULL);
+  fail_unless (trans != NULL);
+  caps = gst_caps_from_string (OPUS_RTP_CAPS (96));
+  g_object_set (trans, "codec-preferences", caps, NULL);
+  gst_caps_unref (caps);
+  gst_object_unref (trans);
+
+  g_object_set (pad, "rewrite-rtp-header", TRUE, NULL);
+  gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER,
+      (GstPadProbeCallback) _store_buffer_probe, &rewritten, NULL);
+
+  /* forwarded from somewhere else, with another payload type and ssrc */
+  caps = gst_caps_from_string (OPUS_RTP_CAPS (100));
+  gst_caps_set_simple (caps, "ssrc", G_TYPE_UINT, 0xdeadbeef, NULL);
+  gst_harness_set_src_caps (h, caps);
+
+  caps = gst_pad_get_current_caps (pad);
+  fail_unless (caps != NULL);
+  s = gst_caps_get_structure (caps, 0);
+  fail_unless (gst_structure_get_int (s, "payload", &pt));
+  fail_unless_equals_int (pt, 96);
+  fail_unless (gst_structure_get_uint (s, "ssrc", &ssrc));
+  fail_unless_equals_uint64 (ssrc, 3384078950);
+  gst_caps_unref (caps);
+
+  test_validate_sdp (t, NULL, NULL);
+
+  fail_if (gst_element_set_state (t->webrtc1,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE);
+  fail_if (gst_element_set_state (t->webrtc2,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE);
+
+  header_mem = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+      (gpointer) header, sizeof (header), 0, sizeof (header), NULL, NULL);
+  payload_mem = gst_allocator_alloc (NULL, 100, NULL);
+  buf = gst_buffer_new ();
+  gst_buffer_append_memory (buf, gst_memory_ref (header_mem));
+  gst_buffer_append_memory (buf, gst_memory_ref (payload_mem));
+  gst_harness_push (h, buf);
+
+  fail_unless (rewritten != NULL);
+  fail_unless_equals_int (gst_buffer_get_size (rewritten),
+      sizeof (header) + 100);
+  fail_unless_equals_int (gst_buffer_extract (rewritten, 0, data,
+          sizeof (data)), sizeof (data));
+  /* payload type with the marker bit, sequence number and timestamp */
+  fail_unless_equals_int (data[1], 0x80 | 96);
+  fail_unless (memcmp (data, header, 1) == 0);
+  fail_unless (memcmp (data + 2, header + 2, 6) == 0);
+  fail_unless_equals_uint64 (GST_READ_UINT32_BE (data + 8), 3384078950);
+
+  /* only the fixed header was copied */
+  fail_unless_equals_int (gst_buffer_n_memory (rewritten), 2);
+  fail_unless (gst_buffer_peek_memory (rewritten, 1) == payload_mem);
+  fail_unless (gst_buffer_peek_memory (rewritten, 0) != header_mem);
+  fail_unless_equals_int (header[1], 0x80 | 100);
+
+  gst_buffer_unref (rewritten);
+  gst_memory_unref (header_mem);
+  gst_memory_unref (payload_mem);
+  gst_object_unref (pad);
+  test_webrtc_free (t);
+}
+
+GST_END_TEST;
+
 static void
 _on_new_transceiver_codec_preferences_h264 (GstElement * webrtcbin,
     GstWebRTCRTPTransceiver * trans, gpointer * user_data)
@@ -5760,6 +5861,7 @@ webrtcbin_suite (void)
     tcase_add_test (tc, test_codec_preferences_caps);
     tcase_add_test (tc, test_codec_preferences_negotiation_sinkpad);
     tcase_add_test (tc, test_codec_preferences_negotiation_srcpad);
+    tcase_add_test (tc, test_sink_pad_rewrite_rtp_header);
     tcase_add_test (tc, test_codec_preferences_in_on_new_transceiver);
     tcase_add_test (tc, test_codec_preferences_no_duplicate_extmaps);
     tcase_add_test (tc, test_codec_preferences_incompatible_extmaps);
@@ -567,6 +567,92 @@ GST_START_TEST (test_tile_list_obu)
 
 GST_END_TEST;
 
+GST_START_TEST (test_identify_obus)
+{
+  GstAV1Parser *parser;
+  GstAV1SequenceHeaderOBU seq_header;
+  GstAV1FrameOBU frame;
+  GstAV1OBUIndexEntry *entry;
+  GArray *index;
+  GstAV1ParserResult ret;
+  guint32 consumed = 0;
+  const guint8 *data_ptr = aom_testdata_av1_1_b8_01_size_16x16;
+  guint data_sz = sizeof (aom_testdata_av1_1_b8_01_size_16x16);
+
+  parser = gst_av1_parser_new ();
+  gst_av1_parser_reset (parser, FALSE);
+  index = g_array_new (FALSE, FALSE, sizeof (GstAV1OBUIndexEntry));
+
+  /* Identification stops after the sequence header */
+  ret = gst_av1_parser_identify_obus (parser, data_ptr, data_sz, index,
+      &consumed);
+  assert_equals_int (ret, GST_AV1_PARSER_OK);
+  assert_equals_int (consumed, 14);
+  assert_equals_int (index->len, 2);
+
+  entry = &g_array_index (index, GstAV1OBUIndexEntry, 0);
+  assert_equals_int (entry->obu.obu_type, GST_AV1_OBU_TEMPORAL_DELIMITER);
+  assert_equals_int (entry->offset, 0);
+  assert_equals_int (entry->size, 2);
+  assert_equals_int (entry->dropped, FALSE);
+
+  entry = &g_array_index (index, GstAV1OBUIndexEntry, 1);
+  assert_equals_int (entry->obu.obu_type, GST_AV1_OBU_SEQUENCE_HEADER);
+  assert_equals_int (entry->offset, 2);
+  assert_equals_int (entry->size, 12);
+  assert_equals_int (entry->obu.obu_size, 10);
+  fail_unless (entry->obu.data == data_ptr + 4);
+  ret = gst_av1_parser_parse_sequence_header_obu (parser, &entry->obu,
+      &seq_header);
+  assert_equals_int (ret, GST_AV1_PARSER_OK);
+
+  data_ptr += consumed;
+  data_sz -= consumed;
+
+  /* The remaining frames are identified in one go */
+  ret = gst_av1_parser_identify_obus (parser, data_ptr, data_sz, index,
+      &consumed);
+  assert_equals_int (ret, GST_AV1_PARSER_OK);
+  assert_equals_int (consumed, data_sz);
+  assert_equals_int (index->len, 3);
+
+  entry = &g_array_index (index, GstAV1OBUIndexEntry, 0);
+  assert_equals_int (entry->obu.obu_type, GST_AV1_OBU_FRAME);
+  assert_equals_int (entry->offset, 0);
+  assert_equals_int (entry->size, 169);
+  assert_equals_int (entry->obu.obu_size, 166);
+
+  ret = gst_av1_parser_parse_frame_obu (parser, &entry->obu, &frame);
+  assert_equals_int (ret, GST_AV1_PARSER_OK);
+  assert_equals_int (frame.tile_group.num_tiles, 1);
+  assert_equals_int (frame.tile_group.tg_start, 0);
+  assert_equals_int (frame.tile_group.tg_end, 0);
+
+  entry = &g_array_index (index, GstAV1OBUIndexEntry, 1);
+  assert_equals_int (entry->obu.obu_type, GST_AV1_OBU_TEMPORAL_DELIMITER);
+  assert_equals_int (entry->offset, 169);
+  assert_equals_int (entry->size, 2);
+
+  entry = &g_array_index (index, GstAV1OBUIndexEntry, 2);
+  assert_equals_int (entry->obu.obu_type, GST_AV1_OBU_FRAME);
+  assert_equals_int (entry->offset, 171);
+  assert_equals_int (entry->size, 77);
+  assert_equals_int (entry->obu.obu_size, 75);
+
+  /* Truncated data, the complete OBUs are still indexed */
+  gst_av1_parser_reset (parser, FALSE);
+  ret = gst_av1_parser_identify_obus (parser, data_ptr, 171 + 10, index,
+      &consumed);
+  assert_equals_int (ret, GST_AV1_PARSER_NO_MORE_DATA);
+  assert_equals_int (consumed, 171);
+  assert_equals_int (index->len, 2);
+
+  g_array_unref (index);
+  gst_av1_parser_free (parser);
+}
+
+GST_END_TEST;
+
 static Suite *
 av1parsers_suite (void)
 {
@@ -580,6 +666,7 @@ av1parsers_suite (void)
       test_av1_parse_aom_testdata_av1_1_b8_01_size_16x16_reencoded_annexb);
   tcase_add_test (tc_chain, test_metadata_obu);
   tcase_add_test (tc_chain, test_tile_list_obu);
+  tcase_add_test (tc_chain, test_identify_obus);
 
   return s;
 }
@@ -0,0 +1,165 @@
+/* GStreamer
+ *
+ * unit test for the GstCodecs DPB implementations
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/codecs/gsth264picture.h>
+#include <gst/codecs/gsth265picture.h>
+
+static const gint decode_order_poc[] = { 0, 8, 4, 2, 6, 16, 12, 10, 14 };
+
+GST_START_TEST (test_h264_dpb_bump_order)
+{
+  GstH264Dpb *dpb = gst_h264_dpb_new ();
+  GstH264Picture *picture;
+  gint expected_poc = 0;
+  guint i;
+
+  gst_h264_dpb_set_max_num_frames (dpb, 16);
+
+  for (i = 0; i < G_N_ELEMENTS (decode_order_poc); i++) {
+    picture = gst_h264_picture_new ();
+    picture->pic_order_cnt = decode_order_poc[i];
+    picture->system_frame_number = i;
+    gst_h264_picture_set_reference (picture, GST_H264_PICTURE_REF_SHORT_TERM,
+        FALSE);
+    gst_h264_dpb_add (dpb, picture);
+  }
+
+  fail_unless_equals_int (gst_h264_dpb_get_size (dpb),
+      G_N_ELEMENTS (decode_order_poc));
+
+  /* Reference pictures stay in the DPB after being output */
+  picture = gst_h264_dpb_bump (dpb, FALSE);
+  fail_unless (picture != NULL);
+  fail_unless_equals_int (picture->pic_order_cnt, 0);
+  gst_h264_picture_unref (picture);
+  fail_unless_equals_int (gst_h264_dpb_get_size (dpb),
+      G_N_ELEMENTS (decode_order_poc));
+
+  expected_poc = 2;
+  while ((picture = gst_h264_dpb_bump (dpb, TRUE))) {
+    fail_unless_equals_int (picture->pic_order_cnt, expected_poc);
+    expected_poc += 2;
+    gst_h264_picture_unref (picture);
+  }
+
+  fail_unless_equals_int (expected_poc, 18);
+
+  /* Only the already output POC 0 picture is left */
+  fail_unless_equals_int (gst_h264_dpb_get_size (dpb), 1);
+  gst_h264_dpb_free (dpb);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_h264_dpb_bump_field_pair)
+{
+  GstH264Dpb *dpb = gst_h264_dpb_new ();
+  GstH264Picture *first, *second, *frame, *picture;
+
+  gst_h264_dpb_set_max_num_frames (dpb, 4);
+  gst_h264_dpb_set_interlaced (dpb, TRUE);
+
+  first = gst_h264_picture_new ();
+  first->field = GST_H264_PICTURE_FIELD_TOP_FIELD;
+  first->pic_order_cnt = 4;
+  gst_h264_dpb_add (dpb, first);
+
+  frame = gst_h264_picture_new ();
+  frame->pic_order_cnt = 8;
+  gst_h264_dpb_add (dpb, frame);
+
+  /* The first field alone can't be output */
+  picture = gst_h264_dpb_bump (dpb, FALSE);
+  fail_unless (picture == frame);
+  gst_h264_picture_unref (picture);
+
+  second = gst_h264_picture_new ();
+  second->field = GST_H264_PICTURE_FIELD_BOTTOM_FIELD;
+  second->pic_order_cnt = 5;
+  second->second_field = TRUE;
+  second->other_field = first;
+  gst_h264_dpb_add (dpb, second);
+
+  picture = gst_h264_dpb_bump (dpb, FALSE);
+  fail_unless (picture == first);
+  fail_unless (picture->buffer_flags & GST_VIDEO_BUFFER_FLAG_INTERLACED);
+  fail_unless (picture->buffer_flags & GST_VIDEO_BUFFER_FLAG_TFF);
+  gst_h264_picture_unref (picture);
+
+  fail_unless (gst_h264_dpb_bump (dpb, FALSE) == NULL);
+  fail_unless_equals_int (gst_h264_dpb_get_size (dpb), 0);
+  gst_h264_dpb_free (dpb);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_h265_dpb_bump_order)
+{
+  GstH265Dpb *dpb = gst_h265_dpb_new ();
+  GstH265Picture *picture;
+  gint expected_poc = 0;
+  guint i;
+
+  gst_h265_dpb_set_max_num_pics (dpb, 16);
+
+  for (i = 0; i < G_N_ELEMENTS (decode_order_poc); i++) {
+    picture = gst_h265_picture_new ();
+    picture->pic_order_cnt = decode_order_poc[i];
+    picture->system_frame_number = i;
+    picture->output_flag = TRUE;
+    gst_h265_dpb_add (dpb, picture);
+  }
+
+  /* Every picture added after the first one increased its latency count */
+  fail_unless (gst_h265_dpb_needs_bump (dpb, 16, 1,
+          G_N_ELEMENTS (decode_order_poc) + 1));
+  fail_unless (!gst_h265_dpb_needs_bump (dpb, 16,
+          G_N_ELEMENTS (decode_order_poc) + 1,
+          G_N_ELEMENTS (decode_order_poc) + 1));
+
+  while ((picture = gst_h265_dpb_bump (dpb, TRUE))) {
+    fail_unless_equals_int (picture->pic_order_cnt, expected_poc);
+    expected_poc += 2;
+    gst_h265_picture_unref (picture);
+  }
+
+  fail_unless_equals_int (expected_poc, 18);
+  fail_unless_equals_int (gst_h265_dpb_get_size (dpb), 0);
+  gst_h265_dpb_free (dpb);
+}
+
+GST_END_TEST;
+
+static Suite *
+codecsdpb_suite (void)
+{
+  Suite *s = suite_create ("codecsdpb");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_h264_dpb_bump_order);
+  tcase_add_test (tc_chain, test_h264_dpb_bump_field_pair);
+  tcase_add_test (tc_chain, test_h265_dpb_bump_order);
+
+  return s;
+}
+
+GST_CHECK_MAIN (codecsdpb);
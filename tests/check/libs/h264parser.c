@@ -825,6 +825,58 @@ GST_START_TEST (test_h264_decoder_config_record)
 
 GST_END_TEST;
 
+GST_START_TEST (test_h264_parse_repeated_sps)
+{
+  GstH264NalParser *parser;
+  GstH264NalUnit nalu;
+  GstH264ParserResult res;
+  GstH264SPS sps, repeated;
+  guint8 *data;
+
+  parser = gst_h264_nal_parser_new ();
+
+  res = gst_h264_parser_identify_nalu (parser, nalu_sps_with_vui, 0,
+      sizeof (nalu_sps_with_vui), &nalu);
+  assert_equals_int (res, GST_H264_PARSER_NO_NAL_END);
+  assert_equals_int (nalu.type, GST_H264_NAL_SPS);
+
+  res = gst_h264_parser_parse_sps (parser, &nalu, &sps);
+  assert_equals_int (res, GST_H264_PARSER_OK);
+  fail_unless (gst_h264_parser_last_parameter_set_changed (parser));
+
+  /* identical SPS is not parsed again but gives the same result */
+  res = gst_h264_parser_parse_sps (parser, &nalu, &repeated);
+  assert_equals_int (res, GST_H264_PARSER_OK);
+  fail_if (gst_h264_parser_last_parameter_set_changed (parser));
+  assert_equals_int (repeated.id, sps.id);
+  assert_equals_int (repeated.width, sps.width);
+  assert_equals_int (repeated.height, sps.height);
+  assert_equals_int (repeated.level_idc, sps.level_idc);
+  assert_equals_int (repeated.vui_parameters_present_flag,
+      sps.vui_parameters_present_flag);
+  gst_h264_sps_clear (&repeated);
+
+  /* same id with a different level is a change */
+  data = g_memdup2 (nalu_sps_with_vui, sizeof (nalu_sps_with_vui));
+  data[7] = 0x29;
+  res = gst_h264_parser_identify_nalu (parser, data, 0,
+      sizeof (nalu_sps_with_vui), &nalu);
+  assert_equals_int (res, GST_H264_PARSER_NO_NAL_END);
+
+  res = gst_h264_parser_parse_sps (parser, &nalu, &repeated);
+  assert_equals_int (res, GST_H264_PARSER_OK);
+  fail_unless (gst_h264_parser_last_parameter_set_changed (parser));
+  assert_equals_int (repeated.id, sps.id);
+  assert_equals_int (repeated.level_idc, 41);
+  gst_h264_sps_clear (&repeated);
+
+  gst_h264_sps_clear (&sps);
+  g_free (data);
+  gst_h264_nal_parser_free (parser);
+}
+
+GST_END_TEST;
+
 static Suite *
 h264parser_suite (void)
 {
@@ -840,6 +892,7 @@ h264parser_suite (void)
   tcase_add_test (tc_chain, test_h264_parse_invalid_sei);
   tcase_add_test (tc_chain, test_h264_create_sei);
   tcase_add_test (tc_chain, test_h264_decoder_config_record);
+  tcase_add_test (tc_chain, test_h264_parse_repeated_sps);
 
   return s;
 }
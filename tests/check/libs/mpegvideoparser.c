@@ -89,6 +89,35 @@ GST_START_TEST (test_mpeg_parse)
 
 GST_END_TEST;
 
+GST_START_TEST (test_mpeg_parse_start_code_scan)
+{
+  /* 0x01 bytes that are not part of a start code, a start code preceded by
+   * an extra zero byte, and a start code right at the end of the data */
+  static const guint8 data[] = {
+    0x01, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0xb3, 0x00, 0x01, 0x00,
+    0x00, 0x01, 0xb5
+  };
+  GstMpegVideoPacket packet;
+
+  fail_unless (gst_mpeg_video_parse (&packet, data, sizeof (data), 0));
+  assert_equals_int (packet.type, GST_MPEG_VIDEO_PACKET_SEQUENCE);
+  assert_equals_int (packet.offset, 9);
+  assert_equals_int (packet.size, 2);
+
+  /* The last start code is incomplete without the byte following it */
+  fail_unless (gst_mpeg_video_parse (&packet, data, sizeof (data) - 1, 0));
+  assert_equals_int (packet.offset, 9);
+  assert_equals_int (packet.size, -1);
+
+  fail_unless (gst_mpeg_video_parse (&packet, data, sizeof (data), 11));
+  assert_equals_int (packet.type, GST_MPEG_VIDEO_PACKET_EXTENSION);
+  assert_equals_int (packet.offset, 15);
+
+  fail_if (gst_mpeg_video_parse (&packet, data, sizeof (data) - 1, 9));
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_mpeg_parse_sequence_header)
 {
   GstMpegVideoSequenceHdr seqhdr;
@@ -172,6 +201,7 @@ mpegvideoparsers_suite (void)
 
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_mpeg_parse);
+  tcase_add_test (tc_chain, test_mpeg_parse_start_code_scan);
   tcase_add_test (tc_chain, test_mpeg_parse_sequence_header);
   tcase_add_test (tc_chain, test_mpeg_parse_sequence_extension);
   tcase_add_test (tc_chain, test_mis_identified_datas);
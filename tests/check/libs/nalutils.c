@@ -102,6 +102,111 @@ GST_START_TEST (test_nal_writer_emulation_preventation)
 
 GST_END_TEST;
 
+/* Writes a large header-like corpus of Exp-Golomb codes, flags and fixed
+ * width fields with lots of zero bytes, so that the writer has to insert
+ * emulation prevention bytes, and reads it back */
+GST_START_TEST (test_nal_reader_corpus)
+{
+  NalWriter nw;
+  NalReader nr;
+  GRand *rand;
+  guint32 *values;
+  guint8 *kinds;
+  guint8 *data;
+  guint32 size;
+  guint rbsp_pos = 0;
+  guint n_values = 100000;
+  guint i, round;
+  GTimer *timer;
+
+  rand = g_rand_new_with_seed (42);
+  values = g_new (guint32, n_values);
+  kinds = g_new (guint8, n_values);
+
+  nal_writer_init (&nw, 4, FALSE);
+  fail_unless (nal_writer_put_bits_uint8 (&nw, 0x1f, 8));
+
+  for (i = 0; i < n_values; i++) {
+    kinds[i] = g_rand_int_range (rand, 0, 3);
+
+    switch (kinds[i]) {
+      case 0:
+        /* mostly small values, like in real headers */
+        values[i] = g_rand_int_range (rand, 0, 4) ?
+            g_rand_int_range (rand, 0, 8) : g_rand_int (rand) >> 1;
+        fail_unless (nal_writer_put_ue (&nw, values[i]));
+        break;
+      case 1:
+        values[i] = g_rand_boolean (rand) ? 0 : g_rand_int_range (rand, 0, 2);
+        fail_unless (nal_writer_put_bits_uint8 (&nw, values[i], 1));
+        break;
+      default:
+        values[i] = g_rand_boolean (rand) ? 0 : g_rand_int (rand) & 0xffff;
+        fail_unless (nal_writer_put_bits_uint16 (&nw, values[i], 16));
+        break;
+    }
+  }
+
+  data = nal_writer_reset_and_get_data (&nw, &size);
+  fail_unless (data != NULL);
+
+  /* skip the start code and the nal header */
+  nal_reader_init (&nr, data + 5, size - 5);
+
+  for (i = 0; i < n_values; i++) {
+    guint32 ue;
+    guint8 flag;
+    guint16 field;
+
+    switch (kinds[i]) {
+      case 0:
+        fail_unless (nal_reader_get_ue (&nr, &ue));
+        assert_equals_uint64 (ue, values[i]);
+        rbsp_pos += 2 * g_bit_storage (values[i] + 1) - 1;
+        break;
+      case 1:
+        fail_unless (nal_reader_get_bits_uint8 (&nr, &flag, 1));
+        assert_equals_uint64 (flag, values[i]);
+        rbsp_pos += 1;
+        break;
+      default:
+        fail_unless (nal_reader_get_bits_uint16 (&nr, &field, 16));
+        assert_equals_uint64 (field, values[i]);
+        rbsp_pos += 16;
+        break;
+    }
+
+    /* the position includes the emulation prevention bytes read so far */
+    assert_equals_int (nal_reader_get_pos (&nr) -
+        8 * nal_reader_get_epb_count (&nr), rbsp_pos);
+  }
+
+  fail_unless (nal_reader_get_epb_count (&nr) > 0);
+
+  timer = g_timer_new ();
+  for (round = 0; round < 20; round++) {
+    nal_reader_init (&nr, data + 5, size - 5);
+    for (i = 0; i < n_values; i++) {
+      guint32 val;
+
+      if (kinds[i] == 0)
+        nal_reader_get_ue (&nr, &val);
+      else
+        nal_reader_get_bits_uint32 (&nr, &val, kinds[i] == 1 ? 1 : 16);
+    }
+  }
+  GST_INFO ("read %u syntax elements in %f seconds", 20 * n_values,
+      g_timer_elapsed (timer, NULL));
+  g_timer_destroy (timer);
+
+  g_free (data);
+  g_free (kinds);
+  g_free (values);
+  g_rand_free (rand);
+}
+
+GST_END_TEST;
+
 static Suite *
 nalutils_suite (void)
 {
@@ -112,6 +217,7 @@ nalutils_suite (void)
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_nal_writer_init);
   tcase_add_test (tc_chain, test_nal_writer_emulation_preventation);
+  tcase_add_test (tc_chain, test_nal_reader_corpus);
 
   return s;
 }